@@ -452,7 +452,8 @@ PrintGuid (
 
 Routine Description:
 
-  This function prints a GUID to STDOUT.
+  This function prints a GUID to STDOUT, or to the output of the messages
+  set by SetMessageOutput().
 
 Arguments:
 
@@ -470,7 +471,8 @@ Returns:
     return EFI_INVALID_PARAMETER;
   }
 
-  printf (
+  fprintf (
+    GetMessageOutput (),
     "%08x-%04x-%04x-%02x%02x-%02x%02x%02x%02x%02x%02x\n",
     (unsigned) Guid->Data1,
     Guid->Data2,
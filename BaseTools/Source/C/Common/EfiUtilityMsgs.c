@@ -30,6 +30,18 @@ STATIC UINT32 mMaxWarnings            = 0;
 STATIC UINT32 mMaxWarningsPlusErrors  = 0;
 STATIC INT8   mPrintLimitsSet         = 0;
 
+//
+// Messages of the calling worker thread, see StartThreadMessages(), and
+// output of the messages of the calling thread, see SetMessageOutput()
+//
+#ifdef __GNUC__
+STATIC __thread THREAD_MESSAGES  *mThreadMessages = NULL;
+STATIC __thread FILE             *mMessageOutput  = NULL;
+#else
+STATIC __declspec(thread) THREAD_MESSAGES  *mThreadMessages = NULL;
+STATIC __declspec(thread) FILE             *mMessageOutput  = NULL;
+#endif
+
 STATIC
 VOID
 PrintLimitExceeded (
@@ -98,9 +110,10 @@ Notes:
 {
   va_list List;
   //
-  // If limits have been set, then check that we have not exceeded them
+  // If limits have been set, then check that we have not exceeded them. The
+  // messages of a worker thread are counted when they are reported.
   //
-  if (mPrintLimitsSet) {
+  if (mPrintLimitsSet && (mThreadMessages == NULL)) {
     //
     // See if we've exceeded our total count
     //
@@ -121,7 +134,11 @@ Notes:
     }
   }
 
-  mErrorCount++;
+  if (mThreadMessages != NULL) {
+    mThreadMessages->ErrorCount++;
+  } else {
+    mErrorCount++;
+  }
   va_start (List, MsgFmt);
   PrintMessage ("ERROR", FileName, LineNumber, MessageCode, Text, MsgFmt, List);
   va_end (List);
@@ -284,9 +301,10 @@ Returns:
     return;
   }
   //
-  // If limits have been set, then check them
+  // If limits have been set, then check them. The messages of a worker thread
+  // are counted when they are reported.
   //
-  if (mPrintLimitsSet) {
+  if (mPrintLimitsSet && (mThreadMessages == NULL)) {
     //
     // See if we've exceeded our total count
     //
@@ -307,7 +325,11 @@ Returns:
     }
   }
 
-  mWarningCount++;
+  if (mThreadMessages != NULL) {
+    mThreadMessages->WarningCount++;
+  } else {
+    mWarningCount++;
+  }
   va_start (List, MsgFmt);
   PrintMessage ("WARNING", FileName, LineNumber, MessageCode, Text, MsgFmt, List);
   va_end (List);
@@ -422,6 +444,8 @@ Notes:
   CHAR8       *Cptr;
   struct tm   *NewTime;
   time_t      CurrentTime;
+  FILE        *Output;
+  STATUS      *Status;
 
   //
   // init local variable
@@ -429,6 +453,16 @@ Notes:
   Line[0] = '\0';
   Line2[0] = '\0';
 
+  //
+  // The messages of a worker thread are kept for the main thread.
+  //
+  Output = GetMessageOutput ();
+  if (mThreadMessages != NULL) {
+    Status = &mThreadMessages->Status;
+  } else {
+    Status = &mStatus;
+  }
+
   //
   // If given a filename, then add it (and the line number) to the string.
   // If there's no filename, then use the program name if provided.
@@ -446,7 +480,7 @@ Notes:
     time (&CurrentTime);
     NewTime = localtime (&CurrentTime);
     if (NewTime != NULL) {
-      fprintf (stdout, "%04d-%02d-%02d %02d:%02d:%02d",
+      fprintf (Output, "%04d-%02d-%02d %02d:%02d:%02d",
                        NewTime->tm_year + 1900,
                        NewTime->tm_mon + 1,
                        NewTime->tm_mday,
@@ -469,7 +503,7 @@ Notes:
     //
     if (Cptr != NULL) {
       if (mUtilityName[0] != '\0') {
-        fprintf (stdout, "%s...\n", mUtilityName);
+        fprintf (Output, "%s...\n", mUtilityName);
       }
       strncpy (Line, Cptr, MAX_LINE_LEN - 1);
       Line[MAX_LINE_LEN - 1] = 0;
@@ -488,8 +522,8 @@ Notes:
       //
       // Set status accordingly for ERROR information.
       //
-      if (mStatus < STATUS_ERROR) {
-        mStatus = STATUS_ERROR;
+      if (*Status < STATUS_ERROR) {
+        *Status = STATUS_ERROR;
       }
     }
   }
@@ -504,21 +538,21 @@ Notes:
     sprintf (Line2, " %04u", (unsigned) MessageCode);
     strncat (Line, Line2, MAX_LINE_LEN - strlen (Line) - 1);
   }
-  fprintf (stdout, "%s", Line);
+  fprintf (Output, "%s", Line);
   //
   // If offending text was provided, then print it
   //
   if (Text != NULL) {
-    fprintf (stdout, ": %s", Text);
+    fprintf (Output, ": %s", Text);
   }
-  fprintf (stdout, "\n");
+  fprintf (Output, "\n");
 
   //
   // Print formatted message if provided
   //
   if (MsgFmt != NULL) {
     vsprintf (Line2, MsgFmt, List);
-    fprintf (stdout, "  %s\n", Line2);
+    fprintf (Output, "  %s\n", Line2);
   }
 
 }
@@ -531,7 +565,7 @@ PrintSimpleMessage (
   )
 /*++
 Routine Description:
-  Print message into stdout.
+  Print message into the output of the messages, see GetMessageOutput().
 
 Arguments:
   MsgFmt      - the format string for the message. Can contain formatting
@@ -548,7 +582,7 @@ Returns:
   //
   if (MsgFmt != NULL) {
     vsprintf (Line, MsgFmt, List);
-    fprintf (stdout, "%s\n", Line);
+    fprintf (GetMessageOutput (), "%s\n", Line);
   }
 }
 
@@ -636,6 +670,166 @@ Returns:
   return mStatus;
 }
 
+VOID
+ResetUtilityStatus (
+  VOID
+  )
+/*++
+
+Routine Description:
+  Clear the worst-case status, the error and warning counts and the print
+  level, as they are when a utility starts.
+
+Arguments:
+  None.
+
+Returns:
+  NA
+
+--*/
+{
+  mStatus            = STATUS_SUCCESS;
+  mErrorCount        = 0;
+  mWarningCount      = 0;
+  mPrintLogLevel     = INFO_LOG_LEVEL;
+  mSourceFileName    = NULL;
+  mSourceFileLineNum = 0;
+}
+
+VOID
+StartThreadMessages (
+  THREAD_MESSAGES  *Messages
+  )
+/*++
+
+Routine Description:
+  Keep the messages of the calling worker thread in Messages, until
+  StopThreadMessages() is called. Messages->File receives the printed
+  messages, the status and the counts are cleared.
+
+Arguments:
+  Messages  - the messages of the thread.
+
+Returns:
+  NA
+
+--*/
+{
+  Messages->Status       = STATUS_SUCCESS;
+  Messages->ErrorCount   = 0;
+  Messages->WarningCount = 0;
+  mThreadMessages        = Messages;
+}
+
+VOID
+StopThreadMessages (
+  VOID
+  )
+/*++
+
+Routine Description:
+  Stop keeping the messages of the calling thread, they are printed and
+  counted in the utility status again.
+
+Arguments:
+  None.
+
+Returns:
+  NA
+
+--*/
+{
+  fflush (mThreadMessages->File);
+  mThreadMessages = NULL;
+}
+
+VOID
+ReportThreadMessages (
+  THREAD_MESSAGES  *Messages
+  )
+/*++
+
+Routine Description:
+  Print the messages a worker thread kept in Messages, and add its errors and
+  warnings to the utility status. Called by the main thread once the worker
+  thread stopped.
+
+Arguments:
+  Messages  - the messages of the worker thread.
+
+Returns:
+  NA
+
+--*/
+{
+  CHAR8   Buffer[MAX_LINE_LEN];
+  size_t  Size;
+
+  rewind (Messages->File);
+  while ((Size = fread (Buffer, 1, sizeof (Buffer), Messages->File)) > 0) {
+    fwrite (Buffer, 1, Size, GetMessageOutput ());
+  }
+
+  mErrorCount   += Messages->ErrorCount;
+  mWarningCount += Messages->WarningCount;
+  if (mStatus < Messages->Status) {
+    mStatus = Messages->Status;
+  }
+}
+
+VOID
+SetMessageOutput (
+  FILE  *Output
+  )
+/*++
+
+Routine Description:
+  Print the messages of the calling thread into Output instead of stdout.
+  Used to capture the messages of a utility run in the calling process
+  (e.g. from a Python extension), without redirecting the standard output
+  of the process.
+
+Arguments:
+  Output  - the file receiving the messages, NULL to print them into stdout.
+
+Returns:
+  NA
+
+--*/
+{
+  mMessageOutput = Output;
+}
+
+FILE *
+GetMessageOutput (
+  VOID
+  )
+/*++
+
+Routine Description:
+  Return the file the messages of the calling thread are printed into: the
+  file of StartThreadMessages() for a worker thread, else the file of
+  SetMessageOutput(), else stdout.
+
+Arguments:
+  None.
+
+Returns:
+  The file receiving the messages of the calling thread.
+
+--*/
+{
+  if (mThreadMessages != NULL) {
+    return mThreadMessages->File;
+  }
+
+  if (mMessageOutput != NULL) {
+    return mMessageOutput;
+  }
+
+  return stdout;
+}
+
 VOID
 SetPrintLevel (
   UINT64  LogLevel
@@ -9,6 +9,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #ifndef _EFI_UTILITY_MSGS_H_
 #define _EFI_UTILITY_MSGS_H_
 
+#include <stdio.h>
 #include <Common/UefiBaseTypes.h>
 
 //
@@ -46,6 +47,61 @@ GetUtilityStatus (
   VOID
   );
 
+//
+// Utilities that are run more than once in the same process (e.g. from a
+// Python extension) call ResetUtilityStatus() before every run, so errors,
+// warnings and the print level of a previous run are not carried over.
+//
+VOID
+ResetUtilityStatus (
+  VOID
+  );
+
+//
+// Messages of a worker thread, reported by the main thread. Between
+// StartThreadMessages() and StopThreadMessages(), the messages the calling
+// thread prints are written to File, and the errors and warnings are counted
+// in this structure instead of the utility status. The main thread then
+// prints them and adds them to the utility status with ReportThreadMessages().
+//
+typedef struct {
+  FILE    *File;
+  STATUS  Status;
+  UINT32  ErrorCount;
+  UINT32  WarningCount;
+} THREAD_MESSAGES;
+
+VOID
+StartThreadMessages (
+  THREAD_MESSAGES  *Messages
+  );
+
+VOID
+StopThreadMessages (
+  VOID
+  );
+
+VOID
+ReportThreadMessages (
+  THREAD_MESSAGES  *Messages
+  );
+
+//
+// Output of the messages of the calling thread, stdout by default. A utility
+// run in the calling process prints its messages into the file given to
+// SetMessageOutput() so they can be captured. GetMessageOutput() returns the
+// file the messages of the calling thread are printed into.
+//
+VOID
+SetMessageOutput (
+  FILE  *Output
+  );
+
+FILE *
+GetMessageOutput (
+  VOID
+  );
+
 //
 // If someone prints an error message and didn't specify a source file name,
 // then we print the utility name instead. However they must tell us the
@@ -117,6 +117,8 @@ Returns:
                         If value is FALSE, will always not take reabse action\n\
                         If not specified, will take rebase action if rebase address greater than zero, \n\
                         will not take rebase action if rebase address is zero.\n");
+  fprintf (stdout, "  --threads N           N is the number of threads rebasing the FFS files,\n\
+                        0 (default) for one thread per processor.\n");
   fprintf (stdout, "  -a AddressFile, --addrfile AddressFile\n\
                         AddressFile is one file used to record the child\n\
                         FV base address when current FV base address is set.\n");
@@ -220,6 +222,7 @@ Returns:
   //
   // Init global data to Zero
   //
+  InitializeGenFvInternalLib ();
   memset (&mFvDataInfo, 0, sizeof (FV_INFO));
   memset (&mCapDataInfo, 0, sizeof (CAP_INFO));
   //
@@ -394,6 +397,19 @@ Returns:
       continue;
     }
 
+    if (stricmp (argv[0], "--threads") == 0) {
+      Status = AsciiStringToUint64 (argv[1], FALSE, &TempNumber);
+      if (EFI_ERROR (Status) || TempNumber > MAX_NUMBER_OF_REBASE_THREADS) {
+        Error (NULL, 0, 1003, "Invalid option value", "%s = %s", argv[0], argv[1]);
+        return STATUS_ERROR;
+      }
+      mFfsRebaseThreads = (UINT32) TempNumber;
+      DebugMsg (NULL, 0, 9, "FFS rebase threads", "%s = %s", argv[0], argv[1]);
+      argc -= 2;
+      argv += 2;
+      continue;
+    }
+
     if (stricmp (argv[0], "--capheadsize") == 0) {
       //
       // Get Capsule Image Header Size
@@ -20,6 +20,10 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #endif
 #ifdef __GNUC__
 #include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
 #endif
 #include <string.h>
 #ifndef __GNUC__
@@ -166,6 +170,109 @@ BOOLEAN                     mIsLargeFfs = FALSE;
 EFI_PHYSICAL_ADDRESS mFvBaseAddress[0x10];
 UINT32               mFvBaseAddressNumber = 0;
 
+//
+// Number of threads rebasing the FFS files, 0 for one per processor
+//
+UINT32               mFfsRebaseThreads = 0;
+
+//
+// FFS file placed in the FV image, rebased once all the files are placed.
+// A file rebased by a worker thread writes its map file entries to MapFile,
+// and its messages to Messages. The main thread appends them to the FV map
+// file and reports them in the order of the files.
+//
+typedef struct {
+  CHAR8                 *FileName;
+  EFI_FFS_FILE_HEADER   *FfsFile;
+  UINTN                 XipOffset;
+  BOOLEAN               Parallel;
+  FILE                  *MapFile;
+  THREAD_MESSAGES       Messages;
+  EFI_STATUS            Status;
+} FFS_REBASE_JOB;
+
+//
+// Jobs of a worker thread: the parallel jobs FirstJob, FirstJob + JobStride...
+//
+typedef struct {
+  FV_INFO               *FvInfo;
+  UINTN                 FirstJob;
+  UINTN                 JobStride;
+} FFS_REBASE_WORKER;
+
+#ifdef __GNUC__
+typedef pthread_t       REBASE_THREAD;
+#else
+typedef HANDLE          REBASE_THREAD;
+#endif
+
+STATIC FFS_REBASE_JOB   mFfsRebaseJobs[MAX_NUMBER_OF_FILES_IN_FV];
+STATIC UINTN            mFfsRebaseJobCount = 0;
+STATIC UINTN            mParallelRebaseJobs[MAX_NUMBER_OF_FILES_IN_FV];
+STATIC UINTN            mParallelRebaseJobCount = 0;
+
+//
+// Output FV file mapped to memory
+//
+typedef struct {
+#ifdef __GNUC__
+  int                   FileDescriptor;
+#else
+  HANDLE                FileHandle;
+  HANDLE                MappingHandle;
+#endif
+  UINT8                 *Buffer;
+  UINTN                 Size;
+} FV_FILE_MAPPING;
+
+STATIC
+VOID
+QueueFfsRebase (
+  IN FV_INFO              *FvInfo,
+  IN UINTN                Index,
+  IN EFI_FFS_FILE_HEADER  *FfsFile,
+  IN UINTN                XipOffset
+  );
+
+STATIC
+EFI_STATUS
+RebaseFfsFiles (
+  IN FV_INFO              *FvInfo,
+  IN FILE                 *FvMapFile
+  );
+
+VOID
+InitializeGenFvInternalLib (
+  VOID
+  )
+/*++
+
+Routine Description:
+
+  This function resets the global state of the library, so several FV or
+  capsule images can be generated in the same process.
+
+Arguments:
+
+  None
+
+Returns:
+
+  None
+
+--*/
+{
+  mArm                    = FALSE;
+  mRiscV                  = FALSE;
+  MaxFfsAlignment         = 0;
+  VtfFileFlag             = FALSE;
+  mIsLargeFfs             = FALSE;
+  mFvBaseAddressNumber    = 0;
+  mFfsRebaseThreads       = 0;
+  mFfsRebaseJobCount      = 0;
+  mParallelRebaseJobCount = 0;
+}
+
 EFI_STATUS
 ParseFvInf (
   IN  MEMORY_FILE  *InfFile,
@@ -1339,19 +1446,16 @@ Returns:
         return EFI_ABORTED;
       }
       //
-      // Rebase the PE or TE image in FileBuffer of FFS file for XIP
-      // Rebase for the debug genfvmap tool
-      //
-      Status = FfsRebase (FvInfo, FvInfo->FvFiles[Index], (EFI_FFS_FILE_HEADER *) FileBuffer, (UINTN) *VtfFileImage - (UINTN) FvImage->FileImage, FvMapFile);
-      if (EFI_ERROR (Status)) {
-        Error (NULL, 0, 3000, "Invalid", "Could not rebase %s.", FvInfo->FvFiles[Index]);
-        return Status;
-      }
-      //
       // copy VTF File
       //
       memcpy (*VtfFileImage, FileBuffer, FileSize);
 
+      //
+      // Rebase the PE or TE image of the FFS file in the FV image for XIP
+      // Rebase for the debug genfvmap tool
+      //
+      QueueFfsRebase (FvInfo, Index, *VtfFileImage, (UINTN) *VtfFileImage - (UINTN) FvImage->FileImage);
+
       PrintGuidToBuffer ((EFI_GUID *) FileBuffer, FileGuidString, sizeof (FileGuidString), TRUE);
       fprintf (FvReportFile, "0x%08X %s\n", (unsigned)(UINTN) (((UINT8 *)*VtfFileImage) - (UINTN)FvImage->FileImage), FileGuidString);
 
@@ -1384,19 +1488,15 @@ Returns:
   // Add file
   //
   if ((UINTN) (FvImage->CurrentFilePointer + FileSize) <= (UINTN) (*VtfFileImage)) {
-    //
-    // Rebase the PE or TE image in FileBuffer of FFS file for XIP.
-    // Rebase Bs and Rt drivers for the debug genfvmap tool.
-    //
-    Status = FfsRebase (FvInfo, FvInfo->FvFiles[Index], (EFI_FFS_FILE_HEADER *) FileBuffer, (UINTN) FvImage->CurrentFilePointer - (UINTN) FvImage->FileImage, FvMapFile);
-  if (EFI_ERROR (Status)) {
-    Error (NULL, 0, 3000, "Invalid", "Could not rebase %s.", FvInfo->FvFiles[Index]);
-    return Status;
-  }
     //
     // Copy the file
     //
     memcpy (FvImage->CurrentFilePointer, FileBuffer, FileSize);
+    //
+    // Rebase the PE or TE image of the FFS file in the FV image for XIP.
+    // Rebase Bs and Rt drivers for the debug genfvmap tool.
+    //
+    QueueFfsRebase (FvInfo, Index, (EFI_FFS_FILE_HEADER *) FvImage->CurrentFilePointer, (UINTN) FvImage->CurrentFilePointer - (UINTN) FvImage->FileImage);
     PrintGuidToBuffer ((EFI_GUID *) FileBuffer, FileGuidString, sizeof (FileGuidString), TRUE);
     fprintf (FvReportFile, "0x%08X %s\n", (unsigned) (FvImage->CurrentFilePointer - FvImage->FileImage), FileGuidString);
     FvImage->CurrentFilePointer += FileSize;
@@ -2497,6 +2597,133 @@ Returns:
   return EFI_SUCCESS;
 }
 
+STATIC
+EFI_STATUS
+MapFvFile (
+  IN  CHAR8                *FileName,
+  IN  UINTN                Size,
+  OUT FV_FILE_MAPPING      *Mapping
+  )
+/*++
+
+Routine Description:
+
+  This function creates the FV file with the size of the FV image, and maps
+  it to memory, so the image is generated in the file. The blocks of the file
+  are allocated before it is mapped: a full disk is reported here, and not
+  when the mapped memory is written.
+
+Arguments:
+
+  FileName      Name of the FV file.
+  Size          Size of the FV image.
+  Mapping       The mapping of the file.
+
+Returns:
+
+  EFI_SUCCESS       The file is mapped at Mapping->Buffer.
+  EFI_UNSUPPORTED   The file can't be mapped, the image must be written.
+
+--*/
+{
+#if defined(__GNUC__) && !defined(__APPLE__)
+  int     FileDescriptor;
+  VOID    *Buffer;
+
+  Mapping->Buffer = NULL;
+  FileDescriptor  = open (LongFilePath (FileName), O_RDWR | O_CREAT | O_TRUNC, 0666);
+  if (FileDescriptor < 0) {
+    return EFI_UNSUPPORTED;
+  }
+
+  if (posix_fallocate (FileDescriptor, 0, (off_t) Size) != 0) {
+    close (FileDescriptor);
+    return EFI_UNSUPPORTED;
+  }
+
+  Buffer = mmap (NULL, Size, PROT_READ | PROT_WRITE, MAP_SHARED, FileDescriptor, 0);
+  if (Buffer == MAP_FAILED) {
+    close (FileDescriptor);
+    return EFI_UNSUPPORTED;
+  }
+
+  Mapping->FileDescriptor = FileDescriptor;
+  Mapping->Buffer         = Buffer;
+  Mapping->Size           = Size;
+  return EFI_SUCCESS;
+#elif !defined(__GNUC__)
+  HANDLE  FileHandle;
+  HANDLE  MappingHandle;
+  VOID    *Buffer;
+
+  Mapping->Buffer = NULL;
+  FileHandle = CreateFileA (LongFilePath (FileName), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+  if (FileHandle == INVALID_HANDLE_VALUE) {
+    return EFI_UNSUPPORTED;
+  }
+
+  //
+  // The mapping extends the file to Size
+  //
+  MappingHandle = CreateFileMappingA (FileHandle, NULL, PAGE_READWRITE, (DWORD) ((UINT64) Size >> 32), (DWORD) Size, NULL);
+  if (MappingHandle == NULL) {
+    CloseHandle (FileHandle);
+    return EFI_UNSUPPORTED;
+  }
+
+  Buffer = MapViewOfFile (MappingHandle, FILE_MAP_WRITE, 0, 0, Size);
+  if (Buffer == NULL) {
+    CloseHandle (MappingHandle);
+    CloseHandle (FileHandle);
+    return EFI_UNSUPPORTED;
+  }
+
+  Mapping->FileHandle    = FileHandle;
+  Mapping->MappingHandle = MappingHandle;
+  Mapping->Buffer        = Buffer;
+  Mapping->Size          = Size;
+  return EFI_SUCCESS;
+#else
+  //
+  // The blocks of the file can't be allocated in advance
+  //
+  Mapping->Buffer = NULL;
+  return EFI_UNSUPPORTED;
+#endif
+}
+
+STATIC
+VOID
+UnmapFvFile (
+  IN FV_FILE_MAPPING      *Mapping
+  )
+/*++
+
+Routine Description:
+
+  This function unmaps and closes a file mapped by MapFvFile().
+
+Arguments:
+
+  Mapping       The mapping of the file.
+
+Returns:
+
+  None
+
+--*/
+{
+#ifdef __GNUC__
+  munmap (Mapping->Buffer, Mapping->Size);
+  close (Mapping->FileDescriptor);
+#else
+  UnmapViewOfFile (Mapping->Buffer);
+  CloseHandle (Mapping->MappingHandle);
+  CloseHandle (Mapping->FileHandle);
+#endif
+  Mapping->Buffer = NULL;
+}
+
 EFI_STATUS
 GenerateFvImage (
   IN CHAR8                *InfFileImage,
@@ -2543,6 +2770,7 @@ Returns:
   UINTN                           FileSize;
   CHAR8                           *FvReportName;
   FILE                            *FvReportFile;
+  FV_FILE_MAPPING                 FvFileMapping;
 
   FvBufferHeader = NULL;
   FvFile         = NULL;
@@ -2550,6 +2778,7 @@ Returns:
   FvMapFile      = NULL;
   FvReportName   = NULL;
   FvReportFile   = NULL;
+  memset (&FvFileMapping, 0, sizeof (FvFileMapping));
 
   if (InfFileImage != NULL) {
     //
@@ -2754,14 +2983,24 @@ Returns:
   FvImageSize = mFvDataInfo.Size;
 
   //
-  // Allocate the FV, assure FvImage Header 8 byte alignment
+  // Generate the FV in the mapped FV file, it doesn't need to be written.
+  // If the file can't be mapped, generate it in memory and write it.
   //
-  FvBufferHeader = malloc (FvImageSize + sizeof (UINT64));
-  if (FvBufferHeader == NULL) {
-    Status = EFI_OUT_OF_RESOURCES;
-    goto Finish;
+  Status = MapFvFile (FvFileName, FvImageSize, &FvFileMapping);
+  if (!EFI_ERROR (Status)) {
+    FvImage = FvFileMapping.Buffer;
+  } else {
+    //
+    // Allocate the FV, assure FvImage Header 8 byte alignment
+    //
+    FvBufferHeader = malloc (FvImageSize + sizeof (UINT64));
+    if (FvBufferHeader == NULL) {
+      Status = EFI_OUT_OF_RESOURCES;
+      goto Finish;
+    }
+    FvImage = (UINT8 *) (((UINTN) FvBufferHeader + 7) & ~7);
+    Status  = EFI_SUCCESS;
   }
-  FvImage = (UINT8 *) (((UINTN) FvBufferHeader + 7) & ~7);
 
   //
   // Initialize the FV to the erase polarity
@@ -2919,6 +3158,14 @@ Returns:
     }
   }
 
+  //
+  // Rebase the files, now that they are all placed
+  //
+  Status = RebaseFfsFiles (&mFvDataInfo, FvMapFile);
+  if (EFI_ERROR (Status)) {
+    goto Finish;
+  }
+
   //
   // If there is a VTF file, some special actions need to occur.
   //
@@ -3008,26 +3255,40 @@ Returns:
 
 WriteFile:
   //
-  // Write fv file
+  // Write fv file, unless it is generated in the mapped file
   //
-  FvFile = fopen (LongFilePath (FvFileName), "wb");
-  if (FvFile == NULL) {
-    Error (NULL, 0, 0001, "Error opening file", FvFileName);
-    Status = EFI_ABORTED;
-    goto Finish;
-  }
+  if (FvFileMapping.Buffer == NULL) {
+    FvFile = fopen (LongFilePath (FvFileName), "wb");
+    if (FvFile == NULL) {
+      Error (NULL, 0, 0001, "Error opening file", FvFileName);
+      Status = EFI_ABORTED;
+      goto Finish;
+    }
 
-  if (fwrite (FvImage, 1, FvImageSize, FvFile) != FvImageSize) {
-    Error (NULL, 0, 0002, "Error writing file", FvFileName);
-    Status = EFI_ABORTED;
-    goto Finish;
+    if (fwrite (FvImage, 1, FvImageSize, FvFile) != FvImageSize) {
+      Error (NULL, 0, 0002, "Error writing file", FvFileName);
+      Status = EFI_ABORTED;
+      goto Finish;
+    }
   }
 
 Finish:
+  mFfsRebaseJobCount = 0;
+
   if (FvBufferHeader != NULL) {
     free (FvBufferHeader);
   }
 
+  if (FvFileMapping.Buffer != NULL) {
+    UnmapFvFile (&FvFileMapping);
+    //
+    // Don't leave a partially generated FV file
+    //
+    if (EFI_ERROR (Status)) {
+      remove (LongFilePath (FvFileName));
+    }
+  }
+
   if (FvExtHeader != NULL) {
     free (FvExtHeader);
   }
@@ -4055,6 +4316,350 @@ Returns:
   return EFI_SUCCESS;
 }
 
+STATIC
+BOOLEAN
+CanRebaseInParallel (
+  IN FV_INFO              *FvInfo,
+  IN EFI_FFS_FILE_HEADER  *FfsFile
+  )
+/*++
+
+Routine Description:
+
+  This function checks whether a worker thread can rebase an FFS file. The
+  rebase of a file only changes the file and the map file entries, except:
+    - FV image files record their child FVs in mFvBaseAddress, in the order
+      of the files, and search them with the global FV of FvLib.
+    - The relocations of RISC-V images keep state in the PE/COFF library.
+  Files without PE32 or TE images are not rebased, they don't need a thread.
+  mArm and mRiscV may be set by any thread, they are only set to TRUE.
+
+Arguments:
+
+  FvInfo            A pointer to FV_INFO structure.
+  FfsFile           A pointer to Ffs file image.
+
+Returns:
+
+  TRUE              A worker thread can rebase the file.
+  FALSE             The file must be rebased by the main thread.
+
+--*/
+{
+  EFI_STATUS                    Status;
+  EFI_FILE_SECTION_POINTER      ImageSection;
+  PE_COFF_LOADER_IMAGE_CONTEXT  ImageContext;
+  UINT8                         SectionType;
+  UINTN                         Index;
+
+  //
+  // Same conditions as FfsRebase()
+  //
+  if (((FvInfo->BaseAddress == 0) && (FvInfo->ForceRebase == -1)) || FvInfo->ForceRebase == 0) {
+    return FALSE;
+  }
+
+  switch (FfsFile->Type) {
+    case EFI_FV_FILETYPE_SECURITY_CORE:
+    case EFI_FV_FILETYPE_PEI_CORE:
+    case EFI_FV_FILETYPE_PEIM:
+    case EFI_FV_FILETYPE_COMBINED_PEIM_DRIVER:
+    case EFI_FV_FILETYPE_DRIVER:
+    case EFI_FV_FILETYPE_DXE_CORE:
+      break;
+    default:
+      return FALSE;
+  }
+
+  for (SectionType = EFI_SECTION_PE32; SectionType <= EFI_SECTION_TE; SectionType++) {
+    if (SectionType != EFI_SECTION_PE32 && SectionType != EFI_SECTION_TE) {
+      continue;
+    }
+    for (Index = 1;; Index++) {
+      Status = GetSectionByType (FfsFile, SectionType, Index, &ImageSection);
+      if (EFI_ERROR (Status)) {
+        break;
+      }
+      memset (&ImageContext, 0, sizeof (ImageContext));
+      ImageContext.Handle     = (VOID *) ((UINTN) ImageSection.Pe32Section + GetSectionHeaderLength (ImageSection.CommonHeader));
+      ImageContext.ImageRead  = (PE_COFF_LOADER_READ_FILE) FfsRebaseImageRead;
+      Status                  = PeCoffLoaderGetImageInfo (&ImageContext);
+      if (EFI_ERROR (Status) || ImageContext.Machine == EFI_IMAGE_MACHINE_RISCV64) {
+        return FALSE;
+      }
+    }
+  }
+
+  return TRUE;
+}
+
+STATIC
+VOID
+QueueFfsRebase (
+  IN FV_INFO              *FvInfo,
+  IN UINTN                Index,
+  IN EFI_FFS_FILE_HEADER  *FfsFile,
+  IN UINTN                XipOffset
+  )
+/*++
+
+Routine Description:
+
+  This function records an FFS file placed in the FV image, to rebase it
+  once all the files are placed.
+
+Arguments:
+
+  FvInfo            A pointer to FV_INFO structure.
+  Index             The file in the FvInfo file list.
+  FfsFile           A pointer to the Ffs file in the FV image.
+  XipOffset         The offset address to use for rebasing the XIP file image.
+
+Returns:
+
+  None
+
+--*/
+{
+  FFS_REBASE_JOB  *Job;
+
+  Job            = &mFfsRebaseJobs[mFfsRebaseJobCount++];
+  Job->FileName  = FvInfo->FvFiles[Index];
+  Job->FfsFile   = FfsFile;
+  Job->XipOffset = XipOffset;
+  Job->Parallel  = CanRebaseInParallel (FvInfo, FfsFile);
+  Job->MapFile   = NULL;
+  Job->Status    = EFI_SUCCESS;
+
+  Job->Messages.File = NULL;
+}
+
+STATIC
+VOID
+RunFfsRebaseJobs (
+  IN FFS_REBASE_WORKER    *Worker
+  )
+/*++
+
+Routine Description:
+
+  This function rebases the FFS files of a worker thread.
+
+Arguments:
+
+  Worker            The jobs of the thread.
+
+Returns:
+
+  None
+
+--*/
+{
+  UINTN           Index;
+  FFS_REBASE_JOB  *Job;
+
+  for (Index = Worker->FirstJob; Index < mParallelRebaseJobCount; Index += Worker->JobStride) {
+    Job         = &mFfsRebaseJobs[mParallelRebaseJobs[Index]];
+    StartThreadMessages (&Job->Messages);
+    Job->Status = FfsRebase (Worker->FvInfo, Job->FileName, Job->FfsFile, Job->XipOffset, Job->MapFile);
+    StopThreadMessages ();
+  }
+}
+
+#ifdef __GNUC__
+STATIC
+VOID *
+FfsRebaseThread (
+  IN VOID                 *Worker
+  )
+{
+  RunFfsRebaseJobs ((FFS_REBASE_WORKER *) Worker);
+  return NULL;
+}
+#else
+STATIC
+DWORD
+WINAPI
+FfsRebaseThread (
+  IN LPVOID               Worker
+  )
+{
+  RunFfsRebaseJobs ((FFS_REBASE_WORKER *) Worker);
+  return 0;
+}
+#endif
+
+STATIC
+UINTN
+GetNumberOfProcessors (
+  VOID
+  )
+{
+#ifdef __GNUC__
+  long  Count;
+
+  Count = sysconf (_SC_NPROCESSORS_ONLN);
+  return (Count > 0) ? (UINTN) Count : 1;
+#else
+  SYSTEM_INFO  SystemInfo;
+
+  GetSystemInfo (&SystemInfo);
+  return (UINTN) SystemInfo.dwNumberOfProcessors;
+#endif
+}
+
+STATIC
+EFI_STATUS
+RebaseFfsFiles (
+  IN FV_INFO              *FvInfo,
+  IN FILE                 *FvMapFile
+  )
+/*++
+
+Routine Description:
+
+  This function rebases the FFS files queued by AddFile(). The files a worker
+  thread can rebase are rebased by up to mFfsRebaseThreads threads first. Then
+  the other files are rebased, and the map file entries and the messages of
+  the worker threads are written, in the order of the files, so the FV, its
+  map file and the messages don't depend on the threads.
+
+Arguments:
+
+  FvInfo            A pointer to FV_INFO structure.
+  FvMapFile         FvMapFile to record the function address in one Fvimage
+
+Returns:
+
+  EFI_SUCCESS       All the files were rebased.
+  Others            The status of the first file which could not be rebased.
+
+--*/
+{
+  EFI_STATUS          Status;
+  FFS_REBASE_JOB      *Job;
+  FFS_REBASE_WORKER   Workers[MAX_NUMBER_OF_REBASE_THREADS];
+  REBASE_THREAD       Threads[MAX_NUMBER_OF_REBASE_THREADS];
+  BOOLEAN             ThreadCreated[MAX_NUMBER_OF_REBASE_THREADS];
+  UINTN               ThreadCount;
+  UINTN               Index;
+  UINT8               Buffer[0x1000];
+  size_t              Size;
+
+  ThreadCount = mFfsRebaseThreads;
+  if (ThreadCount == 0) {
+    ThreadCount = GetNumberOfProcessors ();
+  }
+  if (ThreadCount > MAX_NUMBER_OF_REBASE_THREADS) {
+    ThreadCount = MAX_NUMBER_OF_REBASE_THREADS;
+  }
+
+  //
+  // A file rebased by a worker thread writes its map file entries and its
+  // messages to temporary files. The files which don't get them are rebased
+  // in order.
+  //
+  mParallelRebaseJobCount = 0;
+  if (ThreadCount > 1) {
+    for (Index = 0; Index < mFfsRebaseJobCount; Index++) {
+      Job = &mFfsRebaseJobs[Index];
+      if (Job->Parallel) {
+        Job->MapFile       = tmpfile ();
+        Job->Messages.File = tmpfile ();
+        if ((Job->MapFile != NULL) && (Job->Messages.File != NULL)) {
+          mParallelRebaseJobs[mParallelRebaseJobCount++] = Index;
+        } else {
+          if (Job->MapFile != NULL) {
+            fclose (Job->MapFile);
+            Job->MapFile = NULL;
+          }
+          if (Job->Messages.File != NULL) {
+            fclose (Job->Messages.File);
+            Job->Messages.File = NULL;
+          }
+        }
+      }
+    }
+  }
+
+  if (ThreadCount > mParallelRebaseJobCount) {
+    ThreadCount = mParallelRebaseJobCount;
+  }
+  VerboseMsg ("Rebase %u of %u FFS files with %u threads", (unsigned) mParallelRebaseJobCount, (unsigned) mFfsRebaseJobCount, (unsigned) ThreadCount);
+
+  //
+  // The main thread runs the jobs of the first worker, and of the workers
+  // whose thread can't be created.
+  //
+  for (Index = 0; Index < ThreadCount; Index++) {
+    Workers[Index].FvInfo    = FvInfo;
+    Workers[Index].FirstJob  = Index;
+    Workers[Index].JobStride = ThreadCount;
+    ThreadCreated[Index]     = FALSE;
+  }
+  for (Index = 1; Index < ThreadCount; Index++) {
+#ifdef __GNUC__
+    ThreadCreated[Index] = (BOOLEAN) (pthread_create (&Threads[Index], NULL, FfsRebaseThread, &Workers[Index]) == 0);
+#else
+    Threads[Index]       = CreateThread (NULL, 0, FfsRebaseThread, &Workers[Index], 0, NULL);
+    ThreadCreated[Index] = (BOOLEAN) (Threads[Index] != NULL);
+#endif
+  }
+  for (Index = 0; Index < ThreadCount; Index++) {
+    if (!ThreadCreated[Index]) {
+      RunFfsRebaseJobs (&Workers[Index]);
+    }
+  }
+  for (Index = 1; Index < ThreadCount; Index++) {
+    if (ThreadCreated[Index]) {
+#ifdef __GNUC__
+      pthread_join (Threads[Index], NULL);
+#else
+      WaitForSingleObject (Threads[Index], INFINITE);
+      CloseHandle (Threads[Index]);
+#endif
+    }
+  }
+
+  Status = EFI_SUCCESS;
+  for (Index = 0; Index < mFfsRebaseJobCount; Index++) {
+    Job = &mFfsRebaseJobs[Index];
+    if (!EFI_ERROR (Status)) {
+      if (Job->MapFile == NULL) {
+        Job->Status = FfsRebase (FvInfo, Job->FileName, Job->FfsFile, Job->XipOffset, FvMapFile);
+      } else {
+        //
+        // The worker threads don't touch the utility status, their errors and
+        // warnings are reported here.
+        //
+        ReportThreadMessages (&Job->Messages);
+        if (!EFI_ERROR (Job->Status)) {
+          rewind (Job->MapFile);
+          while ((Size = fread (Buffer, 1, sizeof (Buffer), Job->MapFile)) > 0) {
+            fwrite (Buffer, 1, Size, FvMapFile);
+          }
+        }
+      }
+      if (EFI_ERROR (Job->Status)) {
+        Error (NULL, 0, 3000, "Invalid", "Could not rebase %s.", Job->FileName);
+        Status = Job->Status;
+      }
+    }
+    if (Job->MapFile != NULL) {
+      fclose (Job->MapFile);
+      Job->MapFile = NULL;
+    }
+    if (Job->Messages.File != NULL) {
+      fclose (Job->Messages.File);
+      Job->Messages.File = NULL;
+    }
+  }
+
+  mFfsRebaseJobCount      = 0;
+  mParallelRebaseJobCount = 0;
+  return Status;
+}
+
 EFI_STATUS
 FindApResetVectorPosition (
   IN  MEMORY_FILE  *FvImage,
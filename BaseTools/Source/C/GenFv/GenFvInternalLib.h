@@ -48,6 +48,12 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #define MAX_NUMBER_OF_FILES_IN_FV       1000
 #define MAX_NUMBER_OF_FILES_IN_CAP      1000
 #define EFI_FFS_FILE_HEADER_ALIGNMENT   8
+
+//
+// The maximum number of threads rebasing the files of an FV
+//
+#define MAX_NUMBER_OF_REBASE_THREADS    64
+
 //
 // INF file strings
 //
@@ -245,6 +251,7 @@ extern UINT32     mFvTakenSize;
 
 extern EFI_PHYSICAL_ADDRESS mFvBaseAddress[];
 extern UINT32               mFvBaseAddressNumber;
+extern UINT32               mFfsRebaseThreads;
 //
 // Local function prototypes
 //
@@ -339,6 +346,28 @@ FfsRebase (
 //
 // Exported function prototypes
 //
+VOID
+InitializeGenFvInternalLib (
+  VOID
+  )
+/*++
+
+Routine Description:
+
+  This is the function which resets the global state of the library, so
+  several FV or capsule images can be generated in the same process.
+
+Arguments:
+
+  None
+
+Returns:
+
+  None
+
+--*/
+;
+
 EFI_STATUS
 GenerateCapImage (
   IN CHAR8                *InfFileImage,
@@ -15,18 +15,42 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#ifndef _WIN32
+#include <unistd.h>
+#endif
 
 #include "Sdk/C/Alloc.h"
 #include "Sdk/C/7zFile.h"
 #include "Sdk/C/7zVersion.h"
+#include "Sdk/C/CpuArch.h"
 #include "Sdk/C/LzmaDec.h"
 #include "Sdk/C/LzmaEnc.h"
 #include "Sdk/C/Bra.h"
+#include "Sdk/C/Threads.h"
 #include "CommonLib.h"
 #include "ParseInf.h"
 
 #define LZMA_HEADER_SIZE (LZMA_PROPS_SIZE + 8)
 
+//
+// Block container written with --block-size. The input is split into blocks
+// of BlockSize bytes which are compressed independently, so that they can be
+// encoded in parallel. The container starts with:
+//
+//   UINT32  Signature         LZMA_BLOCK_SIGNATURE
+//   UINT32  BlockSize         Uncompressed size of each block but the last one
+//   UINT64  UncompressedSize  Size of the whole uncompressed data
+//   UINT32  BlockCount
+//   UINT32  CompressedSize[BlockCount]
+//
+// followed by the blocks. Each block is a regular LZMA stream with its own
+// LZMA_HEADER_SIZE bytes header. All fields are little endian.
+//
+#define LZMA_BLOCK_SIGNATURE    0x504D5A4C  // "LZMP"
+#define LZMA_BLOCK_HEADER_SIZE  20
+#define LZMA_MAX_BLOCK_SIZE_KB  (1 << 20)
+#define LZMA_MAX_THREADS        64
+
 typedef enum {
   NoConverter,
   X86Converter,
@@ -44,10 +68,12 @@ static CONVERTER_TYPE mConType = NoConverter;
 
 UINT64 mDictionarySize = 28;
 UINT64 mCompressionMode = 2;
+UINT64 mBlockSize = 0;
+UINT64 mNumThreads = 0;
 
 #define UTILITY_NAME "LzmaCompress"
 #define UTILITY_MAJOR_VERSION 0
-#define UTILITY_MINOR_VERSION 2
+#define UTILITY_MINOR_VERSION 3
 #define INTEL_COPYRIGHT \
   "Copyright (c) 2009-2018, Intel Corporation. All rights reserved."
 void PrintHelp(char *buffer)
@@ -65,6 +91,11 @@ void PrintHelp(char *buffer)
              "  --debug [0-9]: set debug level\n"
              "  -a: set compression mode 0 = fast, 1 = normal, default: 1 (normal)\n"
              "  d: sets Dictionary size - [0, 27], default: 24 (16MB)\n"
+             "  --threads N: number of encoder threads, 1 for a single thread,\n"
+             "               default: 0 (one per processor)\n"
+             "  --block-size Size: split the input into blocks of Size KB that are\n"
+             "               compressed in parallel, and write/read a block container\n"
+             "               instead of a single LZMA stream\n"
              "  --version: display the program version and exit\n"
              "  -h, --help: display this help text\n"
              );
@@ -94,6 +125,221 @@ void PrintVersion(char *buffer)
   sprintf (buffer, "%s Version %d.%d %s ", UTILITY_NAME, UTILITY_MAJOR_VERSION, UTILITY_MINOR_VERSION, __BUILD_VERSION);
 }
 
+static UInt32 GetNumberOfProcessors(void)
+{
+#ifdef _WIN32
+  SYSTEM_INFO systemInfo;
+  GetSystemInfo(&systemInfo);
+  return (UInt32)systemInfo.dwNumberOfProcessors;
+#else
+  long numProcessors = sysconf(_SC_NPROCESSORS_ONLN);
+  return (numProcessors > 0) ? (UInt32)numProcessors : 1;
+#endif
+}
+
+/*
+  Compresses inSize bytes of inBuffer to a single LZMA stream with its
+  LZMA_HEADER_SIZE bytes header. The stream is returned in *outBuffer, which
+  must be freed by the caller with MyFree().
+*/
+static SRes EncodeStream(const Byte *inBuffer, size_t inSize, const CLzmaEncProps *props, Byte **outBuffer, size_t *outSize)
+{
+  SRes res;
+  Byte *buffer;
+  size_t bufferSize;
+  size_t outSizeProcessed;
+  size_t outPropsSize = LZMA_PROPS_SIZE;
+
+  // we allocate 105% of original size + 64KB for output buffer
+  bufferSize = inSize / 20 * 21 + (1 << 16);
+  buffer = (Byte *)MyAlloc(bufferSize);
+  if (buffer == 0)
+    return SZ_ERROR_MEM;
+
+  SetUi64(buffer + LZMA_PROPS_SIZE, (UInt64)inSize);
+
+  outSizeProcessed = bufferSize - LZMA_HEADER_SIZE;
+  res = LzmaEncode(buffer + LZMA_HEADER_SIZE, &outSizeProcessed,
+      inBuffer, inSize,
+      props, buffer, &outPropsSize, 0,
+      NULL, &g_Alloc, &g_Alloc);
+
+  if (res != SZ_OK) {
+    MyFree(buffer);
+    return res;
+  }
+
+  *outBuffer = buffer;
+  *outSize = LZMA_HEADER_SIZE + outSizeProcessed;
+  return SZ_OK;
+}
+
+typedef struct
+{
+  const Byte *inBuffer;
+  size_t inSize;
+  size_t blockSize;
+  UInt32 numBlocks;
+  const CLzmaEncProps *props;
+  Byte **outBuffers;
+  size_t *outSizes;
+  UInt32 nextBlock;
+  SRes res;
+  CCriticalSection cs;
+} CBlockEncoder;
+
+/*
+  Worker of the block encoder. Takes the next block to compress until all
+  blocks are done or one of them failed.
+*/
+static THREAD_FUNC_DECL BlockEncoderThread(void *param)
+{
+  CBlockEncoder *p = (CBlockEncoder *)param;
+  UInt32 block;
+  size_t offset;
+  size_t size;
+  SRes res;
+
+  for (;;)
+  {
+    CriticalSection_Enter(&p->cs);
+    block = p->nextBlock;
+    if (p->res == SZ_OK && block < p->numBlocks)
+      p->nextBlock++;
+    else
+      block = p->numBlocks;
+    CriticalSection_Leave(&p->cs);
+
+    if (block == p->numBlocks)
+      break;
+
+    offset = (size_t)block * p->blockSize;
+    size = p->inSize - offset;
+    if (size > p->blockSize)
+      size = p->blockSize;
+
+    res = EncodeStream(p->inBuffer + offset, size, p->props, &p->outBuffers[block], &p->outSizes[block]);
+    if (res != SZ_OK) {
+      CriticalSection_Enter(&p->cs);
+      if (p->res == SZ_OK)
+        p->res = res;
+      CriticalSection_Leave(&p->cs);
+    }
+  }
+
+  return 0;
+}
+
+/*
+  Compresses inSize bytes of inBuffer to a block container, using up to
+  mNumThreads threads, and writes it to outStream.
+*/
+static SRes EncodeBlocks(ISeqOutStream *outStream, const Byte *inBuffer, size_t inSize, const CLzmaEncProps *props)
+{
+  CBlockEncoder encoder;
+  CLzmaEncProps blockProps;
+  CThread *threads = 0;
+  UInt32 numThreads;
+  UInt32 numCreated = 0;
+  Byte *table = 0;
+  size_t tableSize;
+  UInt32 i;
+  SRes res;
+
+  encoder.inBuffer = inBuffer;
+  encoder.inSize = inSize;
+  encoder.blockSize = (size_t)mBlockSize * 1024;
+  encoder.numBlocks = (UInt32)((inSize + encoder.blockSize - 1) / encoder.blockSize);
+  encoder.nextBlock = 0;
+  encoder.res = SZ_OK;
+
+  //
+  // The blocks provide the parallelism, each of them uses a single thread.
+  // No block is larger than blockSize, so the dictionary does not need to be
+  // larger either.
+  //
+  blockProps = *props;
+  blockProps.numThreads = 1;
+  blockProps.reduceSize = encoder.blockSize;
+  encoder.props = &blockProps;
+
+  numThreads = (UInt32)mNumThreads;
+  if (numThreads > encoder.numBlocks)
+    numThreads = encoder.numBlocks;
+
+  tableSize = LZMA_BLOCK_HEADER_SIZE + (size_t)encoder.numBlocks * 4;
+  table = (Byte *)MyAlloc(tableSize);
+  encoder.outBuffers = (Byte **)MyAlloc(encoder.numBlocks * sizeof(Byte *));
+  encoder.outSizes = (size_t *)MyAlloc(encoder.numBlocks * sizeof(size_t));
+  threads = (CThread *)MyAlloc(numThreads * sizeof(CThread));
+  if (table == 0 || encoder.outBuffers == 0 || encoder.outSizes == 0 || threads == 0) {
+    res = SZ_ERROR_MEM;
+    goto Done;
+  }
+  memset(encoder.outBuffers, 0, encoder.numBlocks * sizeof(Byte *));
+
+  if (CriticalSection_Init(&encoder.cs) != 0) {
+    res = SZ_ERROR_THREAD;
+    goto Done;
+  }
+
+  //
+  // The calling thread is one of the workers. Failing to start the other
+  // ones only costs time, the remaining blocks are compressed here.
+  //
+  for (i = 1; i < numThreads; i++) {
+    Thread_Construct(&threads[numCreated]);
+    if (Thread_Create(&threads[numCreated], BlockEncoderThread, &encoder) != 0)
+      break;
+    numCreated++;
+  }
+  BlockEncoderThread(&encoder);
+  for (i = 0; i < numCreated; i++) {
+    Thread_Wait(&threads[i]);
+    Thread_Close(&threads[i]);
+  }
+  CriticalSection_Delete(&encoder.cs);
+
+  res = encoder.res;
+  if (res != SZ_OK)
+    goto Done;
+
+  SetUi32(table, LZMA_BLOCK_SIGNATURE);
+  SetUi32(table + 4, (UInt32)encoder.blockSize);
+  SetUi64(table + 8, (UInt64)inSize);
+  SetUi32(table + 16, encoder.numBlocks);
+  for (i = 0; i < encoder.numBlocks; i++) {
+    if (encoder.outSizes[i] > (UInt32)-1) {
+      res = SZ_ERROR_OUTPUT_EOF;
+      goto Done;
+    }
+    SetUi32(table + LZMA_BLOCK_HEADER_SIZE + i * 4, (UInt32)encoder.outSizes[i]);
+  }
+
+  if (outStream->Write(outStream, table, tableSize) != tableSize) {
+    res = SZ_ERROR_WRITE;
+    goto Done;
+  }
+  for (i = 0; i < encoder.numBlocks; i++) {
+    if (outStream->Write(outStream, encoder.outBuffers[i], encoder.outSizes[i]) != encoder.outSizes[i]) {
+      res = SZ_ERROR_WRITE;
+      goto Done;
+    }
+  }
+
+Done:
+  if (encoder.outBuffers != 0) {
+    for (i = 0; i < encoder.numBlocks; i++)
+      MyFree(encoder.outBuffers[i]);
+  }
+  MyFree(encoder.outBuffers);
+  MyFree(encoder.outSizes);
+  MyFree(threads);
+  MyFree(table);
+
+  return res;
+}
+
 static SRes Encode(ISeqOutStream *outStream, ISeqInStream *inStream, UInt64 fileSize, CLzmaEncProps *props)
 {
   SRes res;
@@ -116,20 +362,6 @@ static SRes Encode(ISeqOutStream *outStream, ISeqInStream *inStream, UInt64 file
     goto Done;
   }
 
-  // we allocate 105% of original size + 64KB for output buffer
-  outSize = (size_t)fileSize / 20 * 21 + (1 << 16);
-  outBuffer = (Byte *)MyAlloc(outSize);
-  if (outBuffer == 0) {
-    res = SZ_ERROR_MEM;
-    goto Done;
-  }
-
-  {
-    int i;
-    for (i = 0; i < 8; i++)
-      outBuffer[i + LZMA_PROPS_SIZE] = (Byte)(fileSize >> (8 * i));
-  }
-
   if (mConType != NoConverter)
   {
     filteredStream = (Byte *)MyAlloc(inSize);
@@ -148,19 +380,97 @@ static SRes Encode(ISeqOutStream *outStream, ISeqInStream *inStream, UInt64 file
     }
   }
 
-  {
-    size_t outSizeProcessed = outSize - LZMA_HEADER_SIZE;
-    size_t outPropsSize = LZMA_PROPS_SIZE;
+  if (mBlockSize != 0) {
+    res = EncodeBlocks(outStream, inBuffer, inSize, props);
+    goto Done;
+  }
+
+  res = EncodeStream(mConType != NoConverter ? filteredStream : inBuffer, inSize,
+      props, &outBuffer, &outSize);
+  if (res != SZ_OK)
+    goto Done;
+
+  if (outStream->Write(outStream, outBuffer, outSize) != outSize)
+    res = SZ_ERROR_WRITE;
+
+Done:
+  MyFree(outBuffer);
+  MyFree(inBuffer);
+  MyFree(filteredStream);
+
+  return res;
+}
+
+/*
+  Decompresses the block container of inSize bytes in inBuffer and writes
+  the uncompressed data to outStream.
+*/
+static SRes DecodeBlocks(ISeqOutStream *outStream, const Byte *inBuffer, size_t inSize)
+{
+  SRes res = SZ_OK;
+  Byte *outBuffer = 0;
+  UInt64 outSize64;
+  size_t outSize;
+  size_t blockSize;
+  UInt32 numBlocks;
+  UInt32 i;
+  size_t inOffset;
+  size_t outOffset;
+  size_t blockInSize;
+  size_t blockOutSize;
+  size_t expectedSize;
+  size_t inSizePure;
+  ELzmaStatus status;
+
+  if (inSize < LZMA_BLOCK_HEADER_SIZE || GetUi32(inBuffer) != LZMA_BLOCK_SIGNATURE)
+    return SZ_ERROR_DATA;
 
-    res = LzmaEncode(outBuffer + LZMA_HEADER_SIZE, &outSizeProcessed,
-        mConType != NoConverter ? filteredStream : inBuffer, inSize,
-        props, outBuffer, &outPropsSize, 0,
-        NULL, &g_Alloc, &g_Alloc);
+  blockSize = GetUi32(inBuffer + 4);
+  outSize64 = GetUi64(inBuffer + 8);
+  numBlocks = GetUi32(inBuffer + 16);
+  if (blockSize == 0 ||
+      numBlocks > (inSize - LZMA_BLOCK_HEADER_SIZE) / 4 ||
+      (outSize64 + blockSize - 1) / blockSize != numBlocks)
+    return SZ_ERROR_DATA;
 
+  outSize = (size_t)outSize64;
+  if (outSize != outSize64)
+    return SZ_ERROR_MEM;
+  if (outSize == 0)
+    return SZ_OK;
+
+  outBuffer = (Byte *)MyAlloc(outSize);
+  if (outBuffer == 0)
+    return SZ_ERROR_MEM;
+
+  inOffset = LZMA_BLOCK_HEADER_SIZE + (size_t)numBlocks * 4;
+  outOffset = 0;
+  for (i = 0; i < numBlocks; i++) {
+    blockInSize = GetUi32(inBuffer + LZMA_BLOCK_HEADER_SIZE + i * 4);
+    expectedSize = outSize - outOffset;
+    if (expectedSize > blockSize)
+      expectedSize = blockSize;
+
+    if (blockInSize < LZMA_HEADER_SIZE ||
+        blockInSize > inSize - inOffset ||
+        GetUi64(inBuffer + inOffset + LZMA_PROPS_SIZE) != expectedSize) {
+      res = SZ_ERROR_DATA;
+      goto Done;
+    }
+
+    blockOutSize = expectedSize;
+    inSizePure = blockInSize - LZMA_HEADER_SIZE;
+    res = LzmaDecode(outBuffer + outOffset, &blockOutSize, inBuffer + inOffset + LZMA_HEADER_SIZE, &inSizePure,
+        inBuffer + inOffset, LZMA_PROPS_SIZE, LZMA_FINISH_END, &status, &g_Alloc);
     if (res != SZ_OK)
       goto Done;
+    if (blockOutSize != expectedSize) {
+      res = SZ_ERROR_DATA;
+      goto Done;
+    }
 
-    outSize = LZMA_HEADER_SIZE + outSizeProcessed;
+    inOffset += blockInSize;
+    outOffset += blockOutSize;
   }
 
   if (outStream->Write(outStream, outBuffer, outSize) != outSize)
@@ -168,8 +478,6 @@ static SRes Encode(ISeqOutStream *outStream, ISeqInStream *inStream, UInt64 file
 
 Done:
   MyFree(outBuffer);
-  MyFree(inBuffer);
-  MyFree(filteredStream);
 
   return res;
 }
@@ -199,6 +507,11 @@ static SRes Decode(ISeqOutStream *outStream, ISeqInStream *inStream, UInt64 file
     goto Done;
   }
 
+  if (mBlockSize != 0) {
+    res = DecodeBlocks(outStream, inBuffer, inSize);
+    goto Done;
+  }
+
   for (i = 0; i < 8; i++)
     outSize64 += ((UInt64)inBuffer[LZMA_PROPS_SIZE + i]) << (i * 8);
 
@@ -309,6 +622,22 @@ int main2(int numArgs, const char *args[], char *rs)
       } else {
         return PrintError(rs, kInvalidParamValMessage);
       }
+    } else if (strcmp(args[param], "--threads") == 0) {
+      if (numArgs < (param + 2)) {
+        return PrintUserError(rs);
+      }
+      if (AsciiStringToUint64(args[++param], FALSE, &mNumThreads) != EFI_SUCCESS ||
+          mNumThreads > LZMA_MAX_THREADS) {
+        return PrintError(rs, kInvalidParamValMessage);
+      }
+    } else if (strcmp(args[param], "--block-size") == 0) {
+      if (numArgs < (param + 2)) {
+        return PrintUserError(rs);
+      }
+      if (AsciiStringToUint64(args[++param], FALSE, &mBlockSize) != EFI_SUCCESS ||
+          mBlockSize == 0 || mBlockSize > LZMA_MAX_BLOCK_SIZE_KB) {
+        return PrintError(rs, kInvalidParamValMessage);
+      }
     } else if (
                 strcmp(args[param], "-h") == 0 ||
                 strcmp(args[param], "--help") == 0
@@ -342,6 +671,22 @@ int main2(int numArgs, const char *args[], char *rs)
     return PrintUserError(rs);
   }
 
+  if ((mBlockSize != 0) && (mConType != NoConverter)) {
+    return PrintError(rs, "--f86 can not be used with --block-size");
+  }
+
+  //
+  // The multithreaded match finder produces the same stream as the single
+  // threaded one, so the output does not depend on the number of threads.
+  //
+  if (mNumThreads == 0) {
+    mNumThreads = GetNumberOfProcessors();
+    if (mNumThreads > LZMA_MAX_THREADS) {
+      mNumThreads = LZMA_MAX_THREADS;
+    }
+  }
+  props.numThreads = (mNumThreads > 1) ? 2 : 1;
+
   {
     size_t t4 = sizeof(UInt32);
     size_t t8 = sizeof(UInt64);
@@ -0,0 +1,27 @@
+@REM @file
+@REM This script will exec LzmaCompress tool with --block-size option that
+@REM splits the data in independent blocks compressed in parallel.
+@REM
+@REM Copyright (c) 2012 - 2018, Intel Corporation. All rights reserved.<BR>
+@REM Copyright (c) 2026, agent. All rights reserved.<BR>
+@REM SPDX-License-Identifier: BSD-2-Clause-Patent
+@REM
+
+@echo off
+@setlocal
+
+:Begin
+if "%1"=="" goto End
+if "%1"=="-e" (
+  set FLAG=--block-size 1024
+)
+if "%1"=="-d" (
+  set FLAG=--block-size 1024
+)
+set ARGS=%ARGS% %1
+shift
+goto Begin
+
+:End
+LzmaCompress %ARGS% %FLAG%
+@echo on
@@ -0,0 +1,225 @@
+/** @file
+  Python extension module running the section, FFS and compression tools in
+  the calling process.
+
+  GenFds runs GenSec, GenFfs and LzmaCompress once per section and module,
+  and GenFv once per FV.
+  With this module it calls them as functions, with the same arguments and
+  the same results as the tools, which saves a process creation per call:
+
+    FfsGenerator.GenSec(Args)
+    FfsGenerator.GenFfs(Args)
+    FfsGenerator.GenFv(Args)
+    FfsGenerator.LzmaCompress(Args)
+
+  take the command line of the tool without the program name, and return a
+  tuple of the exit status and of the output of the tool. The tools keep their
+  options in global variables, so these calls are serialized by the
+  interpreter lock. The tools print their messages into a temporary file given
+  to SetMessageOutput(), the standard output and error of the process are left
+  untouched.
+
+  Copyright (c) 2026, agent. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#include <EfiUtilityMsgs.h>
+#include "FfsGenerator.h"
+
+typedef int (*TOOL_MAIN) (int Argc, char *Argv[]);
+
+/**
+  Run a tool with the arguments of a Python sequence of strings.
+
+  @param[in]  ToolName  Program name passed as the first argument.
+  @param[in]  ToolMain  main() of the tool.
+  @param[in]  Args      Python arguments of the call.
+
+  @return  A tuple of the exit status of the tool and of its output as bytes,
+           or NULL with an exception set.
+
+**/
+STATIC
+PyObject*
+RunTool (
+  CHAR8      *ToolName,
+  TOOL_MAIN  ToolMain,
+  PyObject   *Args
+  )
+{
+  PyObject    *ArgList;
+  PyObject    *Sequence;
+  PyObject    *Item;
+  PyObject    *Output;
+  FILE        *OutputFile;
+  CHAR8       *Buffer;
+  long        Size;
+  CHAR8       **Argv;
+  CONST CHAR8 *Arg;
+  Py_ssize_t  Argc;
+  Py_ssize_t  Index;
+  int         Status;
+
+  if (!PyArg_ParseTuple (Args, "O", &ArgList)) {
+    return NULL;
+  }
+
+  Sequence = PySequence_Fast (ArgList, "Arguments must be a sequence of strings");
+  if (Sequence == NULL) {
+    return NULL;
+  }
+
+  //
+  // The tools may modify their arguments, give them copies.
+  //
+  Argc = PySequence_Fast_GET_SIZE (Sequence) + 1;
+  Argv = PyMem_Calloc (Argc + 1, sizeof (CHAR8 *));
+  if (Argv == NULL) {
+    Py_DECREF (Sequence);
+    return PyErr_NoMemory ();
+  }
+
+  Argv[0] = ToolName;
+  for (Index = 1; Index < Argc; Index++) {
+    Item = PySequence_Fast_GET_ITEM (Sequence, Index - 1);
+    Arg  = PyUnicode_AsUTF8 (Item);
+    if (Arg == NULL) {
+      goto Error;
+    }
+    Argv[Index] = PyMem_Malloc (strlen (Arg) + 1);
+    if (Argv[Index] == NULL) {
+      PyErr_NoMemory ();
+      goto Error;
+    }
+    strcpy (Argv[Index], Arg);
+  }
+
+  OutputFile = tmpfile ();
+  if (OutputFile == NULL) {
+    PyErr_SetFromErrno (PyExc_OSError);
+    goto Error;
+  }
+
+  ResetUtilityStatus ();
+  SetMessageOutput (OutputFile);
+  Status = ToolMain ((int)Argc, Argv);
+  SetMessageOutput (NULL);
+
+  for (Index = 1; Index < Argc; Index++) {
+    PyMem_Free (Argv[Index]);
+  }
+  PyMem_Free (Argv);
+  Py_DECREF (Sequence);
+
+  //
+  // Read back the output of the tool.
+  //
+  Output = NULL;
+  fflush (OutputFile);
+  Size = ftell (OutputFile);
+  if (Size >= 0) {
+    Buffer = PyMem_Malloc (Size + 1);
+    if (Buffer == NULL) {
+      PyErr_NoMemory ();
+    } else {
+      rewind (OutputFile);
+      Size   = (long)fread (Buffer, 1, Size, OutputFile);
+      Output = Py_BuildValue ("(iy#)", Status, Buffer, (Py_ssize_t)Size);
+      PyMem_Free (Buffer);
+    }
+  } else {
+    PyErr_SetFromErrno (PyExc_OSError);
+  }
+  fclose (OutputFile);
+
+  return Output;
+
+Error:
+  for (Index = 1; Index < Argc; Index++) {
+    PyMem_Free (Argv[Index]);
+  }
+  PyMem_Free (Argv);
+  Py_DECREF (Sequence);
+  return NULL;
+}
+
+/*
+ GenSec(args)
+*/
+STATIC
+PyObject*
+GenSec (
+  PyObject    *Self,
+  PyObject    *Args
+  )
+{
+  return RunTool ("GenSec", GenSecMain, Args);
+}
+
+/*
+ GenFfs(args)
+*/
+STATIC
+PyObject*
+GenFfs (
+  PyObject    *Self,
+  PyObject    *Args
+  )
+{
+  return RunTool ("GenFfs", GenFfsMain, Args);
+}
+
+/*
+ GenFv(args)
+*/
+STATIC
+PyObject*
+GenFv (
+  PyObject    *Self,
+  PyObject    *Args
+  )
+{
+  return RunTool ("GenFv", GenFvMain, Args);
+}
+
+/*
+ LzmaCompress(args)
+*/
+STATIC
+PyObject*
+LzmaCompress (
+  PyObject    *Self,
+  PyObject    *Args
+  )
+{
+  return RunTool ("LzmaCompress", LzmaCompressMain, Args);
+}
+
+STATIC CHAR8 GenSecDocs[] = "GenSec(args): Run GenSec with a command line, return its exit status and output\n";
+STATIC CHAR8 GenFfsDocs[] = "GenFfs(args): Run GenFfs with a command line, return its exit status and output\n";
+STATIC CHAR8 GenFvDocs[] = "GenFv(args): Run GenFv with a command line, return its exit status and output\n";
+STATIC CHAR8 LzmaCompressDocs[] = "LzmaCompress(args): Run LzmaCompress with a command line, return its exit status and output\n";
+
+STATIC PyMethodDef FfsGenerator_Funcs[] = {
+  {"GenSec", (PyCFunction)GenSec, METH_VARARGS, GenSecDocs},
+  {"GenFfs", (PyCFunction)GenFfs, METH_VARARGS, GenFfsDocs},
+  {"GenFv", (PyCFunction)GenFv, METH_VARARGS, GenFvDocs},
+  {"LzmaCompress", (PyCFunction)LzmaCompress, METH_VARARGS, LzmaCompressDocs},
+  {NULL, NULL, 0, NULL}
+};
+
+STATIC struct PyModuleDef FfsGenerator_Module = {
+  PyModuleDef_HEAD_INIT,
+  "FfsGenerator",
+  "EFI Section, FFS and Compression Tools Extension Module",
+  -1,
+  FfsGenerator_Funcs
+};
+
+PyMODINIT_FUNC
+PyInit_FfsGenerator (VOID) {
+  return PyModule_Create (&FfsGenerator_Module);
+}
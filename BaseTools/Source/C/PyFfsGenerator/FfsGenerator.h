@@ -0,0 +1,43 @@
+/** @file
+  Entry points of the tools built into the FfsGenerator extension module.
+
+  Copyright (c) 2026, agent. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef _FFS_GENERATOR_H_
+#define _FFS_GENERATOR_H_
+
+//
+// main() of GenSec, GenFfs and GenFv, see GenSecLib.c, GenFfsLib.c and
+// GenFvLib.c.
+//
+int
+GenSecMain (
+  int   Argc,
+  char  *Argv[]
+  );
+
+int
+GenFfsMain (
+  int   Argc,
+  char  *Argv[]
+  );
+
+int
+GenFvMain (
+  int   Argc,
+  char  *Argv[]
+  );
+
+//
+// LzmaCompress, see LzmaCompressLib.c.
+//
+int
+LzmaCompressMain (
+  int   Argc,
+  char  *Argv[]
+  );
+
+#endif
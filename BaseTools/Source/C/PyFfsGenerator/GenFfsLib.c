@@ -0,0 +1,18 @@
+/** @file
+  GenFfs built as a library for the FfsGenerator extension module.
+
+  The tool is compiled unchanged, only its entry point is renamed to
+  GenFfsMain(). FfsRebaseImageRead() is also defined by GenSec, so it is
+  renamed to keep the symbols of the two tools apart. Its output is printed
+  into GetMessageOutput(), see ToolOutput.h.
+
+  Copyright (c) 2026, agent. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#define main                GenFfsMain
+#define FfsRebaseImageRead  GenFfsFfsRebaseImageRead
+
+#include "ToolOutput.h"
+#include "../GenFfs/GenFfs.c"
@@ -0,0 +1,18 @@
+/** @file
+  GenFv built as a library for the FfsGenerator extension module.
+
+  The tool is compiled unchanged, only its entry point is renamed to
+  GenFvMain(). GenFvInternalLib.c is built as is, its state is reset by
+  InitializeGenFvInternalLib() each time GenFvMain() is called. The output of
+  both is printed into GetMessageOutput(), see ToolOutput.h.
+
+  Copyright (c) 2026, agent. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#define main  GenFvMain
+
+#include "ToolOutput.h"
+#include "../GenFv/GenFv.c"
+#include "../GenFv/GenFvInternalLib.c"
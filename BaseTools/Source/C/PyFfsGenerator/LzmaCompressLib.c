@@ -0,0 +1,55 @@
+/** @file
+  LzmaCompress built as a library for the FfsGenerator extension module.
+
+  Its output is printed into GetMessageOutput(), see ToolOutput.h.
+
+  Copyright (c) 2026, agent. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#define main  LzmaCompressToolMain
+
+#include "ToolOutput.h"
+#include "../LzmaCompress/LzmaCompress.c"
+
+#include "FfsGenerator.h"
+
+/**
+  Run LzmaCompress with a command line.
+
+  The options of the tool are kept in globals, they are reset to their
+  initial values before the command line is parsed. The progress messages
+  are not printed, as if -q was given.
+
+  @param[in]  Argc  Number of arguments, including the program name.
+  @param[in]  Argv  The arguments.
+
+  @retval 0      The input was compressed or decompressed.
+  @retval other  The tool failed, the error was printed.
+
+**/
+int
+LzmaCompressMain (
+  int   Argc,
+  char  *Argv[]
+  )
+{
+  char  Result[2000];
+  int   Status;
+
+  mQuietMode       = True;
+  mConType         = NoConverter;
+  mDictionarySize  = 28;
+  mCompressionMode = 2;
+  mBlockSize       = 0;
+  mNumThreads      = 0;
+
+  Result[0] = '\0';
+  Status    = main2 (Argc, (const char **)Argv, Result);
+  if (strlen (Result) > 0) {
+    puts (Result);
+  }
+
+  return Status;
+}
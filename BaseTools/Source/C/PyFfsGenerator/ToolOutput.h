@@ -0,0 +1,31 @@
+/** @file
+  Redirect the output of a tool built into the FfsGenerator extension module.
+
+  The tools print their usage, version and results with printf(), puts() or
+  fprintf() to stdout and stderr. Included before the source of a tool, this
+  file sends these prints to GetMessageOutput(), like the messages printed by
+  EfiUtilityMsgs. The extension can then capture the output of a tool without
+  redirecting the standard output and error of the process.
+
+  Copyright (c) 2026, agent. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef _TOOL_OUTPUT_H_
+#define _TOOL_OUTPUT_H_
+
+#include <stdio.h>
+#include <EfiUtilityMsgs.h>
+
+#undef stdout
+#undef stderr
+#undef printf
+#undef puts
+
+#define stdout         GetMessageOutput ()
+#define stderr         GetMessageOutput ()
+#define printf(...)    fprintf (stdout, __VA_ARGS__)
+#define puts(String)   fprintf (stdout, "%s\n", (String))
+
+#endif
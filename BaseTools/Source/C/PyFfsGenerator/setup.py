@@ -0,0 +1,87 @@
+## @file
+# package and install PyFfsGenerator extension
+#
+#  Copyright (c) 2026, agent. All rights reserved.<BR>
+#
+#  SPDX-License-Identifier: BSD-2-Clause-Patent
+#
+
+##
+# Import Modules
+#
+from setuptools import setup, Extension
+import os
+import sys
+
+if 'BASE_TOOLS_PATH' not in os.environ:
+    raise Exception("Please define BASE_TOOLS_PATH to the root of base tools tree")
+
+BaseToolsDir = os.environ['BASE_TOOLS_PATH']
+SourceDir = os.path.join(BaseToolsDir, 'Source', 'C')
+CommonDir = os.path.join(SourceDir, 'Common')
+LzmaSdkDir = os.path.join(SourceDir, 'LzmaCompress', 'Sdk', 'C')
+
+#
+# Use the ProcessorBind.h of the host, the tools cast pointers to UINTN.
+#
+if sys.platform == 'win32':
+    ArchIncludeDir = 'Ia32' if sys.maxsize <= 2**32 else 'X64'
+    Libraries = []
+else:
+    import platform
+    ArchIncludeDir = {
+        'x86_64'  : 'X64',
+        'aarch64' : 'AArch64',
+        'arm64'   : 'AArch64',
+        'riscv64' : 'RiscV64',
+        }.get(platform.machine(), 'Ia32')
+    if platform.machine().startswith('arm'):
+        ArchIncludeDir = 'Arm'
+    Libraries = ['pthread']
+
+setup(
+    name="FfsGenerator",
+    version="0.01",
+    ext_modules=[
+        Extension(
+            'FfsGenerator',
+            sources=[
+                os.path.join(CommonDir, 'BasePeCoff.c'),
+                os.path.join(CommonDir, 'CommonLib.c'),
+                os.path.join(CommonDir, 'Crc32.c'),
+                os.path.join(CommonDir, 'Decompress.c'),
+                os.path.join(CommonDir, 'EfiCompress.c'),
+                os.path.join(CommonDir, 'EfiUtilityMsgs.c'),
+                os.path.join(CommonDir, 'FvLib.c'),
+                os.path.join(CommonDir, 'MemoryFile.c'),
+                os.path.join(CommonDir, 'OsPath.c'),
+                os.path.join(CommonDir, 'ParseInf.c'),
+                os.path.join(CommonDir, 'PeCoffLoaderEx.c'),
+                os.path.join(CommonDir, 'StringFuncs.c'),
+                os.path.join(LzmaSdkDir, 'Alloc.c'),
+                os.path.join(LzmaSdkDir, 'LzFind.c'),
+                os.path.join(LzmaSdkDir, 'LzFindMt.c'),
+                os.path.join(LzmaSdkDir, 'LzmaDec.c'),
+                os.path.join(LzmaSdkDir, 'LzmaEnc.c'),
+                os.path.join(LzmaSdkDir, '7zFile.c'),
+                os.path.join(LzmaSdkDir, '7zStream.c'),
+                os.path.join(LzmaSdkDir, 'Bra86.c'),
+                os.path.join(LzmaSdkDir, 'Threads.c'),
+                'GenSecLib.c',
+                'GenFfsLib.c',
+                'GenFvLib.c',
+                'LzmaCompressLib.c',
+                'FfsGenerator.c'
+                ],
+            include_dirs=[
+                os.path.join(SourceDir, 'Include'),
+                os.path.join(SourceDir, 'Include', 'Common'),
+                os.path.join(SourceDir, 'Include', 'IndustryStandard'),
+                os.path.join(SourceDir, 'Include', ArchIncludeDir),
+                os.path.join(SourceDir, 'GenFv'),
+                CommonDir
+                ],
+            libraries=Libraries,
+            )
+        ],
+  )
@@ -196,6 +196,7 @@ class AutoGenWorkerInProcess(mp.Process):
                 workspacedir,active_p,target,toolchain,archlist
                 )
             self.Wa._SrcTimeStamp = self.data_pipe.Get("Workspace_timestamp")
+            self.Wa._ConfTimeStamp = self.data_pipe.Get("Workspace_conf_timestamp")
             GlobalData.gGlobalDefines = self.data_pipe.Get("G_defines")
             GlobalData.gCommandLineDefines = self.data_pipe.Get("CL_defines")
             os.environ._data = self.data_pipe.Get("Env_Var")
@@ -1,5 +1,5 @@
 ## @file
-# Create makefile for MS nmake and GNU make
+# Create makefile for MS nmake and GNU make, and build files for Ninja
 #
 # Copyright (c) 2007 - 2021, Intel Corporation. All rights reserved.<BR>
 # Copyright (c) 2020, ARM Limited. All rights reserved.<BR>
@@ -30,6 +30,13 @@ gIncludePattern = re.compile(r"^[ \t]*[#%]?[ \t]*include(?:[ \t]*(?:\\(?:\r\n|\r
 ## Regular expression for matching macro used in header file inclusion
 gMacroPattern = re.compile("([_A-Z][_A-Z0-9]*)[ \t]*\((.+)\)", re.UNICODE)
 
+## Regular expressions for finding macro definitions and macro references in makefile
+gMakeMacroDefinitionPattern = re.compile(r"^([A-Za-z_][\w]*)[ \t]*=(.*)$")
+gMakeMacroPattern = re.compile(r"\$(?:\(([A-Za-z_][\w]*)\)|([@<^$]))")
+
+## Regular expression for finding the dependency file generated by GCC compatible compilers
+gDepFilePattern = re.compile(r"(?:^|\s)-MF[ \t]*\"?([^\s\"]+)")
+
 gIsFileMap = {}
 
 ## pattern for include style in Edk.x code
@@ -55,9 +62,28 @@ gIncludeMacroConversion = {
 
 NMAKE_FILETYPE = "nmake"
 GMAKE_FILETYPE = "gmake"
+NINJA_FILETYPE = "ninja"
 WIN32_PLATFORM = "win32"
 POSIX_PLATFORM = "posix"
 
+## Get the type of build file from the MAKE tool of an AutoGen object
+#
+#   @param      AutoGenObject   Object of AutoGen class
+#
+#   @retval     string          NMAKE_FILETYPE, GMAKE_FILETYPE or NINJA_FILETYPE,
+#                               empty if no MAKE tool is defined
+#
+def GetBuildFileType(AutoGenObject):
+    MakePath = AutoGenObject.BuildOption.get('MAKE', {}).get('PATH')
+    if not MakePath:
+        return ""
+    elif "nmake" in MakePath:
+        return NMAKE_FILETYPE
+    elif "ninja" in MakePath:
+        return NINJA_FILETYPE
+    else:
+        return GMAKE_FILETYPE
+
 ## BuildFile class
 #
 #  This base class encapsules build file and its generation. It uses template to generate
@@ -72,7 +98,8 @@ class BuildFile(object):
     ## default file name for each type of build file
     _FILE_NAME_ = {
         NMAKE_FILETYPE :   "Makefile",
-        GMAKE_FILETYPE :   "GNUmakefile"
+        GMAKE_FILETYPE :   "GNUmakefile",
+        NINJA_FILETYPE :   "build.ninja"
     }
 
     # Get Makefile name.
@@ -100,7 +127,8 @@ class BuildFile(object):
     ## Header string for each type of build file
     _FILE_HEADER_ = {
         NMAKE_FILETYPE :   _MAKEFILE_HEADER % _FILE_NAME_[NMAKE_FILETYPE],
-        GMAKE_FILETYPE :   _MAKEFILE_HEADER % _FILE_NAME_[GMAKE_FILETYPE]
+        GMAKE_FILETYPE :   _MAKEFILE_HEADER % _FILE_NAME_[GMAKE_FILETYPE],
+        NINJA_FILETYPE :   _MAKEFILE_HEADER % _FILE_NAME_[NINJA_FILETYPE]
     }
 
     ## shell commands which can be used in build file in the form of macro
@@ -163,9 +191,56 @@ class BuildFile(object):
 
     _INCLUDE_CMD_ = {
         NMAKE_FILETYPE :   '!INCLUDE',
-        GMAKE_FILETYPE :   "include"
+        GMAKE_FILETYPE :   "include",
+        NINJA_FILETYPE :   "include"
+    }
+
+    ## commands of the build statements in Ninja files
+    #   The commands of a target run in the directory of the module makefile. A command
+    #   whose failure is ignored in makefile (prefixed with '-') is allowed to fail.
+    #
+    _NINJA_CD_TEMPLATE_ = {
+        WIN32_PLATFORM :   'cd /d %(dir)s',
+        POSIX_PLATFORM :   'cd %(dir)s'
+    }
+
+    _NINJA_IGNORE_ERROR_TEMPLATE_ = {
+        WIN32_PLATFORM :   '(%(cmd)s || cd .)',
+        POSIX_PLATFORM :   '(%(cmd)s || true)'
     }
 
+    _NINJA_SHELL_TEMPLATE_ = {
+        WIN32_PLATFORM :   'cmd.exe /s /c "%(cmd)s"',
+        POSIX_PLATFORM :   '%(cmd)s'
+    }
+
+    ## rules used by the build statements in Ninja files
+    #   run         commands without dependency file
+    #   cc          commands generating a GCC dependency file (-MMD -MF)
+    #   cc_msvc     commands printing the included files (cl /showIncludes)
+    #
+    _NINJA_RULES_ = '''\
+ninja_required_version = 1.7
+
+rule run
+  command = $cmd
+  description = $desc
+  restat = 1
+
+rule cc
+  command = $cmd
+  description = $desc
+  depfile = $depfile
+  deps = gcc
+  restat = 1
+
+rule cc_msvc
+  command = $cmd
+  description = $desc
+  deps = msvc
+  restat = 1
+'''
+
     _INC_FLAG_ = {TAB_COMPILER_MSFT : "/I", "GCC" : "-I", "INTEL" : "-I", "RVCT" : "-I", "NASM" : "-I"}
 
     ## Constructor of BuildFile
@@ -174,14 +249,7 @@ class BuildFile(object):
     #
     def __init__(self, AutoGenObject):
         self._AutoGenObject = AutoGenObject
-
-        MakePath = AutoGenObject.BuildOption.get('MAKE', {}).get('PATH')
-        if not MakePath:
-            self._FileType = ""
-        elif "nmake" in MakePath:
-            self._FileType = NMAKE_FILETYPE
-        else:
-            self._FileType = "gmake"
+        self._FileType = GetBuildFileType(AutoGenObject)
 
         if sys.platform == "win32":
             self._Platform = WIN32_PLATFORM
@@ -227,6 +295,40 @@ class BuildFile(object):
     def GetRemoveDirectoryCommand(self, DirList):
         return [self._RD_TEMPLATE_[self._Platform] % {'dir':Dir} for Dir in DirList]
 
+    ## Escape a path for the build statements of Ninja files
+    #
+    #   @param      Path        The path of a file
+    #
+    #   @retval     string      The escaped path
+    #
+    @staticmethod
+    def NinjaPath(Path):
+        return Path.replace('$', '$$').replace(' ', '$ ').replace(':', '$:')
+
+    ## Return the command of a build statement in Ninja file
+    #
+    #   @param      CommandList     The list of commands of the target, in makefile syntax
+    #   @param      WorkingDir      The directory the commands run in
+    #
+    #   @retval     string          The command, with '$' escaped
+    #
+    def GetNinjaCommand(self, CommandList, WorkingDir):
+        NinjaCommandList = [self._NINJA_CD_TEMPLATE_[self._Platform] % {'dir':WorkingDir}]
+        for Command in CommandList:
+            Command = Command.strip()
+            IgnoreError = False
+            while Command[:1] in ('@', '-'):
+                if Command[0] == '-':
+                    IgnoreError = True
+                Command = Command[1:].lstrip()
+            if not Command:
+                continue
+            if IgnoreError:
+                Command = self._NINJA_IGNORE_ERROR_TEMPLATE_[self._Platform] % {'cmd':Command}
+            NinjaCommandList.append(Command)
+        Command = self._NINJA_SHELL_TEMPLATE_[self._Platform] % {'cmd':' && '.join(NinjaCommandList)}
+        return Command.replace('$', '$$')
+
     def PlaceMacro(self, Path, MacroDefinitions=None):
         if Path.startswith("$("):
             return Path
@@ -471,6 +573,7 @@ cleanlib:
         self.MacroList = ['FFS_OUTPUT_DIR', 'MODULE_GUID', 'OUTPUT_DIR']
         self.FfsOutputFileList = []
         self.DependencyHeaderFileSet = set()
+        self.FileDependencyDict = {}
 
     # Compose a dict object containing information used to do replacement in template
     @property
@@ -735,8 +838,7 @@ cleanlib:
                     if Dst not in self.ResultFileList:
                         self.ResultFileList.append(Dst)
                     if '%s :' %(Dst) not in self.BuildTargetList:
-                        self.BuildTargetList.append("%s : %s" %(Dst,Src))
-                        self.BuildTargetList.append('\t' + self._CP_TEMPLATE_[self._Platform] %{'Src': Src, 'Dst': Dst})
+                        self.AddFfsTarget(Dst, Src, self._CP_TEMPLATE_[self._Platform] %{'Src': Src, 'Dst': Dst})
 
             FfsCmdList = Cmd[0]
             for index, Str in enumerate(FfsCmdList):
@@ -753,17 +855,25 @@ cleanlib:
             OutputFile = self.ReplaceMacro(OutputFile)
             self.ResultFileList.append(OutputFile)
             DepsFileString = self.ReplaceMacro(DepsFileString)
-            self.BuildTargetList.append('%s : %s' % (OutputFile, DepsFileString))
             CmdString = ' '.join(FfsCmdList).strip()
             CmdString = self.ReplaceMacro(CmdString)
-            self.BuildTargetList.append('\t%s' % CmdString)
+            self.AddFfsTarget(OutputFile, DepsFileString, CmdString)
 
             self.ParseSecCmd(DepsFileList, Cmd[1])
             for SecOutputFile, SecDepsFile, SecCmd in self.FfsOutputFileList :
-                self.BuildTargetList.append('%s : %s' % (self.ReplaceMacro(SecOutputFile), self.ReplaceMacro(SecDepsFile)))
-                self.BuildTargetList.append('\t%s' % self.ReplaceMacro(SecCmd))
+                self.AddFfsTarget(self.ReplaceMacro(SecOutputFile), self.ReplaceMacro(SecDepsFile), self.ReplaceMacro(SecCmd))
             self.FfsOutputFileList = []
 
+    ## Add the target of a file generated by the FFS commands
+    #
+    #   @param      Target      The generated file
+    #   @param      Dependency  The files the target depends on
+    #   @param      Command     The command generating the file
+    #
+    def AddFfsTarget(self, Target, Dependency, Command):
+        self.BuildTargetList.append('%s : %s' % (Target, Dependency))
+        self.BuildTargetList.append('\t%s' % Command)
+
     def ParseSecCmd(self, OutputFileList, CmdTuple):
         for OutputFile in OutputFileList:
             for SecCmdStr in CmdTuple:
@@ -927,6 +1037,7 @@ cleanlib:
                     SourceFileList.remove(Item)
 
         FileDependencyDict = {item:ForceIncludedFile for item in SourceFileList}
+        self.FileDependencyDict = FileDependencyDict
 
         for Dependency in FileDependencyDict.values():
             self.DependencyHeaderFileSet.update(set(Dependency))
@@ -1159,6 +1270,245 @@ cleanlib:
         return Dependency
 
 
+## ModuleNinjaFile class
+#
+#  This class encapsules the Ninja files of a module and their generation. The build
+#  statements are converted from the targets of the module makefile, with all makefile
+#  macros expanded. The included header files are tracked by Ninja with the dependency
+#  files of the compiler, instead of the dependency files included by the makefile.
+#
+#  The build statements are saved in module.ninja. It is included by the build.ninja
+#  of the module, which builds the module only, and by the build.ninja of the platform,
+#  which builds all modules in one build graph.
+#
+class ModuleNinjaFile(ModuleMakefile):
+    _MODULE_FILE_NAME_ = "module.ninja"
+
+    ## template used to generate the build statements of the module
+    _MODULE_TEMPLATE_ = TemplateString('''\
+${makefile_header}
+${BEGIN}${build_statement}
+${END}
+build ${module_target}: phony${BEGIN} $
+    ${result_file}${END}
+''')
+
+    ## template used to generate the build.ninja of the module
+    _TEMPLATE_ = TemplateString('''\
+${makefile_header}
+${ninja_rules}
+builddir = ${module_build_directory}
+
+subninja ${module_ninja_file}
+
+#
+# Libraries are built by their own build.ninja, before the module
+#
+build all: phony ${module_target}
+build mbuild: phony ${module_target}
+build pbuild: phony ${module_target}
+build tbuild: phony ${module_target}
+
+build clean: run
+  cmd = ${clean_command}
+  desc = clean ${module_name}
+
+build cleanall: run
+  cmd = ${cleanall_command}
+  desc = cleanall ${module_name}
+
+build cleanlib: run
+  cmd = ${cleanlib_command}
+  desc = cleanlib ${module_name}
+
+default all
+''')
+
+    _STATEMENT_TEMPLATE = TemplateString('''\
+build ${output}: ${rule}${BEGIN} ${input}${END}${BEGIN} | ${dependency}${END}
+  cmd = ${command}
+  desc = ${description}${BEGIN}
+  depfile = ${depfile}${END}
+''')
+
+    ## Constructor of ModuleNinjaFile
+    #
+    #   @param  ModuleAutoGen   Object of ModuleAutoGen class
+    #
+    def __init__(self, ModuleAutoGen):
+        ModuleMakefile.__init__(self, ModuleAutoGen)
+        self.MacroDefinitions = {}
+        self.NinjaTargetList = []       # [(outputs, inputs, dependencies, commands)]
+
+    ## Return the phony target of a module, which depends on the result files of the module
+    @staticmethod
+    def GetModuleTarget(ModuleAutoGen):
+        return os.path.join(ModuleAutoGen.MakeFileDir, "tbuild")
+
+    ## Return the path of the build statements of a module
+    @staticmethod
+    def GetModuleNinjaFile(ModuleAutoGen):
+        return os.path.join(ModuleAutoGen.MakeFileDir, ModuleNinjaFile._MODULE_FILE_NAME_)
+
+    ## Ninja runs the compiler once per source file, don't merge the commands like nmake
+    def ParserCCodeFile(self, T, Type, CmdSumDict, CmdTargetDict, CmdCppDict, DependencyDict, RespFile, ToolsDef,
+                            resp_file_number):
+        return T, CmdSumDict, CmdTargetDict, CmdCppDict
+
+    def AddFfsTarget(self, Target, Dependency, Command):
+        self.NinjaTargetList.append(([Target], [], [Dependency], [Command]))
+
+    ## Get the macros defined in makefile
+    #
+    #   @param      Content     The content of makefile
+    #
+    #   @retval     dict        The macro definitions
+    #
+    def GetMacroDefinitions(self, Content):
+        MacroDefinitions = {}
+        for Line in Content.replace('\\\n', ' ').splitlines():
+            Match = gMakeMacroDefinitionPattern.match(Line)
+            if Match:
+                MacroDefinitions[Match.group(1)] = Match.group(2).strip()
+        return MacroDefinitions
+
+    ## Expand the makefile macros in a string
+    #
+    #   Like make, the macros not defined in makefile are taken from environment.
+    #
+    #   @param      String      The string to expand
+    #   @param      Target      The target of the rule, for $@
+    #   @param      Inputs      The inputs of the rule, for $< and $^
+    #
+    #   @retval     string      The expanded string
+    #
+    def ExpandMacro(self, String, Target='', Inputs=None, Depth=0):
+        if Depth > 32:
+            EdkLogger.error("build", AUTOGEN_ERROR, "Recursive makefile macro in %s" % String,
+                            ExtraData="[%s]" % str(self._AutoGenObject))
+        if Inputs is None:
+            Inputs = []
+        def Replace(Match):
+            Name, Auto = Match.groups()
+            if Name:
+                if Name in self.MacroDefinitions:
+                    return self.ExpandMacro(self.MacroDefinitions[Name], Target, Inputs, Depth + 1)
+                return os.environ.get(Name, '')
+            if Auto == '@':
+                return Target
+            if Auto == '<':
+                return Inputs[0] if Inputs else ''
+            if Auto == '^':
+                return ' '.join(Inputs)
+            return '$'
+        return gMakeMacroPattern.sub(Replace, str(String))
+
+    ## Expand the makefile macros in a list of files
+    def ExpandFileList(self, FileList):
+        ExpandedList = []
+        for File in FileList:
+            for Item in self.ExpandMacro(File).split():
+                if Item not in ExpandedList:
+                    ExpandedList.append(Item)
+        return ExpandedList
+
+    ## Convert the targets of the module to build statements
+    #
+    #   @retval     list        The build statements
+    #
+    def GetBuildStatementList(self):
+        MyAgo = self._AutoGenObject
+        TargetList = []
+        for Type in MyAgo.Targets:
+            for T in MyAgo.Targets[Type]:
+                Dependencies = [str(Dep) for Dep in T.Dependencies if Dep != '$(MAKE_FILE)']
+                if len(T.Inputs) == 1 and T.Inputs[0] in self.FileDependencyDict:
+                    Dependencies.extend(str(F) for F in self.FileDependencyDict[T.Inputs[0]])
+                TargetList.append(([str(O) for O in T.Outputs], [str(I) for I in T.Inputs], Dependencies, T.Commands))
+        TargetList.extend(self.NinjaTargetList)
+
+        StatementList = []
+        OutputSet = set()
+        for Outputs, Inputs, Dependencies, Commands in TargetList:
+            Outputs = self.ExpandFileList(Outputs)
+            if not Commands or not Outputs or Outputs[0] in OutputSet:
+                continue
+            OutputSet.update(Outputs)
+            Inputs = self.ExpandFileList(Inputs)
+            Dependencies = [D for D in self.ExpandFileList(Dependencies) if D not in Inputs and D not in Outputs]
+            Commands = [self.ExpandMacro(Cmd, Outputs[0], Inputs) for Cmd in Commands]
+
+            Rule = 'run'
+            DepFile = []
+            if MyAgo.ToolChainFamily == TAB_COMPILER_MSFT:
+                if [Cmd for Cmd in Commands if '/showIncludes' in Cmd]:
+                    Rule = 'cc_msvc'
+            else:
+                for Cmd in Commands:
+                    Match = gDepFilePattern.search(Cmd)
+                    if Match:
+                        Rule = 'cc'
+                        DepFile = [Match.group(1).replace('$', '$$')]
+                        break
+
+            StatementList.append(self._STATEMENT_TEMPLATE.Replace({
+                "output"        : ' '.join(self.NinjaPath(O) for O in Outputs),
+                "rule"          : Rule,
+                "input"         : [self.NinjaPath(I) for I in Inputs],
+                "dependency"    : [' '.join(self.NinjaPath(D) for D in Dependencies)] if Dependencies else [],
+                "command"       : self.GetNinjaCommand(Commands, MyAgo.MakeFileDir),
+                "description"   : "%s [%s] %s" % (MyAgo.Name, MyAgo.Arch, os.path.basename(Outputs[0])),
+                "depfile"       : DepFile
+                }))
+        return StatementList
+
+    ## Create the Ninja files of the module.
+    #
+    #  @retval TRUE     The files are created or re-created successfully.
+    #  @retval FALSE    The files exist and are the same as the ones to be generated.
+    #
+    def Generate(self):
+        MyAgo = self._AutoGenObject
+        self.MacroDefinitions = self.GetMacroDefinitions(ModuleMakefile._TEMPLATE_.Replace(self._TemplateDict))
+        ModuleTarget = self.NinjaPath(self.GetModuleTarget(MyAgo))
+        ResultFileList = [self.NinjaPath(F) for F in self.ExpandFileList(self.ResultFileList)]
+
+        ModuleContent = self._MODULE_TEMPLATE_.Replace({
+            "makefile_header"   : self._FILE_HEADER_[self._FileType],
+            "build_statement"   : self.GetBuildStatementList(),
+            "module_target"     : ModuleTarget,
+            "result_file"       : ResultFileList
+            })
+
+        CleanCommandList = ['-' + Cmd for Cmd in self.GetRemoveDirectoryCommand(["$(OUTPUT_DIR)"])]
+        CleanCommandList.append("-$(RM) AutoGenTimeStamp")
+        CleanallCommandList = ['-' + Cmd for Cmd in self.GetRemoveDirectoryCommand(["$(DEBUG_DIR)", "$(OUTPUT_DIR)"])]
+        CleanallCommandList.append("-$(RM) $(BIN_DIR)%s$(MODULE_NAME).efi" % self._SEP_[self._Platform])
+        CleanallCommandList.append("-$(RM) AutoGenTimeStamp")
+        CleanlibCommandList = ['-"%s" -f %s cleanall' % (MyAgo.BuildOption['MAKE']['PATH'], os.path.join(D, self.getMakefileName()))
+                               for D in self.LibraryBuildDirectoryList]
+
+        Content = self._TEMPLATE_.Replace({
+            "makefile_header"       : self._FILE_HEADER_[self._FileType],
+            "ninja_rules"           : self._NINJA_RULES_,
+            "module_name"           : MyAgo.Name,
+            "module_build_directory": MyAgo.MakeFileDir.replace('$', '$$'),
+            "module_ninja_file"     : self.NinjaPath(self.GetModuleNinjaFile(MyAgo)),
+            "module_target"         : ModuleTarget,
+            "clean_command"         : self.GetNinjaCommand([self.ExpandMacro(Cmd) for Cmd in CleanCommandList], MyAgo.MakeFileDir),
+            "cleanall_command"      : self.GetNinjaCommand([self.ExpandMacro(Cmd) for Cmd in CleanallCommandList], MyAgo.MakeFileDir),
+            "cleanlib_command"      : self.GetNinjaCommand([self.ExpandMacro(Cmd) for Cmd in CleanlibCommandList], MyAgo.MakeFileDir),
+            })
+
+        DepsFile = os.path.join(MyAgo.MakeFileDir, "deps.txt")
+        if not os.path.exists(DepsFile):
+            SaveFileOnChange(DepsFile, "", False)
+        Changed = SaveFileOnChange(self.GetModuleNinjaFile(MyAgo), ModuleContent, False)
+        if SaveFileOnChange(os.path.join(MyAgo.MakeFileDir, self.getMakefileName()), Content, False):
+            Changed = True
+        return Changed
+
+
 ## CustomMakefile class
 #
 #  This class encapsules makefie and its generation for module. It uses template to generate
@@ -1545,6 +1895,63 @@ cleanlib:
                 DirList.append(os.path.join(self._AutoGenObject.BuildDir, LibraryAutoGen.BuildDir))
         return DirList
 
+## PlatformNinjaFile class
+#
+#  This class encapsules the build.ninja of a platform and its generation. It includes
+#  the build statements of the given modules and their libraries, of all architectures,
+#  so that Ninja builds them in one build graph instead of running one build per module.
+#
+class PlatformNinjaFile(BuildFile):
+    ## template used to generate the build.ninja of the platform
+    _TEMPLATE_ = TemplateString('''\
+${makefile_header}
+${ninja_rules}
+builddir = ${platform_build_directory}
+
+${BEGIN}subninja ${module_ninja_file}
+${END}
+build all: phony${BEGIN} $
+    ${module_target}${END}
+
+default all
+''')
+
+    ## Constructor of PlatformNinjaFile
+    #
+    #   @param  PlatformAutoGen     Object of PlatformAutoGen class
+    #   @param  ModuleList          The ModuleAutoGen objects of the modules to build
+    #
+    def __init__(self, PlatformAutoGen, ModuleList):
+        BuildFile.__init__(self, PlatformAutoGen)
+        self._FileType = NINJA_FILETYPE
+        self.ModuleList = ModuleList
+
+    # Compose a dict object containing information used to do replacement in template
+    @property
+    def _TemplateDict(self):
+        ModuleDict = OrderedDict()
+        for Module in sorted(self.ModuleList, key=lambda Ma: Ma.MakeFileDir):
+            for Ma in [Module] + Module.LibraryAutoGenList:
+                if not Ma.IsBinaryModule and Ma.MakeFileDir not in ModuleDict:
+                    ModuleDict[Ma.MakeFileDir] = Ma
+
+        return {
+            "makefile_header"           : self._FILE_HEADER_[self._FileType],
+            "ninja_rules"               : self._NINJA_RULES_,
+            "platform_build_directory"  : self._AutoGenObject.BuildDir.replace('$', '$$'),
+            "module_ninja_file"         : [self.NinjaPath(ModuleNinjaFile.GetModuleNinjaFile(Ma)) for Ma in ModuleDict.values()],
+            "module_target"             : [self.NinjaPath(ModuleNinjaFile.GetModuleTarget(Ma)) for Ma in ModuleDict.values()],
+        }
+
+    ## Return the path of the build.ninja of the platform
+    @property
+    def FilePath(self):
+        return os.path.join(self._AutoGenObject.BuildDir, self.getMakefileName())
+
+    ## Create the build.ninja of the platform in the build directory, shared by all architectures
+    def Generate(self):
+        return SaveFileOnChange(self.FilePath, self._TEMPLATE_.Replace(self._TemplateDict), False)
+
 ## TopLevelMakefile class
 #
 #  This class encapsules makefie and its generation for entrance makefile. It
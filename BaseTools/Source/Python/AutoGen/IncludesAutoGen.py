@@ -228,6 +228,19 @@ ${END}
                 dep_file_name = os.path.basename(source_abs) + ".deps"
                 SaveFileOnChange(os.path.join(os.path.dirname(target_abs),dep_file_name)," \\\n".join([target_abs+":"] + ['''"''' + item +'''"''' for item in ModuleDepDict[source_abs]]),False)
 
+    def CreateDepsFileFromNinja(self, NinjaDeps):
+        """ Generate dependency files, .deps file from the /showIncludes output Ninja keeps in its log
+            NinjaDeps maps the normalized path of each target to its included files.
+        """
+        for target, source in self.TargetFileList.values():
+            includes = NinjaDeps.get(os.path.normcase(os.path.normpath(target.Path)))
+            if not includes:
+                continue
+            source_abs = source.Path
+            target_abs = self.GetRealTarget(source_abs)
+            dep_file_name = os.path.basename(source_abs) + ".deps"
+            SaveFileOnChange(os.path.join(os.path.dirname(target_abs),dep_file_name)," \\\n".join([target_abs+":"] + ['''"''' + item +'''"''' for item in includes]),False)
+
     def UpdateDepsFileforNonMsvc(self):
         """ Update .deps files.
             1. Update target path to absolute path.
@@ -1756,9 +1756,13 @@ class ModuleAutoGen(AutoGen):
             for f in self.AutoGenDepSet:
                 FileSet.add (f.Path)
 
+            for f in self.AutoGenFileList:
+                FileSet.add (f.Path)
+
             if os.path.exists (self.TimeStampPath):
                 os.remove (self.TimeStampPath)
 
+            SaveFileOnChange(self.AutoGenInputsPath, self.AutoGenInputs, False)
             SaveFileOnChange(self.TimeStampPath, "\n".join(FileSet), False)
 
         # Ignore generating makefile when it is a binary module
@@ -1771,12 +1775,15 @@ class ModuleAutoGen(AutoGen):
             for LibraryAutoGen in self.LibraryAutoGenList:
                 LibraryAutoGen.CreateMakeFile()
 
-        # CanSkip uses timestamps to determine build skipping
+        # CanSkip uses timestamps and the AutoGen inputs to determine build skipping
         if self.CanSkip():
             return
 
         if len(self.CustomMakefile) == 0:
-            Makefile = GenMake.ModuleMakefile(self)
+            if GenMake.GetBuildFileType(self) == GenMake.NINJA_FILETYPE:
+                Makefile = GenMake.ModuleNinjaFile(self)
+            else:
+                Makefile = GenMake.ModuleMakefile(self)
         else:
             Makefile = GenMake.CustomMakefile(self)
         if Makefile.Generate():
@@ -1826,11 +1833,13 @@ class ModuleAutoGen(AutoGen):
         AutoGenList = []
         IgoredAutoGenList = []
 
-        for File in self.AutoGenFileList:
-            if GenC.Generate(File.Path, self.AutoGenFileList[File], File.IsBinary):
-                AutoGenList.append(str(File))
-            else:
-                IgoredAutoGenList.append(str(File))
+        # The AutoGen files are up to date if the makefile doesn't need to be regenerated
+        if not self.CanSkip():
+            for File in self.AutoGenFileList:
+                if GenC.Generate(File.Path, self.AutoGenFileList[File], File.IsBinary):
+                    AutoGenList.append(str(File))
+                else:
+                    IgoredAutoGenList.append(str(File))
 
 
         for ModuleType in self.DepexList:
@@ -2435,8 +2444,8 @@ class ModuleAutoGen(AutoGen):
         #last creation time of the module
         DstTimeStamp = os.stat(self.TimeStampPath)[8]
 
-        SrcTimeStamp = self.Workspace._SrcTimeStamp
-        if SrcTimeStamp > DstTimeStamp:
+        ConfTimeStamp = self.Workspace._ConfTimeStamp
+        if ConfTimeStamp > DstTimeStamp:
             return False
 
         with open(self.TimeStampPath,'r') as f:
@@ -2448,9 +2457,74 @@ class ModuleAutoGen(AutoGen):
                     ModuleAutoGen.TimeDict[source] = os.stat(source)[8]
                 if ModuleAutoGen.TimeDict[source] > DstTimeStamp:
                     return False
+
+        #
+        # A change in the DSC, FDF or DEC files only matters if it changed the
+        # settings the module consumes. The PCD database of the PCD driver
+        # depends on all the dynamic PCDs of the platform.
+        #
+        SrcTimeStamp = self.Workspace._SrcTimeStamp
+        if SrcTimeStamp > DstTimeStamp:
+            if self.PcdIsDriver or not os.path.exists(self.AutoGenInputsPath):
+                return False
+            with open(self.AutoGenInputsPath, 'r') as f:
+                if f.read() != self.AutoGenInputs:
+                    EdkLogger.debug(EdkLogger.DEBUG_9, "AutoGen inputs of module %s [%s] changed" % (self.Name, self.Arch))
+                    return False
+            os.utime(self.TimeStampPath, None)
         GlobalData.gSikpAutoGenCache.add(self.MakeFileDir)
         return True
 
     @cached_property
     def TimeStampPath(self):
         return os.path.join(self.MakeFileDir, 'AutoGenTimeStamp')
+
+    @cached_property
+    def AutoGenInputsPath(self):
+        return os.path.join(self.MakeFileDir, 'AutoGenInputs')
+
+    ## Return the platform settings consumed by the AutoGen files and makefile
+    #
+    #   One line per PCD, library instance, build option, GUID, include path
+    #   and FFS command the module gets from the DSC, FDF and DEC files. The
+    #   lines are saved with the makefile, so a change in these files only
+    #   regenerates the modules whose lines changed.
+    #
+    #   @retval     str         The AutoGen inputs of the module
+    #
+    @cached_property
+    def AutoGenInputs(self):
+        Platform = self.PlatformInfo
+        RetVal = [
+            'PLATFORM %s %s %s %s' % (Platform.Name, Platform.Guid, Platform.Version, Platform.OutputDir),
+            'LANGUAGES %s %s' % (Platform.Platform.RFCLanguages, Platform.Platform.ISOLanguages),
+            'SKU %s' % Platform.Platform.SkuIdMgr.DumpSkuIdArrary(),
+            'MODULE %s %s %s' % (self.UniqueBaseName, self.Guid, self.Version),
+            'REFERENCED %s' % bool(self.ReferenceModules)
+            ]
+        for Library in self.DependentLibraryList:
+            RetVal.append('LIBRARY %s' % Library.MetaFile.Path)
+        for Pcd in self.ModulePcdList + self.LibraryPcdList:
+            TokenNumber = Platform.PcdTokenNumber.get((Pcd.TokenCName, Pcd.TokenSpaceGuidCName), '')
+            # The value of a dynamic PCD is only used by the PCD database
+            if Pcd.Type in PCD_DYNAMIC_TYPE_SET | PCD_DYNAMIC_EX_TYPE_SET:
+                Value = ''
+            else:
+                Value = ' '.join(str(Item) for Item in (Pcd.DefaultValue, Pcd.PcdValueFromComm, Pcd.PcdValueFromFdf))
+            RetVal.append('PCD %s.%s %s %s %s %s %s %s %s' % (Pcd.TokenSpaceGuidCName, Pcd.TokenCName, Pcd.TokenSpaceGuidValue,
+                                                              Pcd.Type, Pcd.DatumType, Pcd.MaxDatumSize, Pcd.TokenValue,
+                                                              TokenNumber, Value))
+        for Key in sorted(self.ConstPcd):
+            RetVal.append('CONST_PCD %s %s' % (Key, self.ConstPcd[Key]))
+        for GuidList in (self.GuidList, self.ProtocolList, self.PpiList):
+            for Name in GuidList:
+                RetVal.append('GUID %s %s' % (Name, GuidList[Name]))
+        for Tool in sorted(self.BuildOption):
+            for Attr in sorted(self.BuildOption[Tool]):
+                RetVal.append('OPTION %s_%s %s' % (Tool, Attr, self.BuildOption[Tool][Attr]))
+        RetVal.append('BUILD_RULE_ORDER %s' % self.BuildRuleOrder)
+        for Inc in self.IncludePathList:
+            RetVal.append('INCLUDE %s' % Inc)
+        for Cmd in (GlobalData.FfsCmd or {}).get((self.MetaFile.Path, self.Arch), []):
+            RetVal.append('FFS %s' % str(Cmd))
+        return '\n'.join(RetVal)
@@ -258,6 +258,7 @@ class WorkSpaceInfo(AutoGenInfo):
             self._Init = True
     def do_init(self,Workspace, MetaFile, Target, ToolChain, Arch):
         self._SrcTimeStamp = 0
+        self._ConfTimeStamp = 0
         self.Db = BuildDB
         self.BuildDatabase = self.Db.BuildObject
         self.Target = Target
@@ -815,7 +815,8 @@ class PlatformAutoGen(AutoGen):
             RetVal = _SplitOption(self.ToolDefinition["MAKE"]["PATH"])
         else:
             return []
-        if "MAKE" in self.ToolDefinition and "FLAGS" in self.ToolDefinition["MAKE"]:
+        # The MAKE_FLAGS of tools_def.txt are the ones of make or nmake, Ninja doesn't accept them
+        if "MAKE" in self.ToolDefinition and "FLAGS" in self.ToolDefinition["MAKE"] and "ninja" not in RetVal[0]:
             NewOption = self.ToolDefinition["MAKE"]["FLAGS"].strip()
             if NewOption != '':
                 RetVal += _SplitOption(NewOption)
@@ -567,6 +567,16 @@ class WorkspaceAutoGen(AutoGen):
             if os.stat(f)[8] > SrcTimeStamp:
                 SrcTimeStamp = os.stat(f)[8]
         self._SrcTimeStamp = SrcTimeStamp
+        #
+        # Retrieve latest modified time of the conf files. They change the makefiles of all
+        # modules, while the other metafiles only change the modules consuming the PCDs,
+        # library instances and build options they modify.
+        #
+        ConfTimeStamp = 0
+        for f in self._GetConfFiles():
+            if os.stat(f)[8] > ConfTimeStamp:
+                ConfTimeStamp = os.stat(f)[8]
+        self._ConfTimeStamp = ConfTimeStamp
 
         if GlobalData.gUseHashCache:
             FileList = []
@@ -658,6 +668,19 @@ class WorkspaceAutoGen(AutoGen):
             CopyFileOnChange(HashFile, CacheFileDir)
             CopyFileOnChange(HashChainFile, CacheFileDir)
 
+    def _GetConfFiles(self):
+        ConfFiles = set()
+        #
+        # add build_rule.txt & tools_def.txt
+        #
+        ConfFiles.add(os.path.join(GlobalData.gConfDirectory, gDefaultBuildRuleFile))
+        ConfFiles.add(os.path.join(GlobalData.gConfDirectory, gDefaultToolsDefFile))
+
+        for Pa in self.AutoGenObjectList:
+            ConfFiles.add(Pa.ToolDefinitionFile)
+
+        return ConfFiles
+
     def _GetMetaFiles(self, Target, Toolchain):
         AllWorkSpaceMetaFiles = set()
         #
@@ -673,10 +696,9 @@ class WorkspaceAutoGen(AutoGen):
         AllWorkSpaceMetaFiles.add(self.MetaFile.Path)
 
         #
-        # add build_rule.txt & tools_def.txt
+        # add build_rule.txt, tools_def.txt & the tool definition files
         #
-        AllWorkSpaceMetaFiles.add(os.path.join(GlobalData.gConfDirectory, gDefaultBuildRuleFile))
-        AllWorkSpaceMetaFiles.add(os.path.join(GlobalData.gConfDirectory, gDefaultToolsDefFile))
+        AllWorkSpaceMetaFiles.update(self._GetConfFiles())
 
         # add BuildOption metafile
         #
@@ -686,9 +708,6 @@ class WorkspaceAutoGen(AutoGen):
         #
         AllWorkSpaceMetaFiles.add(os.path.join(self.BuildDir, 'PcdTokenNumber'))
 
-        for Pa in self.AutoGenObjectList:
-            AllWorkSpaceMetaFiles.add(Pa.ToolDefinitionFile)
-
         for Arch in self.ArchList:
             #
             # add dec
@@ -118,6 +118,8 @@ gModuleAllCacheStatus = None
 gModuleCacheHit = None
 
 gEnableGenfdsMultiThread = True
+# FFS commands of the modules in the FDF file, added to their makefiles
+FfsCmd = {}
 gSikpAutoGenCache = set()
 # Common lock for the file access in multiple process AutoGens
 file_lock = None
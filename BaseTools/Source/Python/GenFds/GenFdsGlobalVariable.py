@@ -14,6 +14,7 @@ from __future__ import absolute_import
 
 import Common.LongFilePathOs as os
 import sys
+import shlex
 from sys import stdout
 from subprocess import PIPE,Popen
 from struct import Struct
@@ -34,6 +35,16 @@ import Common.GlobalData as GlobalData
 from Common.BuildToolError import *
 from AutoGen.AutoGen import CalculatePriorityValue
 
+#
+# GenSec, GenFfs and LzmaCompress built as a Python extension, see
+# BaseTools/Source/C/PyFfsGenerator. When it is available the tools are run
+# in this process instead of being spawned once per section and FFS file.
+#
+try:
+    import FfsGenerator
+except ImportError:
+    FfsGenerator = None
+
 ## Global variables
 #
 #
@@ -722,26 +733,105 @@ class GenFdsGlobalVariable:
             if GenFdsGlobalVariable.SharpCounter % GenFdsGlobalVariable.SharpNumberPerLine == 0:
                 stdout.write('\n')
 
-        try:
-            PopenObject = Popen(' '.join(cmd), stdout=PIPE, stderr=PIPE, shell=True)
-        except Exception as X:
-            EdkLogger.error("GenFds", COMMAND_FAILURE, ExtraData="%s: %s" % (str(X), cmd[0]))
-        (out, error) = PopenObject.communicate()
-
-        while PopenObject.returncode is None:
-            PopenObject.wait()
+        InProcessTool = GenFdsGlobalVariable.GetInProcessTool(cmd[0])
+        if InProcessTool is not None:
+            (ReturnCode, out, error) = GenFdsGlobalVariable.RunInProcessTool(InProcessTool, GenFdsGlobalVariable.SplitToolArguments(cmd[1:]))
+        else:
+            try:
+                PopenObject = Popen(' '.join(cmd), stdout=PIPE, stderr=PIPE, shell=True)
+            except Exception as X:
+                EdkLogger.error("GenFds", COMMAND_FAILURE, ExtraData="%s: %s" % (str(X), cmd[0]))
+            (out, error) = PopenObject.communicate()
+
+            while PopenObject.returncode is None:
+                PopenObject.wait()
+            ReturnCode = PopenObject.returncode
         if returnValue != [] and returnValue[0] != 0:
             #get command return value
-            returnValue[0] = PopenObject.returncode
+            returnValue[0] = ReturnCode
             return
-        if PopenObject.returncode != 0 or GenFdsGlobalVariable.VerboseMode or GenFdsGlobalVariable.DebugLevel != -1:
-            GenFdsGlobalVariable.InfLogger ("Return Value = %d" % PopenObject.returncode)
+        if ReturnCode != 0 or GenFdsGlobalVariable.VerboseMode or GenFdsGlobalVariable.DebugLevel != -1:
+            GenFdsGlobalVariable.InfLogger ("Return Value = %d" % ReturnCode)
             GenFdsGlobalVariable.InfLogger(out.decode(encoding='utf-8', errors='ignore'))
             GenFdsGlobalVariable.InfLogger(error.decode(encoding='utf-8', errors='ignore'))
-            if PopenObject.returncode != 0:
+            if ReturnCode != 0:
                 print("###", cmd)
                 EdkLogger.error("GenFds", COMMAND_FAILURE, errorMess)
 
+    ## GetInProcessTool()
+    #
+    #   @param  ToolPath      The tool of the command line
+    #
+    #   @retval Function      The function running the tool in this process
+    #   @retval None          The tool must be spawned
+    #
+    @staticmethod
+    def GetInProcessTool (ToolPath):
+        #
+        # A tool given with a path is a specific binary, always run it.
+        #
+        if FfsGenerator is None or os.path.dirname(ToolPath):
+            return None
+
+        #
+        # LzmaF86Compress and LzmaParallelCompress are scripts adding an
+        # option to LzmaCompress when it encodes or decodes.
+        #
+        # GuidSection first tries the -z option of the GUIDed tools. Like the
+        # spawned tool, LzmaCompress takes -z for its input file, rejects the
+        # second input file and returns 1. CallExternalTool then drops its
+        # output and GuidSection runs it again without -z.
+        #
+        def LzmaWrapper (Options=[]):
+            def RunLzmaCompress (Args):
+                if '-e' in Args or '-d' in Args:
+                    Args = Args + Options
+                return FfsGenerator.LzmaCompress(Args)
+            return RunLzmaCompress
+
+        return {
+            'GenSec'               : FfsGenerator.GenSec,
+            'GenFfs'               : FfsGenerator.GenFfs,
+            'GenFv'                : FfsGenerator.GenFv,
+            'LzmaCompress'         : LzmaWrapper(),
+            'LzmaF86Compress'      : LzmaWrapper(['--f86']),
+            'LzmaParallelCompress' : LzmaWrapper(['--block-size', '1024']),
+            }.get(os.path.splitext(ToolPath)[0])
+
+    ## RunInProcessTool()
+    #
+    #   Run a tool of the FfsGenerator extension. The extension captures the
+    #   messages of the tool, they are logged like those of a spawned tool.
+    #   The tool does not write to the standard output and error of GenFds.
+    #
+    #   @param  Tool          The function running the tool
+    #   @param  Args          The arguments passed to the tool
+    #
+    #   @retval tuple         The exit status, output and (empty) error output
+    #                         of the tool
+    #
+    @staticmethod
+    def RunInProcessTool (Tool, Args):
+        (ReturnCode, Output) = Tool(Args)
+        return (ReturnCode, Output, b'')
+
+    ## SplitToolArguments()
+    #
+    #   Split the arguments of a command line the way the shell does, keeping
+    #   the backslashes of Windows paths.
+    #
+    #   @param  Args          The arguments, each one may hold several
+    #
+    #   @retval list          The arguments passed to the tool
+    #
+    @staticmethod
+    def SplitToolArguments (Args):
+        Lexer = shlex.shlex(' '.join(Args), posix=True)
+        Lexer.whitespace_split = True
+        Lexer.commenters = ''
+        Lexer.escape = ''
+        return list(Lexer)
+
     @staticmethod
     def VerboseLogger (msg):
         EdkLogger.verbose(msg)
@@ -0,0 +1,161 @@
+## @file
+# This file is used to keep the records of parsed meta files across builds
+#
+# Copyright (c) 2026, agent. All rights reserved.<BR>
+# SPDX-License-Identifier: BSD-2-Clause-Patent
+#
+
+##
+# Import Modules
+#
+from __future__ import absolute_import
+import Common.LongFilePathOs as os
+import pickle
+import tempfile
+from hashlib import md5
+
+import Common.EdkLogger as EdkLogger
+import Common.GlobalData as GlobalData
+from Common.LongFilePathSupport import OpenLongFilePath as open
+from CommonDataClass.DataClass import MODEL_FILE_INF, MODEL_FILE_DEC
+
+## Persistent cache of parsed meta files
+#
+# The records the parser stores for an INF or DEC file only depend on the
+# content of the file. They are saved in Conf/.cache/MetaFile, and loaded
+# instead of parsing the file again when a later build finds the same file.
+#
+# An entry is named after the MD5 of the file content, the file path, the
+# parser sources and the parsing context (the global macro names and the
+# --check-usage option). A changed file or a changed parser never finds a
+# stale entry, so entries are never invalidated. "build cleanall" removes
+# them with the rest of Conf/.cache.
+#
+# DSC and FDF files are always parsed: their records depend on the macros,
+# the PCDs and the files they include.
+#
+class MetaFileCache(object):
+    # Bump when the format of the entries changes
+    _VERSION_ = 1
+
+    _FILE_TYPES_ = (MODEL_FILE_INF, MODEL_FILE_DEC)
+
+    def __init__(self):
+        self._ParserDigest = None
+
+    ## Directory of the cache entries, None if the cache can't be used
+    @property
+    def _Directory(self):
+        if not os.path.isabs(GlobalData.gDatabasePath):
+            return None
+        return os.path.join(os.path.dirname(GlobalData.gDatabasePath), 'MetaFile')
+
+    ## Digest of the sources of the parser, entries of another parser are ignored
+    #
+    #   Frozen tools have no sources to hash, they don't use the cache.
+    #
+    @property
+    def _ParserVersion(self):
+        if self._ParserDigest is None:
+            Hash = md5(str(self._VERSION_).encode())
+            Dir = os.path.dirname(os.path.abspath(__file__))
+            try:
+                for Source in ('MetaFileParser.py', 'MetaFileTable.py'):
+                    with open(os.path.join(Dir, Source), 'rb') as File:
+                        Hash.update(File.read())
+                self._ParserDigest = Hash.hexdigest()
+            except:
+                self._ParserDigest = ''
+        return self._ParserDigest
+
+    ## Get the name of the cache entry of a meta file
+    #
+    #   The content hash of the file is also recorded for the binary cache
+    #   (--hash), which then doesn't need to read the file again.
+    #
+    #   @param  MetaFile    PathClass of the meta file
+    #   @param  FileType    MODEL_FILE_INF or MODEL_FILE_DEC
+    #
+    #   @retval str         Name of the entry
+    #   @retval None        The file can't be cached
+    #
+    def GetKey(self, MetaFile, FileType):
+        if FileType not in self._FILE_TYPES_ or self._Directory is None or not self._ParserVersion:
+            return None
+        try:
+            with open(str(MetaFile), 'rb') as File:
+                Content = File.read()
+        except:
+            # Let the parser report the error
+            return None
+
+        ContentDigest = md5(Content).hexdigest()
+        if GlobalData.gFileHashDict is not None and MetaFile.Path not in GlobalData.gFileHashDict:
+            GlobalData.gFileHashDict[MetaFile.Path] = ContentDigest
+
+        Hash = md5()
+        Hash.update(self._ParserVersion.encode())
+        Hash.update(ContentDigest.encode())
+        Hash.update(str(MetaFile).encode())
+        Hash.update(str(FileType).encode())
+        Hash.update(' '.join(sorted(GlobalData.gGlobalDefines)).encode())
+        Hash.update(str(bool(GlobalData.gOptions and GlobalData.gOptions.CheckUsage)).encode())
+        return Hash.hexdigest()
+
+    ## Load the records of a meta file into its table
+    #
+    #   @param  Key         Name of the entry returned by GetKey()
+    #   @param  Table       MetaFileTable of the meta file
+    #
+    #   @retval True        The records were loaded
+    #   @retval False       There's no valid entry, the file must be parsed
+    #
+    def Load(self, Key, Table):
+        EntryPath = os.path.join(self._Directory, Key)
+        if not os.path.exists(EntryPath):
+            return False
+        try:
+            with open(EntryPath, 'rb') as File:
+                Content = pickle.load(File)
+        except Exception as Exc:
+            EdkLogger.debug(EdkLogger.DEBUG_5, "Ignore meta file cache entry %s: %s" % (EntryPath, str(Exc)))
+            return False
+        Table.SetContent(Content)
+        if not Table.IsIntegrity():
+            Table.SetContent([])
+            return False
+        return True
+
+    ## Save the records of a parsed meta file
+    #
+    #   @param  Key         Name of the entry returned by GetKey()
+    #   @param  Table       MetaFileTable of the meta file
+    #
+    def Save(self, Key, Table):
+        if not Table.IsIntegrity():
+            return
+        Directory = self._Directory
+        EntryPath = os.path.join(Directory, Key)
+        if os.path.exists(EntryPath):
+            return
+        TempPath = None
+        try:
+            if not os.path.exists(Directory):
+                os.makedirs(Directory)
+            #
+            # AutoGen processes may save the same entry at the same time. The
+            # entries only depend on their name, the first one written is kept.
+            #
+            with tempfile.NamedTemporaryFile(dir=Directory, delete=False) as File:
+                TempPath = File.name
+                pickle.dump(Table.CurrentContent, File, pickle.HIGHEST_PROTOCOL)
+            if not os.path.exists(EntryPath):
+                os.rename(TempPath, EntryPath)
+                TempPath = None
+        except Exception as Exc:
+            EdkLogger.debug(EdkLogger.DEBUG_5, "Failed to save meta file cache entry %s: %s" % (EntryPath, str(Exc)))
+        finally:
+            if TempPath is not None and os.path.exists(TempPath):
+                os.remove(TempPath)
+
+gMetaFileCache = MetaFileCache()
@@ -29,6 +29,7 @@ from CommonDataClass.Exceptions import *
 from Common.LongFilePathSupport import OpenLongFilePath as open
 from collections import defaultdict
 from .MetaFileTable import MetaFileStorage
+from .MetaFileCache import gMetaFileCache
 from .MetaFileCommentParser import CheckInfComment
 from Common.DataType import TAB_COMMENT_EDK_START, TAB_COMMENT_EDK_END
 
@@ -258,7 +259,14 @@ class MetaFileParser(object):
             else:
                 self._Table = self._RawTable
                 self._PostProcessed = False
+                # Reuse the records of a previous build if the file didn't change
+                CacheKey = gMetaFileCache.GetKey(self.MetaFile, self._FileType)
+                if CacheKey and gMetaFileCache.Load(CacheKey, self._RawTable):
+                    self._Finished = True
+                    return
                 self.Start()
+                if CacheKey:
+                    gMetaFileCache.Save(CacheKey, self._RawTable)
     ## Data parser for the common format in different type of file
     #
     #   The common format in the meatfile is like
@@ -64,6 +64,16 @@ class MetaFileTable():
     def GetAll(self):
         return [item for item in self.CurrentContent if item[0] >= 0 and item[-1]>=0]
 
+    ## Replace the records with the ones of another table of the same file
+    #
+    # The records keep their IDs, they are only compared within a table.
+    #
+    # @param Content:        Records of the other table, with the end flag
+    #
+    def SetContent(self, Content):
+        self.CurrentContent = Content
+        self.ID = max([self.ID] + [Record[0] for Record in Content])
+
 ## Python class representation of table storing module data
 class ModuleTable(MetaFileTable):
     _COLUMN_ = '''
@@ -70,6 +70,9 @@ gIncludePattern2 = re.compile(r"#include\s+EFI_([A-Z_]+)\s*[(]\s*(\w+)\s*[)]")
 ## Pattern to find the entry point for EDK module using EDKII Glue library
 gGlueLibEntryPoint = re.compile(r"__EDKII_GLUE_MODULE_ENTRY_POINT__\s*=\s*(\w+)")
 
+## Library class of the OpenSSL library, reported for modules that embed it
+gOpensslLibraryClass = "OpensslLib"
+
 ## Tags for MaxLength of line in report
 gLineMaxLength = 120
 
@@ -583,6 +586,16 @@ class ModuleReport(object):
         self.PciClassCode = M.Module.Defines.get("PCI_CLASS_CODE", "")
         self.BuildTime = M.BuildTime
 
+        #
+        # Whether a private copy of OpenSSL is linked into the module, rather than
+        # using the shared crypto services of the Crypto PPI/Protocol.
+        #
+        self.EmbedsOpenssl = False
+        for Lib in M.DependentLibraryList:
+            for LibClass in Lib.LibraryClass:
+                if LibClass.LibraryClass == gOpensslLibraryClass:
+                    self.EmbedsOpenssl = True
+
         self._BuildDir = M.BuildDir
         self.ModulePcdSet = {}
         if "PCD" in ReportType:
@@ -2242,6 +2255,33 @@ class PlatformReport(object):
             if "EXECUTION_ORDER" in ReportType:
                 self.PredictionReport.GenerateReport(File, None)
 
+            if "LIBRARY" in ReportType:
+                self._GenerateOpensslReport(File)
+
+    ##
+    # Generate report for the modules that embed OpenSSL.
+    #
+    # Every module linking OpensslLib carries its own copy of OpenSSL. This
+    # section lists them, so platforms can move them to the shared crypto
+    # services of the Crypto PPI/Protocol. Module sizes are only known once the
+    # module sections were generated.
+    #
+    # @param self            The object pointer
+    # @param File            The file object for report
+    #
+    def _GenerateOpensslReport(self, File):
+        ModuleList = [Module for Module in self.ModuleReportList if Module.EmbedsOpenssl]
+        TotalSize = sum(Module.Size for Module in ModuleList)
+
+        FileWrite(File, gSectionStart)
+        FileWrite(File, "Modules Embedding OpenSSL")
+        FileWrite(File, "Module Count:         %d" % len(ModuleList))
+        FileWrite(File, "Total Size:           0x%X (%.2fK)" % (TotalSize, TotalSize / 1024.0))
+        FileWrite(File, gSectionSep)
+        for Module in ModuleList:
+            FileWrite(File, "%-40s %-8s 0x%08X %s" % (Module.ModuleName, Module.ModuleArch, Module.Size, Module.ModuleInfPath))
+        FileWrite(File, gSectionEnd)
+
 ## BuildReport class
 #
 #  This base class contain the routines to collect data and then
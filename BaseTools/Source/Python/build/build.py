@@ -23,6 +23,7 @@ import time
 import platform
 import traceback
 import multiprocessing
+import json
 from threading import Thread,Event,BoundedSemaphore
 import threading
 from linecache import getlines
@@ -275,17 +276,76 @@ def LaunchCommand(Command, WorkingDir,ModuleAuto = None):
 
         EdkLogger.error("build", COMMAND_FAILURE, ExtraData="%s [%s]" % (Command, WorkingDir))
     if ModuleAuto:
-        iau = IncludesAutoGen(WorkingDir,ModuleAuto)
-        if ModuleAuto.ToolChainFamily == TAB_COMPILER_MSFT:
-            iau.CreateDepsFileForMsvc(Proc.ProcOut)
-        else:
-            iau.UpdateDepsFileforNonMsvc()
-        iau.UpdateDepsFileforTrim()
-        iau.CreateModuleDeps()
-        iau.CreateDepsInclude()
-        iau.CreateDepsTarget()
+        UpdateModuleDeps(WorkingDir, ModuleAuto, Proc.ProcOut)
     return "%dms" % (int(round((time.time() - BeginTime) * 1000)))
 
+## Update the files listing the included files of a module after it was built
+#
+#   @param  WorkingDir      The directory of the makefile of the module
+#   @param  ModuleAuto      The ModuleAutoGen object of the module
+#   @param  ProcOut         The output of the build command, which has the included
+#                           files printed by the MSFT compiler
+#   @param  NinjaDeps       The included files of the targets recorded by Ninja, see
+#                           ReadNinjaDeps(). Ninja does not print the included files
+#                           of the MSFT compiler, so they are taken from here instead.
+#
+def UpdateModuleDeps(WorkingDir, ModuleAuto, ProcOut, NinjaDeps=None):
+    iau = IncludesAutoGen(WorkingDir,ModuleAuto)
+    if ModuleAuto.ToolChainFamily == TAB_COMPILER_MSFT:
+        if NinjaDeps is not None:
+            iau.CreateDepsFileFromNinja(NinjaDeps)
+        else:
+            iau.CreateDepsFileForMsvc(ProcOut)
+    else:
+        iau.UpdateDepsFileforNonMsvc()
+    iau.UpdateDepsFileforTrim()
+    iau.CreateModuleDeps()
+    iau.CreateDepsInclude()
+    iau.CreateDepsTarget()
+
+## Read the included files Ninja recorded for the targets built with deps = msvc
+#
+#   "ninja -t deps" prints each target followed by its included files, one per line
+#   and indented, and an empty line.
+#
+#   @param  BuildCommand    The Ninja command line, with the build file to read
+#   @param  WorkingDir      The directory the command runs in
+#
+#   @retval dict            The included files of each target, by normalized path
+#
+def ReadNinjaDeps(BuildCommand, WorkingDir):
+    Command = ' '.join(BuildCommand + ['-t', 'deps'])
+    try:
+        Proc = Popen(Command, stdout=PIPE, stderr=STDOUT, cwd=WorkingDir, shell=True)
+        Output = Proc.communicate()[0].decode(encoding='utf-8', errors='ignore')
+    except Exception as X:
+        EdkLogger.error("build", COMMAND_FAILURE, ExtraData="%s: %s [%s]" % (str(X), Command, WorkingDir))
+    if Proc.returncode != 0:
+        EdkLogger.error("build", COMMAND_FAILURE, Output, ExtraData="%s [%s]" % (Command, WorkingDir))
+
+    NinjaDeps = {}
+    Includes = None
+    for Line in Output.splitlines():
+        if not Line.strip():
+            Includes = None
+        elif Line[0] in ' \t':
+            if Includes is not None:
+                Includes.append(Line.strip())
+        elif ': #deps ' in Line:
+            Target = Line.split(': #deps ')[0]
+            Includes = NinjaDeps.setdefault(os.path.normcase(os.path.normpath(Target)), [])
+    return NinjaDeps
+
+## Check whether the build command runs Ninja
+#
+#   @param  BuildCommand    The build command of a platform, from MAKE_PATH and MAKE_FLAGS
+#
+#   @retval True            The build files are Ninja files
+#   @retval False           The build files are makefiles
+#
+def IsNinjaBuild(BuildCommand):
+    return bool(BuildCommand) and "ninja" in BuildCommand[0]
+
 ## The smallest unit that can be built in multi-thread build mode
 #
 # This is the base class of build unit. The "Obj" parameter must provide
@@ -425,6 +485,12 @@ class BuildTask:
     _SchedulerStopped = threading.Event()
     _SchedulerStopped.set()
 
+    # longest build time in seconds seen for each module, by working directory
+    _BuildTimeHistory = None
+
+    # build time in seconds assumed for each source file of a module never built
+    _SourceBuildTime = 0.1
+
     ## Start the task scheduler thread
     #
     #   @param  MaxThreadNumber     The maximum thread number
@@ -432,6 +498,8 @@ class BuildTask:
     #
     @staticmethod
     def StartScheduler(MaxThreadNumber, ExitFlag):
+        if BuildTask._BuildTimeHistory is None:
+            BuildTask._BuildTimeHistory = BuildTask._LoadBuildTimeHistory()
         SchedulerThread = Thread(target=BuildTask.Scheduler, args=(MaxThreadNumber, ExitFlag))
         SchedulerThread.setName("Build-Task-Scheduler")
         SchedulerThread.setDaemon(False)
@@ -440,8 +508,37 @@ class BuildTask:
         while not BuildTask.IsOnGoing():
             time.sleep(0.01)
 
+    ## Path of the file keeping the build time of the modules across builds
+    @staticmethod
+    def _BuildTimeHistoryPath():
+        return os.path.join(os.path.dirname(GlobalData.gDatabasePath), 'BuildTime.json')
+
+    ## Load the build time of the modules in the previous builds
+    @staticmethod
+    def _LoadBuildTimeHistory():
+        try:
+            with open(BuildTask._BuildTimeHistoryPath(), 'r') as File:
+                return json.load(File)
+        except:
+            return {}
+
+    ## Save the build time of the modules for the next builds
+    @staticmethod
+    def _SaveBuildTimeHistory():
+        try:
+            with open(BuildTask._BuildTimeHistoryPath(), 'w') as File:
+                json.dump(BuildTask._BuildTimeHistory, File, indent=0, sort_keys=True)
+        except:
+            EdkLogger.debug(EdkLogger.DEBUG_8, "Failed to save the build time of the modules")
+
     ## Scheduler method
     #
+    #   The ready task with the longest remaining build time, its own plus the
+    #   one of the longest chain of tasks waiting for it, is started first. The
+    #   build time of a task comes from the previous builds, or is estimated from
+    #   its number of source files. So the libraries of the large modules and the
+    #   large modules themselves don't delay the end of the build.
+    #
     #   @param  MaxThreadNumber     The maximum thread number
     #   @param  ExitFlag            Flag used to end the scheduler
     #
@@ -460,6 +557,9 @@ class BuildTask:
                 EdkLogger.debug(EdkLogger.DEBUG_8, "Pending Queue (%d), Ready Queue (%d)"
                                 % (len(BuildTask._PendingQueue), len(BuildTask._ReadyQueue)))
 
+                # tasks may be added while building, the remaining build times are updated every round
+                RemainingTimeDict = {}
+
                 # get all pending tasks
                 BuildTask._PendingQueueLock.acquire()
                 BuildObjectList = list(BuildTask._PendingQueue.keys())
@@ -482,8 +582,9 @@ class BuildTask:
                     # wait for active thread(s) exit
                     BuildTask._Thread.acquire(True)
 
-                    # start a new build thread
-                    Bo, Bt = BuildTask._ReadyQueue.popitem()
+                    # start a new build thread, for the task on the critical path
+                    Bo = max(BuildTask._ReadyQueue, key=lambda Bo: BuildTask._ReadyQueue[Bo].GetRemainingTime(RemainingTimeDict))
+                    Bt = BuildTask._ReadyQueue.pop(Bo)
 
                     # move into running queue
                     BuildTask._RunningQueueLock.acquire()
@@ -519,6 +620,7 @@ class BuildTask:
         BuildTask._ReadyQueue.clear()
         BuildTask._RunningQueue.clear()
         BuildTask._TaskQueue.clear()
+        BuildTask._SaveBuildTimeHistory()
         BuildTask._SchedulerStopped.set()
 
     ## Wait for all running method exit
@@ -593,6 +695,8 @@ class BuildTask:
         self.BuildItem = BuildItem
 
         self.DependencyList = []
+        # build tasks waiting for this one
+        self.DependentList = []
         if Dependency is None:
             Dependency = BuildItem.Dependency
         else:
@@ -620,7 +724,25 @@ class BuildTask:
     def AddDependency(self, Dependency):
         for Dep in Dependency:
             if not Dep.BuildObject.IsBinaryModule and not Dep.BuildObject.CanSkipbyCache(GlobalData.gModuleCacheHit):
-                self.DependencyList.append(BuildTask.New(Dep))    # BuildTask list
+                Bt = BuildTask.New(Dep)
+                Bt.DependentList.append(self)
+                self.DependencyList.append(Bt)    # BuildTask list
+
+    ## Get the expected build time of the task in seconds
+    #
+    def GetBuildTime(self):
+        if self.BuildItem.WorkingDir in BuildTask._BuildTimeHistory:
+            return BuildTask._BuildTimeHistory[self.BuildItem.WorkingDir]
+        return BuildTask._SourceBuildTime * (len(self.BuildItem.BuildObject.Module.Sources) + 1)
+
+    ## Get the build time of the task and of the longest chain of tasks waiting for it
+    #
+    #   @param  RemainingTimeDict   The remaining build times already computed
+    #
+    def GetRemainingTime(self, RemainingTimeDict):
+        if self not in RemainingTimeDict:
+            RemainingTimeDict[self] = self.GetBuildTime() + max([Bt.GetRemainingTime(RemainingTimeDict) for Bt in self.DependentList] or [0])
+        return RemainingTimeDict[self]
 
     ## The thread wrapper of LaunchCommand function
     #
@@ -629,7 +751,12 @@ class BuildTask:
     #
     def _CommandThread(self, Command, WorkingDir):
         try:
+            BeginTime = time.time()
             self.BuildItem.BuildObject.BuildTime = LaunchCommand(Command, WorkingDir,self.BuildItem.BuildObject)
+            # keep the longest time, an incremental build says nothing about the real cost
+            BuildTime = time.time() - BeginTime
+            if BuildTime > BuildTask._BuildTimeHistory.get(WorkingDir, 0):
+                BuildTask._BuildTimeHistory[WorkingDir] = round(BuildTime, 3)
             self.CompleteFlag = True
 
             # Run hash operation post dependency to account for libs
@@ -1267,6 +1394,7 @@ class Build():
             mqueue.put((None,None,None,None,None,None,None))
             AutoGenObject.DataPipe.DataContainer = {"CommandTarget": self.Target}
             AutoGenObject.DataPipe.DataContainer = {"Workspace_timestamp": AutoGenObject.Workspace._SrcTimeStamp}
+            AutoGenObject.DataPipe.DataContainer = {"Workspace_conf_timestamp": AutoGenObject.Workspace._ConfTimeStamp}
             AutoGenObject.CreateLibModuelDirs()
             AutoGenObject.DataPipe.DataContainer = {"LibraryBuildDirectoryList":AutoGenObject.LibraryBuildDirectoryList}
             AutoGenObject.DataPipe.DataContainer = {"ModuleBuildDirectoryList":AutoGenObject.ModuleBuildDirectoryList}
@@ -1821,6 +1949,7 @@ class Build():
                         self.BuildModules.append(Ma)
                     Pa.DataPipe.DataContainer = {"FfsCommand":CmdListDict}
                     Pa.DataPipe.DataContainer = {"Workspace_timestamp": Wa._SrcTimeStamp}
+                    Pa.DataPipe.DataContainer = {"Workspace_conf_timestamp": Wa._ConfTimeStamp}
                     self._BuildPa(self.Target, Pa, FfsCommand=CmdListDict,PcdMaList=PcdMaList)
 
                 # Create MAP file when Load Fix Address is enabled.
@@ -2179,6 +2308,7 @@ class Build():
                     ModuleList.append(Inf)
             Pa.DataPipe.DataContainer = {"FfsCommand":CmdListDict}
             Pa.DataPipe.DataContainer = {"Workspace_timestamp": Wa._SrcTimeStamp}
+            Pa.DataPipe.DataContainer = {"Workspace_conf_timestamp": Wa._ConfTimeStamp}
             Pa.DataPipe.DataContainer = {"CommandTarget": self.Target}
             Pa.CreateLibModuelDirs()
             # Fetch the MakeFileName.
@@ -2260,6 +2390,39 @@ class Build():
         self.Progress.Stop("done!")
         return Wa, BuildModules
 
+    ## Build the modules of a platform with Ninja
+    #
+    #   The modules and libraries of all architectures are built in one build graph,
+    #   by the build.ninja generated in the build directory of the platform.
+    #
+    #   @param  Pa              The PlatformAutoGen object of the first architecture
+    #   @param  ModuleList      The ModuleAutoGen objects of the modules to build
+    #
+    def _NinjaBuildPlatform(self, Pa, ModuleList):
+        ModuleList = [Ma for Ma in set(ModuleList) if not Ma.IsBinaryModule]
+        NinjaFile = GenMake.PlatformNinjaFile(Pa, ModuleList)
+        NinjaFile.Generate()
+
+        BuildCommand = Pa.BuildCommand + ['-f', NinjaFile.FilePath, '-j', str(self.ThreadNumber)]
+        # The binary cache gets the included files of the modules from the dependency files
+        KeepDepFile = GlobalData.gUseHashCache or GlobalData.gBinCacheDest or GlobalData.gBinCacheSource
+        if KeepDepFile:
+            BuildCommand += ['-d', 'keepdepfile']
+        LaunchCommand(BuildCommand + ['all'], Pa.BuildDir)
+
+        if KeepDepFile:
+            ModuleDict = {}
+            for Ma in ModuleList:
+                for ModuleAuto in [Ma] + Ma.LibraryAutoGenList:
+                    if not ModuleAuto.IsBinaryModule:
+                        ModuleDict[ModuleAuto.MakeFileDir] = ModuleAuto
+            # With deps = msvc, Ninja keeps the output of /showIncludes in its log only
+            NinjaDeps = None
+            if [Ma for Ma in ModuleDict.values() if Ma.ToolChainFamily == TAB_COMPILER_MSFT]:
+                NinjaDeps = ReadNinjaDeps(Pa.BuildCommand + ['-f', NinjaFile.FilePath], Pa.BuildDir)
+            for MakeFileDir in ModuleDict:
+                UpdateModuleDeps(MakeFileDir, ModuleDict[MakeFileDir], [], NinjaDeps)
+
     def _MultiThreadBuildPlatform(self):
         SaveFileOnChange(self.PlatformBuildPath, '# DO NOT EDIT \n# FILE auto-generated\n', False)
         for BuildTarget in self.BuildTargetList:
@@ -2291,28 +2454,33 @@ class Build():
                     EdkLogger.quiet("[cache Summary]: PreMakecache miss num: %s " % len(self.PreMakeCacheMiss))
                     EdkLogger.quiet("[cache Summary]: Makecache miss num: %s " % len(self.MakeCacheMiss))
 
-                for Arch in Wa.ArchList:
+                if IsNinjaBuild(Pa.BuildCommand) and self.Target in ["", "all", "fds"]:
                     MakeStart = time.time()
-                    for Ma in set(self.BuildModules):
-                        # Generate build task for the module
-                        if not Ma.IsBinaryModule:
-                            Bt = BuildTask.New(ModuleMakeUnit(Ma, Pa.BuildCommand,self.Target))
-                        # Break build if any build thread has error
+                    self._NinjaBuildPlatform(Pa, self.BuildModules)
+                    self.MakeTime += int(round((time.time() - MakeStart)))
+                else:
+                    for Arch in Wa.ArchList:
+                        MakeStart = time.time()
+                        for Ma in set(self.BuildModules):
+                            # Generate build task for the module
+                            if not Ma.IsBinaryModule:
+                                Bt = BuildTask.New(ModuleMakeUnit(Ma, Pa.BuildCommand,self.Target))
+                            # Break build if any build thread has error
+                            if BuildTask.HasError():
+                                # we need a full version of makefile for platform
+                                ExitFlag.set()
+                                BuildTask.WaitForComplete()
+                                Pa.CreateMakeFile(False)
+                                EdkLogger.error("build", BUILD_ERROR, "Failed to build module", ExtraData=GlobalData.gBuildingModule)
+                            # Start task scheduler
+                            if not BuildTask.IsOnGoing():
+                                BuildTask.StartScheduler(self.ThreadNumber, ExitFlag)
+
+                        # in case there's an interruption. we need a full version of makefile for platform
+
                         if BuildTask.HasError():
-                            # we need a full version of makefile for platform
-                            ExitFlag.set()
-                            BuildTask.WaitForComplete()
-                            Pa.CreateMakeFile(False)
                             EdkLogger.error("build", BUILD_ERROR, "Failed to build module", ExtraData=GlobalData.gBuildingModule)
-                        # Start task scheduler
-                        if not BuildTask.IsOnGoing():
-                            BuildTask.StartScheduler(self.ThreadNumber, ExitFlag)
-
-                    # in case there's an interruption. we need a full version of makefile for platform
-
-                    if BuildTask.HasError():
-                        EdkLogger.error("build", BUILD_ERROR, "Failed to build module", ExtraData=GlobalData.gBuildingModule)
-                    self.MakeTime += int(round((time.time() - MakeStart)))
+                        self.MakeTime += int(round((time.time() - MakeStart)))
 
                 MakeContiue = time.time()
                 #
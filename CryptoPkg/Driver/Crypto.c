@@ -8,9 +8,11 @@
 
 **/
 #include <Base.h>
+#include <IndustryStandard/Tpm20.h>
 #include <Library/DebugLib.h>
 #include <Library/BaseCryptLib.h>
 #include <Library/TlsLib.h>
+#include <Library/HashApiLib.h>
 #include <Protocol/Crypto.h>
 #include <Pcd/PcdCryptoServiceFamilyEnable.h>
 
@@ -4015,6 +4017,33 @@ CryptoServiceTlsSetVerifyHost (
   return CALL_BASECRYPTLIB (TlsSet.Services.VerifyHost, TlsSetVerifyHost, (Tls, Flags, HostName), EFI_UNSUPPORTED);
 }
 
+/**
+  Set the port of the server to be connected.
+
+  The client sessions of the TLS objects are cached for resumption. A cached
+  session is only resumed by a TLS object connecting to the same server, i.e.
+  with the same host name set by TlsSetVerifyHost() and the same port. The
+  port must be set before the handshake is started. A TLS object whose port is
+  not set only resumes the sessions cached with the port 0.
+
+  @param[in]  Tls           Pointer to the TLS object.
+  @param[in]  Port          The port of the server.
+
+  @retval  EFI_SUCCESS           The port was set successfully.
+  @retval  EFI_INVALID_PARAMETER The parameter is invalid.
+  @retval  EFI_UNSUPPORTED       The sessions are not cached.
+
+**/
+EFI_STATUS
+EFIAPI
+CryptoServiceTlsSetServerPort (
+  IN     VOID                     *Tls,
+  IN     UINT16                   Port
+  )
+{
+  return CALL_BASECRYPTLIB (TlsSet.Services.ServerPort, TlsSetServerPort, (Tls, Port), EFI_UNSUPPORTED);
+}
+
 /**
   Sets a TLS/SSL session ID to be used during TLS/SSL connect.
 
@@ -4463,6 +4492,490 @@ CryptoServiceTlsGetCertRevocationList (
   return CALL_BASECRYPTLIB (TlsGet.Services.CertRevocationList, TlsGetCertRevocationList, (Data, DataSize), EFI_UNSUPPORTED);
 }
 
+/**
+  Carries out the RSA-SSA signature generation with EMSA-PSS encoding scheme.
+
+  This function carries out the RSA-SSA signature generation with EMSA-PSS encoding scheme defined in
+  RFC 8017.
+  Mask generation function is the same as the message digest algorithm.
+  If the Signature buffer is too small to hold the contents of signature, FALSE
+  is returned and SigSize is set to the required buffer size to obtain the signature.
+
+  If RsaContext is NULL, then return FALSE.
+  If Message is NULL, then return FALSE.
+  If MsgSize is zero or > INT_MAX, then return FALSE.
+  If DigestLen is NOT 32, 48 or 64, return FALSE.
+  If SaltLen is not equal to DigestLen, then return FALSE.
+  If SigSize is large enough but Signature is NULL, then return FALSE.
+  If this interface is not supported, then return FALSE.
+
+  @param[in]      RsaContext   Pointer to RSA context for signature generation.
+  @param[in]      Message      Pointer to octet message to be signed.
+  @param[in]      MsgSize      Size of the message in bytes.
+  @param[in]      DigestLen    Length of the digest in bytes to be used for RSA signature operation.
+  @param[in]      SaltLen      Length of the salt in bytes to be used for PSS encoding.
+  @param[out]     Signature    Pointer to buffer to receive RSA PSS signature.
+  @param[in, out] SigSize      On input, the size of Signature buffer in bytes.
+                               On output, the size of data returned in Signature buffer in bytes.
+
+  @retval  TRUE   Signature successfully generated in RSASSA-PSS.
+  @retval  FALSE  Signature generation failed.
+  @retval  FALSE  SigSize is too small.
+  @retval  FALSE  This interface is not supported.
+
+**/
+BOOLEAN
+EFIAPI
+CryptoServiceRsaPssSign (
+  IN      VOID         *RsaContext,
+  IN      CONST UINT8  *Message,
+  IN      UINTN        MsgSize,
+  IN      UINT16       DigestLen,
+  IN      UINT16       SaltLen,
+  OUT     UINT8        *Signature,
+  IN OUT  UINTN        *SigSize
+  )
+{
+  return CALL_BASECRYPTLIB (RsaPss.Services.Sign, RsaPssSign, (RsaContext, Message, MsgSize, DigestLen, SaltLen, Signature, SigSize), FALSE);
+}
+
+/**
+  Verifies the RSA signature with RSASSA-PSS signature scheme defined in RFC 8017.
+  Implementation determines salt length automatically from the signature encoding.
+  Mask generation function is the same as the message digest algorithm.
+  Salt length should be equal to digest length.
+
+  @param[in]  RsaContext      Pointer to RSA context for signature verification.
+  @param[in]  Message         Pointer to octet message to be verified.
+  @param[in]  MsgSize         Size of the message in bytes.
+  @param[in]  Signature       Pointer to RSASSA-PSS signature to be verified.
+  @param[in]  SigSize         Size of signature in bytes.
+  @param[in]  DigestLen       Length of digest for RSA operation.
+  @param[in]  SaltLen         Salt length for PSS encoding.
+
+  @retval  TRUE   Valid signature encoded in RSASSA-PSS.
+  @retval  FALSE  Invalid signature or invalid RSA context.
+
+**/
+BOOLEAN
+EFIAPI
+CryptoServiceRsaPssVerify (
+  IN  VOID         *RsaContext,
+  IN  CONST UINT8  *Message,
+  IN  UINTN        MsgSize,
+  IN  CONST UINT8  *Signature,
+  IN  UINTN        SigSize,
+  IN  UINT16       DigestLen,
+  IN  UINT16       SaltLen
+  )
+{
+  return CALL_BASECRYPTLIB (RsaPss.Services.Verify, RsaPssVerify, (RsaContext, Message, MsgSize, Signature, SigSize, DigestLen, SaltLen), FALSE);
+}
+
+/**
+  Retrieves the size, in bytes, of the context buffer required for hash
+  operations with the given hash algorithm.
+
+  @param[in]  HashPolicy   Hash algorithm, one of the HASH_ALG_* values of
+                           PcdHashApiLibPolicy.
+
+  @return  The size, in bytes, of the context buffer required for hash operations.
+  @return  Zero if the hash algorithm is not supported.
+
+**/
+STATIC
+UINTN
+CryptoHashApiGetContextSize (
+  IN UINT32  HashPolicy
+  )
+{
+  switch (HashPolicy) {
+#ifndef DISABLE_SHA1_DEPRECATED_INTERFACES
+    case HASH_ALG_SHA1:
+      return CALL_BASECRYPTLIB (Sha1.Services.GetContextSize, Sha1GetContextSize, (), 0);
+#endif
+
+    case HASH_ALG_SHA256:
+      return CALL_BASECRYPTLIB (Sha256.Services.GetContextSize, Sha256GetContextSize, (), 0);
+
+    case HASH_ALG_SHA384:
+      return CALL_BASECRYPTLIB (Sha384.Services.GetContextSize, Sha384GetContextSize, (), 0);
+
+    case HASH_ALG_SHA512:
+      return CALL_BASECRYPTLIB (Sha512.Services.GetContextSize, Sha512GetContextSize, (), 0);
+
+    case HASH_ALG_SM3_256:
+      return CALL_BASECRYPTLIB (Sm3.Services.GetContextSize, Sm3GetContextSize, (), 0);
+
+    default:
+      return 0;
+  }
+}
+
+/**
+  Init hash sequence with the given hash algorithm.
+
+  @param[in]  HashPolicy    Hash algorithm, one of the HASH_ALG_* values of
+                            PcdHashApiLibPolicy.
+  @param[out] HashContext   Hash context.
+
+  @retval TRUE         Hash start and HashHandle returned.
+  @retval FALSE        Hash Init unsuccessful.
+
+**/
+STATIC
+BOOLEAN
+CryptoHashApiInit (
+  IN  UINT32            HashPolicy,
+  OUT HASH_API_CONTEXT  HashContext
+  )
+{
+  switch (HashPolicy) {
+#ifndef DISABLE_SHA1_DEPRECATED_INTERFACES
+    case HASH_ALG_SHA1:
+      return CALL_BASECRYPTLIB (Sha1.Services.Init, Sha1Init, (HashContext), FALSE);
+#endif
+
+    case HASH_ALG_SHA256:
+      return CALL_BASECRYPTLIB (Sha256.Services.Init, Sha256Init, (HashContext), FALSE);
+
+    case HASH_ALG_SHA384:
+      return CALL_BASECRYPTLIB (Sha384.Services.Init, Sha384Init, (HashContext), FALSE);
+
+    case HASH_ALG_SHA512:
+      return CALL_BASECRYPTLIB (Sha512.Services.Init, Sha512Init, (HashContext), FALSE);
+
+    case HASH_ALG_SM3_256:
+      return CALL_BASECRYPTLIB (Sm3.Services.Init, Sm3Init, (HashContext), FALSE);
+
+    default:
+      return FALSE;
+  }
+}
+
+/**
+  Makes a copy of an existing hash context of the given hash algorithm.
+
+  @param[in]  HashPolicy      Hash algorithm, one of the HASH_ALG_* values of
+                              PcdHashApiLibPolicy.
+  @param[in]  HashContext     Hash context.
+  @param[out] NewHashContext  New copy of hash context.
+
+  @retval TRUE         Hash context copy succeeded.
+  @retval FALSE        Hash context copy failed.
+
+**/
+STATIC
+BOOLEAN
+CryptoHashApiDuplicate (
+  IN  UINT32            HashPolicy,
+  IN  HASH_API_CONTEXT  HashContext,
+  OUT HASH_API_CONTEXT  NewHashContext
+  )
+{
+  switch (HashPolicy) {
+#ifndef DISABLE_SHA1_DEPRECATED_INTERFACES
+    case HASH_ALG_SHA1:
+      return CALL_BASECRYPTLIB (Sha1.Services.Duplicate, Sha1Duplicate, (HashContext, NewHashContext), FALSE);
+#endif
+
+    case HASH_ALG_SHA256:
+      return CALL_BASECRYPTLIB (Sha256.Services.Duplicate, Sha256Duplicate, (HashContext, NewHashContext), FALSE);
+
+    case HASH_ALG_SHA384:
+      return CALL_BASECRYPTLIB (Sha384.Services.Duplicate, Sha384Duplicate, (HashContext, NewHashContext), FALSE);
+
+    case HASH_ALG_SHA512:
+      return CALL_BASECRYPTLIB (Sha512.Services.Duplicate, Sha512Duplicate, (HashContext, NewHashContext), FALSE);
+
+    case HASH_ALG_SM3_256:
+      return CALL_BASECRYPTLIB (Sm3.Services.Duplicate, Sm3Duplicate, (HashContext, NewHashContext), FALSE);
+
+    default:
+      return FALSE;
+  }
+}
+
+/**
+  Update hash data with the given hash algorithm.
+
+  @param[in] HashPolicy    Hash algorithm, one of the HASH_ALG_* values of
+                           PcdHashApiLibPolicy.
+  @param[in] HashContext   Hash context.
+  @param[in] DataToHash    Data to be hashed.
+  @param[in] DataToHashLen Data size.
+
+  @retval TRUE         Hash updated.
+  @retval FALSE        Hash updated unsuccessful.
+
+**/
+STATIC
+BOOLEAN
+CryptoHashApiUpdate (
+  IN UINT32            HashPolicy,
+  IN HASH_API_CONTEXT  HashContext,
+  IN VOID              *DataToHash,
+  IN UINTN             DataToHashLen
+  )
+{
+  switch (HashPolicy) {
+#ifndef DISABLE_SHA1_DEPRECATED_INTERFACES
+    case HASH_ALG_SHA1:
+      return CALL_BASECRYPTLIB (Sha1.Services.Update, Sha1Update, (HashContext, DataToHash, DataToHashLen), FALSE);
+#endif
+
+    case HASH_ALG_SHA256:
+      return CALL_BASECRYPTLIB (Sha256.Services.Update, Sha256Update, (HashContext, DataToHash, DataToHashLen), FALSE);
+
+    case HASH_ALG_SHA384:
+      return CALL_BASECRYPTLIB (Sha384.Services.Update, Sha384Update, (HashContext, DataToHash, DataToHashLen), FALSE);
+
+    case HASH_ALG_SHA512:
+      return CALL_BASECRYPTLIB (Sha512.Services.Update, Sha512Update, (HashContext, DataToHash, DataToHashLen), FALSE);
+
+    case HASH_ALG_SM3_256:
+      return CALL_BASECRYPTLIB (Sm3.Services.Update, Sm3Update, (HashContext, DataToHash, DataToHashLen), FALSE);
+
+    default:
+      return FALSE;
+  }
+}
+
+/**
+  Hash complete with the given hash algorithm.
+
+  @param[in]  HashPolicy   Hash algorithm, one of the HASH_ALG_* values of
+                           PcdHashApiLibPolicy.
+  @param[in]  HashContext  Hash context.
+  @param[out] Digest       Hash Digest.
+
+  @retval TRUE         Hash complete and Digest is returned.
+  @retval FALSE        Hash complete unsuccessful.
+
+**/
+STATIC
+BOOLEAN
+CryptoHashApiFinal (
+  IN  UINT32            HashPolicy,
+  IN  HASH_API_CONTEXT  HashContext,
+  OUT UINT8             *Digest
+  )
+{
+  switch (HashPolicy) {
+#ifndef DISABLE_SHA1_DEPRECATED_INTERFACES
+    case HASH_ALG_SHA1:
+      return CALL_BASECRYPTLIB (Sha1.Services.Final, Sha1Final, (HashContext, Digest), FALSE);
+#endif
+
+    case HASH_ALG_SHA256:
+      return CALL_BASECRYPTLIB (Sha256.Services.Final, Sha256Final, (HashContext, Digest), FALSE);
+
+    case HASH_ALG_SHA384:
+      return CALL_BASECRYPTLIB (Sha384.Services.Final, Sha384Final, (HashContext, Digest), FALSE);
+
+    case HASH_ALG_SHA512:
+      return CALL_BASECRYPTLIB (Sha512.Services.Final, Sha512Final, (HashContext, Digest), FALSE);
+
+    case HASH_ALG_SM3_256:
+      return CALL_BASECRYPTLIB (Sm3.Services.Final, Sm3Final, (HashContext, Digest), FALSE);
+
+    default:
+      return FALSE;
+  }
+}
+
+/**
+  Computes hash message digest of a input data buffer with the given hash
+  algorithm.
+
+  @param[in]  HashPolicy     Hash algorithm, one of the HASH_ALG_* values of
+                             PcdHashApiLibPolicy.
+  @param[in]  DataToHash     Data to be hashed.
+  @param[in]  DataToHashLen  Data size.
+  @param[out] Digest         Hash Digest.
+
+  @retval TRUE   Hash digest computation succeeded.
+  @retval FALSE  Hash digest computation failed.
+
+**/
+STATIC
+BOOLEAN
+CryptoHashApiHashAll (
+  IN  UINT32      HashPolicy,
+  IN  CONST VOID  *DataToHash,
+  IN  UINTN       DataToHashLen,
+  OUT UINT8       *Digest
+  )
+{
+  switch (HashPolicy) {
+#ifndef DISABLE_SHA1_DEPRECATED_INTERFACES
+    case HASH_ALG_SHA1:
+      return CALL_BASECRYPTLIB (Sha1.Services.HashAll, Sha1HashAll, (DataToHash, DataToHashLen, Digest), FALSE);
+#endif
+
+    case HASH_ALG_SHA256:
+      return CALL_BASECRYPTLIB (Sha256.Services.HashAll, Sha256HashAll, (DataToHash, DataToHashLen, Digest), FALSE);
+
+    case HASH_ALG_SHA384:
+      return CALL_BASECRYPTLIB (Sha384.Services.HashAll, Sha384HashAll, (DataToHash, DataToHashLen, Digest), FALSE);
+
+    case HASH_ALG_SHA512:
+      return CALL_BASECRYPTLIB (Sha512.Services.HashAll, Sha512HashAll, (DataToHash, DataToHashLen, Digest), FALSE);
+
+    case HASH_ALG_SM3_256:
+      return CALL_BASECRYPTLIB (Sm3.Services.HashAll, Sm3HashAll, (DataToHash, DataToHashLen, Digest), FALSE);
+
+    default:
+      return FALSE;
+  }
+}
+
+/**
+  Retrieves the size, in bytes, of the context buffer required for hash
+  operations with the given hash algorithm.
+
+  The caller passes its own PcdHashApiLibPolicy, so that the hash algorithm
+  matches the digest size the caller expects.
+
+  @param[in]  HashPolicy   Hash algorithm, one of the HASH_ALG_* values of
+                           PcdHashApiLibPolicy.
+
+  @return  The size, in bytes, of the context buffer required for hash operations.
+  @return  Zero if the hash algorithm or this interface is not supported.
+
+**/
+UINTN
+EFIAPI
+CryptoServiceHashApiGetContextSize (
+  IN UINT32  HashPolicy
+  )
+{
+  return CALL_BASECRYPTLIB (HashApi.Services.GetContextSize, CryptoHashApiGetContextSize, (HashPolicy), 0);
+}
+
+/**
+  Init hash sequence with the given hash algorithm.
+
+  @param[in]  HashPolicy    Hash algorithm, one of the HASH_ALG_* values of
+                            PcdHashApiLibPolicy.
+  @param[out] HashContext   Hash context.
+
+  @retval TRUE         Hash start and HashHandle returned.
+  @retval FALSE        Hash Init unsuccessful.
+  @retval FALSE        The hash algorithm or this interface is not supported.
+
+**/
+BOOLEAN
+EFIAPI
+CryptoServiceHashApiInit (
+  IN  UINT32            HashPolicy,
+  OUT HASH_API_CONTEXT  HashContext
+  )
+{
+  return CALL_BASECRYPTLIB (HashApi.Services.Init, CryptoHashApiInit, (HashPolicy, HashContext), FALSE);
+}
+
+/**
+  Makes a copy of an existing hash context of the given hash algorithm.
+
+  @param[in]  HashPolicy      Hash algorithm, one of the HASH_ALG_* values of
+                              PcdHashApiLibPolicy.
+  @param[in]  HashContext     Hash context.
+  @param[out] NewHashContext  New copy of hash context.
+
+  @retval TRUE         Hash context copy succeeded.
+  @retval FALSE        Hash context copy failed.
+  @retval FALSE        The hash algorithm or this interface is not supported.
+
+**/
+BOOLEAN
+EFIAPI
+CryptoServiceHashApiDuplicate (
+  IN  UINT32            HashPolicy,
+  IN  HASH_API_CONTEXT  HashContext,
+  OUT HASH_API_CONTEXT  NewHashContext
+  )
+{
+  return CALL_BASECRYPTLIB (HashApi.Services.Duplicate, CryptoHashApiDuplicate, (HashPolicy, HashContext, NewHashContext), FALSE);
+}
+
+/**
+  Update hash data with the given hash algorithm.
+
+  @param[in] HashPolicy    Hash algorithm, one of the HASH_ALG_* values of
+                           PcdHashApiLibPolicy.
+  @param[in] HashContext   Hash context.
+  @param[in] DataToHash    Data to be hashed.
+  @param[in] DataToHashLen Data size.
+
+  @retval TRUE         Hash updated.
+  @retval FALSE        Hash updated unsuccessful.
+  @retval FALSE        The hash algorithm or this interface is not supported.
+
+**/
+BOOLEAN
+EFIAPI
+CryptoServiceHashApiUpdate (
+  IN UINT32            HashPolicy,
+  IN HASH_API_CONTEXT  HashContext,
+  IN VOID              *DataToHash,
+  IN UINTN             DataToHashLen
+  )
+{
+  return CALL_BASECRYPTLIB (HashApi.Services.Update, CryptoHashApiUpdate, (HashPolicy, HashContext, DataToHash, DataToHashLen), FALSE);
+}
+
+/**
+  Hash complete with the given hash algorithm.
+
+  @param[in]  HashPolicy   Hash algorithm, one of the HASH_ALG_* values of
+                           PcdHashApiLibPolicy.
+  @param[in]  HashContext  Hash context.
+  @param[out] Digest       Hash Digest.
+
+  @retval TRUE         Hash complete and Digest is returned.
+  @retval FALSE        Hash complete unsuccessful.
+  @retval FALSE        The hash algorithm or this interface is not supported.
+
+**/
+BOOLEAN
+EFIAPI
+CryptoServiceHashApiFinal (
+  IN  UINT32            HashPolicy,
+  IN  HASH_API_CONTEXT  HashContext,
+  OUT UINT8             *Digest
+  )
+{
+  return CALL_BASECRYPTLIB (HashApi.Services.Final, CryptoHashApiFinal, (HashPolicy, HashContext, Digest), FALSE);
+}
+
+/**
+  Computes hash message digest of a input data buffer with the given hash
+  algorithm.
+
+  @param[in]  HashPolicy     Hash algorithm, one of the HASH_ALG_* values of
+                             PcdHashApiLibPolicy.
+  @param[in]  DataToHash     Data to be hashed.
+  @param[in]  DataToHashLen  Data size.
+  @param[out] Digest         Hash Digest.
+
+  @retval TRUE   Hash digest computation succeeded.
+  @retval FALSE  Hash digest computation failed.
+  @retval FALSE  The hash algorithm or this interface is not supported.
+
+**/
+BOOLEAN
+EFIAPI
+CryptoServiceHashApiHashAll (
+  IN  UINT32      HashPolicy,
+  IN  CONST VOID  *DataToHash,
+  IN  UINTN       DataToHashLen,
+  OUT UINT8       *Digest
+  )
+{
+  return CALL_BASECRYPTLIB (HashApi.Services.HashAll, CryptoHashApiHashAll, (HashPolicy, DataToHash, DataToHashLen, Digest), FALSE);
+}
+
 const EDKII_CRYPTO_PROTOCOL mEdkiiCrypto = {
   /// Version
   CryptoServiceGetCryptoVersion,
@@ -4663,5 +5176,17 @@ const EDKII_CRYPTO_PROTOCOL mEdkiiCrypto = {
   CryptoServiceTlsGetCaCertificate,
   CryptoServiceTlsGetHostPublicCert,
   CryptoServiceTlsGetHostPrivateKey,
-  CryptoServiceTlsGetCertRevocationList
+  CryptoServiceTlsGetCertRevocationList,
+  /// RSA PSS
+  CryptoServiceRsaPssSign,
+  CryptoServiceRsaPssVerify,
+  /// Unified Hash API
+  CryptoServiceHashApiGetContextSize,
+  CryptoServiceHashApiInit,
+  CryptoServiceHashApiDuplicate,
+  CryptoServiceHashApiUpdate,
+  CryptoServiceHashApiFinal,
+  CryptoServiceHashApiHashAll,
+  /// TLS Set (version 9)
+  CryptoServiceTlsSetServerPort
 };
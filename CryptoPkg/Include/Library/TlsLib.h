@@ -416,6 +416,30 @@ TlsSetVerifyHost (
   IN     CHAR8                    *HostName
   );
 
+/**
+  Set the port of the server to be connected.
+
+  The client sessions of the TLS objects are cached for resumption. A cached
+  session is only resumed by a TLS object connecting to the same server, i.e.
+  with the same host name set by TlsSetVerifyHost() and the same port. The
+  port must be set before the handshake is started. A TLS object whose port is
+  not set only resumes the sessions cached with the port 0.
+
+  @param[in]  Tls           Pointer to the TLS object.
+  @param[in]  Port          The port of the server.
+
+  @retval  EFI_SUCCESS           The port was set successfully.
+  @retval  EFI_INVALID_PARAMETER The parameter is invalid.
+  @retval  EFI_UNSUPPORTED       The sessions are not cached.
+
+**/
+EFI_STATUS
+EFIAPI
+TlsSetServerPort (
+  IN     VOID                     *Tls,
+  IN     UINT16                   Port
+  );
+
 /**
   Sets a TLS/SSL session ID to be used during TLS/SSL connect.
 
@@ -267,6 +267,7 @@ typedef struct {
       UINT8  HostPublicCert:1;
       UINT8  HostPrivateKey:1;
       UINT8  CertRevocationList:1;
+      UINT8  ServerPort:1;
     } Services;
     UINT32    Family;
   } TlsSet;
@@ -288,6 +289,24 @@ typedef struct {
     } Services;
     UINT32    Family;
   } TlsGet;
+  union {
+    struct {
+      UINT8  Sign:1;
+      UINT8  Verify:1;
+    } Services;
+    UINT32    Family;
+  } RsaPss;
+  union {
+    struct {
+      UINT8  GetContextSize:1;
+      UINT8  Init:1;
+      UINT8  Duplicate:1;
+      UINT8  Update:1;
+      UINT8  Final:1;
+      UINT8  HashAll:1;
+    } Services;
+    UINT32    Family;
+  } HashApi;
 } PCD_CRYPTO_SERVICE_FAMILY_ENABLE;
 
 #endif
@@ -1,6 +1,6 @@
 /** @file
-  Implements the BaseCryptLib and TlsLib using the services of the EDK II Crypto
-  Protocol/PPI.
+  Implements the BaseCryptLib, TlsLib and HashApiLib using the services of the
+  EDK II Crypto Protocol/PPI.
 
   Copyright (C) Microsoft Corporation. All rights reserved.
   Copyright (c) 2019 - 2020, Intel Corporation. All rights reserved.<BR>
@@ -11,8 +11,10 @@
 #include <Base.h>
 #include <Library/BaseLib.h>
 #include <Library/DebugLib.h>
+#include <Library/PcdLib.h>
 #include <Library/BaseCryptLib.h>
 #include <Library/TlsLib.h>
+#include <Library/HashApiLib.h>
 #include <Protocol/Crypto.h>
 
 /**
@@ -3130,6 +3132,33 @@ TlsSetVerifyHost (
   CALL_CRYPTO_SERVICE (TlsSetVerifyHost, (Tls, Flags, HostName), EFI_UNSUPPORTED);
 }
 
+/**
+  Set the port of the server to be connected.
+
+  The client sessions of the TLS objects are cached for resumption. A cached
+  session is only resumed by a TLS object connecting to the same server, i.e.
+  with the same host name set by TlsSetVerifyHost() and the same port. The
+  port must be set before the handshake is started. A TLS object whose port is
+  not set only resumes the sessions cached with the port 0.
+
+  @param[in]  Tls           Pointer to the TLS object.
+  @param[in]  Port          The port of the server.
+
+  @retval  EFI_SUCCESS           The port was set successfully.
+  @retval  EFI_INVALID_PARAMETER The parameter is invalid.
+  @retval  EFI_UNSUPPORTED       The sessions are not cached.
+
+**/
+EFI_STATUS
+EFIAPI
+TlsSetServerPort (
+  IN     VOID                     *Tls,
+  IN     UINT16                   Port
+  )
+{
+  CALL_CRYPTO_SERVICE (TlsSetServerPort, (Tls, Port), EFI_UNSUPPORTED);
+}
+
 /**
   Sets a TLS/SSL session ID to be used during TLS/SSL connect.
 
@@ -3577,3 +3606,122 @@ TlsGetCertRevocationList (
 {
   CALL_CRYPTO_SERVICE (TlsGetCertRevocationList, (Data, DataSize), EFI_UNSUPPORTED);
 }
+
+/**
+  Retrieves the size, in bytes, of the context buffer required for hash operations.
+
+  The hash algorithm is the one selected by PcdHashApiLibPolicy of this module.
+
+  @return  The size, in bytes, of the context buffer required for hash operations.
+  @return  Zero if this interface is not supported.
+**/
+UINTN
+EFIAPI
+HashApiGetContextSize (
+  VOID
+  )
+{
+  CALL_CRYPTO_SERVICE (HashApiGetContextSize, (PcdGet32 (PcdHashApiLibPolicy)), 0);
+}
+
+/**
+  Init hash sequence.
+
+  @param[out] HashContext   Hash context.
+
+  @retval TRUE         Hash start and HashHandle returned.
+  @retval FALSE        Hash Init unsuccessful.
+  @retval FALSE        This interface is not supported.
+**/
+BOOLEAN
+EFIAPI
+HashApiInit (
+  OUT HASH_API_CONTEXT  HashContext
+  )
+{
+  CALL_CRYPTO_SERVICE (HashApiInit, (PcdGet32 (PcdHashApiLibPolicy), HashContext), FALSE);
+}
+
+/**
+  Makes a copy of an existing hash context.
+
+  @param[in]  HashContext     Hash context.
+  @param[out] NewHashContext  New copy of hash context.
+
+  @retval TRUE         Hash context copy succeeded.
+  @retval FALSE        Hash context copy failed.
+  @retval FALSE        This interface is not supported.
+**/
+BOOLEAN
+EFIAPI
+HashApiDuplicate (
+  IN  HASH_API_CONTEXT  HashContext,
+  OUT HASH_API_CONTEXT  NewHashContext
+  )
+{
+  CALL_CRYPTO_SERVICE (HashApiDuplicate, (PcdGet32 (PcdHashApiLibPolicy), HashContext, NewHashContext), FALSE);
+}
+
+/**
+  Update hash data.
+
+  @param[in] HashContext   Hash context.
+  @param[in] DataToHash    Data to be hashed.
+  @param[in] DataToHashLen Data size.
+
+  @retval TRUE         Hash updated.
+  @retval FALSE        Hash updated unsuccessful.
+  @retval FALSE        This interface is not supported.
+**/
+BOOLEAN
+EFIAPI
+HashApiUpdate (
+  IN HASH_API_CONTEXT  HashContext,
+  IN VOID              *DataToHash,
+  IN UINTN             DataToHashLen
+  )
+{
+  CALL_CRYPTO_SERVICE (HashApiUpdate, (PcdGet32 (PcdHashApiLibPolicy), HashContext, DataToHash, DataToHashLen), FALSE);
+}
+
+/**
+  Hash complete.
+
+  @param[in]  HashContext  Hash context.
+  @param[out] Digest       Hash Digest.
+
+  @retval TRUE         Hash complete and Digest is returned.
+  @retval FALSE        Hash complete unsuccessful.
+  @retval FALSE        This interface is not supported.
+**/
+BOOLEAN
+EFIAPI
+HashApiFinal (
+  IN  HASH_API_CONTEXT  HashContext,
+  OUT UINT8             *Digest
+  )
+{
+  CALL_CRYPTO_SERVICE (HashApiFinal, (PcdGet32 (PcdHashApiLibPolicy), HashContext, Digest), FALSE);
+}
+
+/**
+  Computes hash message digest of a input data buffer.
+
+  @param[in]  DataToHash     Data to be hashed.
+  @param[in]  DataToHashLen  Data size.
+  @param[out] Digest         Hash Digest.
+
+  @retval TRUE   Hash digest computation succeeded.
+  @retval FALSE  Hash digest computation failed.
+  @retval FALSE  This interface is not supported.
+**/
+BOOLEAN
+EFIAPI
+HashApiHashAll (
+  IN  CONST VOID  *DataToHash,
+  IN  UINTN       DataToHashLen,
+  OUT UINT8       *Digest
+  )
+{
+  CALL_CRYPTO_SERVICE (HashApiHashAll, (PcdGet32 (PcdHashApiLibPolicy), DataToHash, DataToHashLen, Digest), FALSE);
+}
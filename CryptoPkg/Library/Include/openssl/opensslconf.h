@@ -112,7 +112,7 @@ extern "C" {
 #ifndef OPENSSL_NO_ASAN
 # define OPENSSL_NO_ASAN
 #endif
-#ifndef OPENSSL_NO_ASM
+#if !defined(OPENSSL_NO_ASM) && !defined(EDK2_OPENSSL_ASM)
 # define OPENSSL_NO_ASM
 #endif
 #ifndef OPENSSL_NO_ASYNC
@@ -0,0 +1,60 @@
+/** @file
+  AARCH64 CPU feature detection for the OpenSSL assembly back ends.
+
+  OpenSSL's armcap.c probes the CPU features with getauxval() or by catching
+  SIGILL, neither of which exists in UEFI. Read the instruction set attribute
+  register instead, which is accessible at EL1 and EL2.
+
+  Copyright (c) 2026, agent. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "../openssl/crypto/arm_arch.h"
+
+#include <Base.h>
+
+#define ID_AA64ISAR0_AES(Isar)   (((Isar) >> 4) & 0xF)
+#define ID_AA64ISAR0_SHA1(Isar)  (((Isar) >> 8) & 0xF)
+#define ID_AA64ISAR0_SHA2(Isar)  (((Isar) >> 12) & 0xF)
+
+unsigned int  OPENSSL_armcap_P = 0;
+
+/**
+  Fill in OPENSSL_armcap_P from ID_AA64ISAR0_EL1.
+
+  Advanced SIMD is always enabled in UEFI on AARCH64. An OPENSSL_armcap
+  environment override is not supported.
+
+**/
+void
+OPENSSL_cpuid_setup (
+  void
+  )
+{
+  UINT64  Isar0;
+
+  __asm__ ("mrs %0, id_aa64isar0_el1" : "=r" (Isar0));
+
+  OPENSSL_armcap_P = ARMV7_NEON;
+
+  if (ID_AA64ISAR0_AES (Isar0) >= 1) {
+    OPENSSL_armcap_P |= ARMV8_AES;
+  }
+
+  if (ID_AA64ISAR0_AES (Isar0) >= 2) {
+    OPENSSL_armcap_P |= ARMV8_PMULL;
+  }
+
+  if (ID_AA64ISAR0_SHA1 (Isar0) >= 1) {
+    OPENSSL_armcap_P |= ARMV8_SHA1;
+  }
+
+  if (ID_AA64ISAR0_SHA2 (Isar0) >= 1) {
+    OPENSSL_armcap_P |= ARMV8_SHA256;
+  }
+
+  if (ID_AA64ISAR0_SHA2 (Isar0) >= 2) {
+    OPENSSL_armcap_P |= ARMV8_SHA512;
+  }
+}
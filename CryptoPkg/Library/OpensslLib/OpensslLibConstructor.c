@@ -0,0 +1,36 @@
+/** @file
+  Constructor of the OpenSSL library with assembly back ends.
+
+  OpenSSL relies on the .init section of the ELF and the CRT initializers of
+  PE/COFF images to probe the CPU features before any cipher or digest is
+  used. Neither is run in UEFI images, so do it from the library constructor.
+
+  Copyright (c) 2026, agent. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "internal/cryptlib.h"
+
+#include <Uefi.h>
+
+/**
+  Probe the CPU features used to select the OpenSSL assembly code paths.
+
+  OPENSSL_cpuid_setup() only executes the CPUID instruction on X64 and reads
+  the ID registers on AARCH64, so it is safe to call in PEI, DXE and SMM. The
+  AVX code paths are only enabled when the XSAVE state is enabled in CR4.
+
+  @retval RETURN_SUCCESS  The CPU features have been probed.
+
+**/
+RETURN_STATUS
+EFIAPI
+OpensslLibConstructor (
+  VOID
+  )
+{
+  OPENSSL_cpuid_setup ();
+
+  return RETURN_SUCCESS;
+}
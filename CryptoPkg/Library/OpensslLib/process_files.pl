@@ -1,9 +1,13 @@
 #!/usr/bin/perl -w
 #
 # This script runs the OpenSSL Configure script, then processes the
-# resulting file list into our local OpensslLib[Crypto].inf and also
+# resulting file list into our local OpensslLib[Crypto|Accel].inf and also
 # takes copies of opensslconf.h and dso_conf.h.
 #
+# The X64 and AARCH64 assembly sources used by OpensslLibAccel.inf are
+# generated from the OpenSSL perlasm scripts into the X64 and AArch64
+# directories.
+#
 # This only needs to be done once by a developer when updating to a
 # new version of OpenSSL (or changing options, etc.). Normal users
 # do not need to do this, since the results are stored in the EDK2
@@ -260,11 +264,217 @@ rename( $new_inf_file, $inf_file ) ||
 print "Done!";
 
 #
-# Copy opensslconf.h and dso_conf.h generated from OpenSSL Configuration
+# Generate the assembly sources of OpensslLibAccel.inf. Only the hash,
+# AES and GHASH back ends are used: the bignum code keeps the portable
+# C implementation, since the THIRTY_TWO_BIT limb size in opensslconf.h
+# is shared with OpensslLib.inf.
+#
+# Each entry is the perlasm script and the output file name without
+# extension. sha512-*.pl generates the SHA-256 code when the output
+# file name doesn't contain "512".
+#
+my %asm_files = (
+    "X64" => [
+        [ "crypto/x86_64cpuid.pl",                "crypto/x86_64cpuid" ],
+        [ "crypto/aes/asm/aesni-x86_64.pl",       "crypto/aes/aesni-x86_64" ],
+        [ "crypto/aes/asm/aesni-mb-x86_64.pl",    "crypto/aes/aesni-mb-x86_64" ],
+        [ "crypto/aes/asm/aesni-sha1-x86_64.pl",  "crypto/aes/aesni-sha1-x86_64" ],
+        [ "crypto/aes/asm/aesni-sha256-x86_64.pl", "crypto/aes/aesni-sha256-x86_64" ],
+        [ "crypto/aes/asm/vpaes-x86_64.pl",       "crypto/aes/vpaes-x86_64" ],
+        [ "crypto/modes/asm/aesni-gcm-x86_64.pl", "crypto/modes/aesni-gcm-x86_64" ],
+        [ "crypto/modes/asm/ghash-x86_64.pl",     "crypto/modes/ghash-x86_64" ],
+        [ "crypto/sha/asm/sha1-x86_64.pl",        "crypto/sha/sha1-x86_64" ],
+        [ "crypto/sha/asm/sha1-mb-x86_64.pl",     "crypto/sha/sha1-mb-x86_64" ],
+        [ "crypto/sha/asm/sha256-mb-x86_64.pl",   "crypto/sha/sha256-mb-x86_64" ],
+        [ "crypto/sha/asm/sha512-x86_64.pl",      "crypto/sha/sha256-x86_64" ],
+        [ "crypto/sha/asm/sha512-x86_64.pl",      "crypto/sha/sha512-x86_64" ],
+    ],
+    "AARCH64" => [
+        [ "crypto/arm64cpuid.pl",                 "crypto/arm64cpuid" ],
+        [ "crypto/aes/asm/aesv8-armx.pl",         "crypto/aes/aesv8-armx" ],
+        [ "crypto/aes/asm/vpaes-armv8.pl",        "crypto/aes/vpaes-armv8" ],
+        [ "crypto/modes/asm/ghashv8-armx.pl",     "crypto/modes/ghashv8-armx" ],
+        [ "crypto/sha/asm/sha1-armv8.pl",         "crypto/sha/sha1-armv8" ],
+        [ "crypto/sha/asm/sha512-armv8.pl",       "crypto/sha/sha256-armv8" ],
+        [ "crypto/sha/asm/sha512-armv8.pl",       "crypto/sha/sha512-armv8" ],
+    ],
+);
+
+#
+# perlasm flavours per architecture: [flavour, extension, toolchain families].
+#
+# Each toolchain must get exactly one flavour. The INF source family matches
+# both the FAMILY and the BUILDRULEFAMILY of a toolchain, so the GCC family
+# also matches CLANGPDB (PE/COFF, Microsoft x64 ABI) and XCODE5 (Mach-O).
+# The ELF flavour is therefore restricted to the toolchain tags producing
+# ELF objects, CLANGPDB uses the NASM flavour and XCODE5 builds the C code.
+#
+my %asm_flavours = (
+    "X64"     => [
+        [ "nasm", "nasm", [ "MSFT", "INTEL", "CLANGPDB" ] ],
+        [ "elf", "S", [ "GCC | GCC48", "GCC | GCC49", "GCC | GCC5", "GCC | CLANG38", "GCC | CLANGDWARF" ] ],
+    ],
+    "AARCH64" => [
+        [ "linux64", "S", [ "GCC | GCC48", "GCC | GCC49", "GCC | GCC5", "GCC | CLANG35", "GCC | CLANG38" ] ],
+    ],
+);
+
+#
+# C sources of the toolchains building the assembly back ends, and of the
+# ones building the portable C code instead. mem_clr.c implements
+# OPENSSL_cleanse(), which the *cpuid assembly files provide otherwise.
+#
+my %asm_c_files = (
+    "X64"     => [],
+    "AARCH64" => [ [ "AArch64/ArmCap.c", [ "GCC | GCC48", "GCC | GCC49", "GCC | GCC5", "GCC | CLANG35", "GCC | CLANG38" ] ] ],
+);
+my %noasm_c_files = (
+    "X64"     => [ [ '$(OPENSSL_PATH)/crypto/mem_clr.c', [ "XCODE" ] ] ],
+    "AARCH64" => [ [ '$(OPENSSL_PATH)/crypto/mem_clr.c', [ "MSFT" ] ] ],
+);
+
+#
+# Compiler flags of the toolchains building the assembly back ends.
+#
+my $asm_flags = "-DEDK2_OPENSSL_ASM -DOPENSSL_CPUID_OBJ -DSHA1_ASM -DSHA256_ASM -DSHA512_ASM -DGHASH_ASM";
+my %asm_arch_flags = (
+    "X64"     => $asm_flags . " -DAESNI_ASM -DVPAES_ASM",
+    "AARCH64" => $asm_flags . " -DVPAES_ASM",
+);
+
+my %asm_dirs = (
+    "X64"     => "X64",
+    "AARCH64" => "AArch64",
+);
+
+my %asmfilelist = ();
+foreach my $arch (sort keys %asm_files) {
+    print "\n--> Generating $arch assembly sources ... ";
+    $asmfilelist{$arch} = [];
+    my %generated = ();
+    foreach my $c (@{$asm_c_files{$arch}}, @{$noasm_c_files{$arch}}) {
+        my ($file, $families) = @{$c};
+        foreach my $family (@{$families}) {
+            push @{$asmfilelist{$arch}}, '  ' . $file . " | " . $family . "\r\n";
+        }
+    }
+    foreach my $flavour (@{$asm_flavours{$arch}}) {
+        my ($scheme, $ext, $families) = @{$flavour};
+        foreach my $asm (@{$asm_files{$arch}}) {
+            my ($generator, $target) = @{$asm};
+            my $file = $asm_dirs{$arch} . "/" . $target . "." . $ext;
+
+            foreach my $family (@{$families}) {
+                push @{$asmfilelist{$arch}}, '  ' . $file . " | " . $family . "\r\n";
+            }
+            next if ($generated{$file});
+            $generated{$file} = 1;
+
+            (my $outdir = $file) =~ s/\/[^\/]+$//;
+            system("mkdir -p " . $outdir) == 0 ||
+                die "Cannot create \"" . $outdir . "\"!";
+            system(
+                "perl " . $OPENSSL_PATH . "/" . $generator . " " .
+                $scheme . " " . $file
+                ) == 0 ||
+                    die "Failed to generate " . $file . "!\n";
+
+            #
+            # UEFI images have no .init section to run OPENSSL_cpuid_setup()
+            # from, the library constructor calls it instead. arm_arch.h is
+            # not on the include path, so refer to it by its relative path.
+            #
+            my $depth = ($target =~ tr/\///) + 1;
+            my $arm_arch = ("../" x $depth) . $OPENSSL_PATH . "/crypto/arm_arch.h";
+            open( FD, "<" . $file ) || die $file;
+            my @asm = (<FD>);
+            close(FD) || die $file;
+            my $text = join ("", @asm);
+            $text =~ s/\.section\s+\.init\s*\n\s*call\s+OPENSSL_cpuid_setup\s*\n//g;
+            $text =~ s/#include\s+"arm_arch\.h"/#include "$arm_arch"/g;
+            $text =~ s/\r?\n/\r\n/g;
+            open( FD, ">" . $file ) || die $file;
+            binmode(FD);
+            print( FD $text ) || die $file;
+            close(FD) || die $file;
+        }
+    }
+    print "Done!";
+}
+
+#
+# Update OpensslLibAccel.inf with the common file list, less the C code
+# replaced by the assembly back ends, the per-architecture lists and the
+# compiler flags enabling the assembly back ends.
+#
+$inf_file = "OpensslLibAccel.inf";
+
+@inf = ();
+@new_inf = ();
+open( FD, "<" . $inf_file ) ||
+    die "Cannot open \"" . $inf_file . "\"!";
+@inf = (<FD>);
+close(FD) ||
+    die "Cannot close \"" . $inf_file . "\"!";
+
+my @accelfilelist = grep { !/crypto\/mem_clr\.c/ } (@cryptofilelist, @sslfilelist);
+
+$subbing = 0;
+print "\n--> Updating OpensslLibAccel.inf ... ";
+foreach (@inf) {
+    if ( $_ =~ /# Autogenerated assembly flags starts here/ ) {
+        push @new_inf, $_;
+        foreach my $arch (sort keys %asm_arch_flags) {
+            push @new_inf, sprintf ("  DEFINE %-25s = %s\r\n", "OPENSSL_" . $arch . "_ASM_FLAGS", $asm_arch_flags{$arch});
+        }
+        $subbing = 1;
+        next;
+    }
+    if ( $_ =~ /# Autogenerated assembly flags ends here/ ) {
+        push @new_inf, $_;
+        $subbing = 0;
+        next;
+    }
+    if ( $_ =~ /# Autogenerated (\w+ )?files list starts here/ ) {
+        if (defined $1) {
+            (my $arch = $1) =~ s/\s+$//;
+            push @new_inf, $_, @{$asmfilelist{$arch}};
+        } else {
+            push @new_inf, $_, @accelfilelist;
+        }
+        $subbing = 1;
+        next;
+    }
+    if ( $_ =~ /# Autogenerated (\w+ )?files list ends here/ ) {
+        push @new_inf, $_;
+        $subbing = 0;
+        next;
+    }
+
+    push @new_inf, $_
+        unless ($subbing);
+}
+
+$new_inf_file = $inf_file . ".new";
+open( FD, ">" . $new_inf_file ) ||
+    die $new_inf_file;
+print( FD @new_inf ) ||
+    die $new_inf_file;
+close(FD) ||
+    die $new_inf_file;
+rename( $new_inf_file, $inf_file ) ||
+    die "rename $inf_file";
+print "Done!";
+
+#
+# Copy opensslconf.h and dso_conf.h generated from OpenSSL Configuration.
+# OPENSSL_NO_ASM is left undefined for OpensslLibAccel.inf, which builds
+# with EDK2_OPENSSL_ASM.
 #
 print "\n--> Duplicating opensslconf.h into Include/openssl ... ";
 system(
-    "perl -pe 's/\\n/\\r\\n/' " .
+    "perl -pe 's/\\n/\\r\\n/; " .
+    "s/^#ifndef OPENSSL_NO_ASM\\r\$/#if !defined(OPENSSL_NO_ASM) && !defined(EDK2_OPENSSL_ASM)\\r/' " .
     "< " . $OPENSSL_PATH . "/include/openssl/opensslconf.h " .
     "> " . $OPENSSL_PATH . "/../../Include/openssl/opensslconf.h"
     ) == 0 ||
@@ -13,6 +13,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #undef _WIN64
 
 #include <Library/BaseCryptLib.h>
+#include <Library/BaseLib.h>
 #include <Library/BaseMemoryLib.h>
 #include <Library/DebugLib.h>
 #include <Library/MemoryAllocationLib.h>
@@ -35,7 +36,126 @@ typedef struct {
   // Memory BIO for the TLS/SSL Writing operations.
   //
   BIO                             *OutBio;
+  //
+  // Name and port of the server which is connected, used as session cache key.
+  //
+  CHAR8                           *HostName;
+  UINT16                          Port;
 } TLS_CONNECTION;
 
+//
+// Maximum number of client sessions kept for resumption.
+//
+#define TLS_SESSION_CACHE_SIZE    8
+
+typedef struct {
+  //
+  // Server name and port which the session was established with.
+  //
+  CHAR8                           *HostName;
+  UINT16                          Port;
+  //
+  // The resumable session, NULL if the slot is free.
+  //
+  SSL_SESSION                     *Session;
+  //
+  // Last use of the slot, for the least recently used eviction.
+  //
+  UINT64                          Age;
+} TLS_SESSION_CACHE_ENTRY;
+
+/**
+  Check whether a cache slot holds a session of the server of the TLS
+  connection.
+
+  Sessions are only shared between connections to the same host name and
+  port, as different ports of a host may be served by different servers.
+
+  @param[in]  Entry      Pointer to the cache slot.
+  @param[in]  TlsConn    Pointer to the TLS connection.
+
+  @retval  TRUE   The slot holds a session of the server.
+  @retval  FALSE  The slot is free or holds a session of another server.
+
+**/
+BOOLEAN
+TlsSessionCacheMatch (
+  IN     TLS_SESSION_CACHE_ENTRY  *Entry,
+  IN     TLS_CONNECTION           *TlsConn
+  );
+
+/**
+  Callback invoked by OpenSSL each time a new client session (or TLS 1.3
+  session ticket) is available for the connection.
+
+  The session replaces the one cached for the same server. If the
+  cache is full, the least recently used session is evicted.
+
+  @param[in]  Ssl        Pointer to the SSL object of the connection.
+  @param[in]  Session    Pointer to the new SSL_SESSION object.
+
+  @retval  1   The cache took a reference of Session.
+  @retval  0   Session is not cached.
+
+**/
+int
+TlsSessionNewCallback (
+  IN     SSL                      *Ssl,
+  IN     SSL_SESSION              *Session
+  );
+
+/**
+  Resume the session cached for the server of the TLS connection.
+
+  This is only done before the handshake is started, and only if no session
+  was explicitly assigned to the connection.
+
+  @param[in]  TlsConn    Pointer to the TLS connection.
+
+  @retval  TRUE   A cached session is set to the connection.
+  @retval  FALSE  No session is cached for the server.
+
+**/
+BOOLEAN
+TlsSessionCacheResume (
+  IN     TLS_CONNECTION           *TlsConn
+  );
+
+/**
+  Resume the cached session identified by the session ID.
+
+  Only the sessions cached for the server of the TLS connection are looked
+  up, so that a session is never offered to another server.
+
+  @param[in]  TlsConn         Pointer to the TLS connection.
+  @param[in]  SessionId       Session ID of the session to be resumed.
+  @param[in]  SessionIdLen    Length of Session ID in bytes.
+
+  @retval  EFI_SUCCESS           The cached session is set to the connection.
+  @retval  EFI_NOT_FOUND         No session with this ID is cached for the server.
+  @retval  EFI_ABORTED           The session can't be set to the connection.
+
+**/
+EFI_STATUS
+TlsSessionCacheResumeById (
+  IN     TLS_CONNECTION           *TlsConn,
+  IN     UINT8                    *SessionId,
+  IN     UINT16                   SessionIdLen
+  );
+
+/**
+  Drop the session cached for the server of the TLS connection.
+
+  This is used when the resumption of the cached session failed, so that the
+  following connections perform a full handshake.
+
+  @param[in]  TlsConn    Pointer to the TLS connection.
+
+**/
+VOID
+TlsSessionCacheRemove (
+  IN     TLS_CONNECTION           *TlsConn
+  );
+
 #endif
 
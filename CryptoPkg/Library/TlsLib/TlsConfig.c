@@ -530,6 +530,17 @@ TlsSetVerifyHost (
 
   SSL_set_hostflags(TlsConn->Ssl, Flags);
 
+  //
+  // Remember the server name as part of the key of the session cache.
+  //
+  if (TlsConn->HostName != NULL) {
+    OPENSSL_free (TlsConn->HostName);
+  }
+  TlsConn->HostName = OPENSSL_strdup (HostName);
+  if (TlsConn->HostName == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
   VerifyParam = SSL_get0_param (TlsConn->Ssl);
   ASSERT (VerifyParam != NULL);
 
@@ -553,6 +564,42 @@ TlsSetVerifyHost (
   return (ParamStatus == 1) ? EFI_SUCCESS : EFI_ABORTED;
 }
 
+/**
+  Set the port of the server to be connected.
+
+  The client sessions of the TLS objects are cached for resumption. A cached
+  session is only resumed by a TLS object connecting to the same server, i.e.
+  with the same host name set by TlsSetVerifyHost() and the same port. The
+  port must be set before the handshake is started. A TLS object whose port is
+  not set only resumes the sessions cached with the port 0.
+
+  @param[in]  Tls           Pointer to the TLS object.
+  @param[in]  Port          The port of the server.
+
+  @retval  EFI_SUCCESS           The port was set successfully.
+  @retval  EFI_INVALID_PARAMETER The parameter is invalid.
+  @retval  EFI_UNSUPPORTED       The sessions are not cached.
+
+**/
+EFI_STATUS
+EFIAPI
+TlsSetServerPort (
+  IN     VOID                     *Tls,
+  IN     UINT16                   Port
+  )
+{
+  TLS_CONNECTION  *TlsConn;
+
+  TlsConn = (TLS_CONNECTION *) Tls;
+  if (TlsConn == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  TlsConn->Port = Port;
+
+  return EFI_SUCCESS;
+}
+
 /**
   Sets a TLS/SSL session ID to be used during TLS/SSL connect.
 
@@ -588,6 +635,13 @@ TlsSetSessionId (
 
   Session = SSL_get_session (TlsConn->Ssl);
   if (Session == NULL) {
+    //
+    // The handshake is not started yet, resume the cached session with this ID.
+    //
+    if (TlsSessionCacheResumeById (TlsConn, SessionId, SessionIdLen) == EFI_SUCCESS) {
+      return EFI_SUCCESS;
+    }
+
     return EFI_UNSUPPORTED;
   }
 
@@ -106,6 +106,17 @@ TlsCtxNew (
   //
   SSL_CTX_set_min_proto_version (TlsCtx, ProtoVersion);
 
+  //
+  // Keep the client sessions in the session cache of this library rather
+  // than the internal store of the context, so that they can be looked up
+  // by server name for resumption.
+  //
+  SSL_CTX_set_session_cache_mode (
+    TlsCtx,
+    SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE
+    );
+  SSL_CTX_sess_set_new_cb (TlsCtx, TlsSessionNewCallback);
+
   return (VOID *) TlsCtx;
 }
 
@@ -138,6 +149,10 @@ TlsFree (
     SSL_free (TlsConn->Ssl);
   }
 
+  if (TlsConn->HostName != NULL) {
+    OPENSSL_free (TlsConn->HostName);
+  }
+
   OPENSSL_free (Tls);
 }
 
@@ -174,7 +189,9 @@ TlsNew (
     return NULL;
   }
 
-  TlsConn->Ssl = NULL;
+  TlsConn->Ssl      = NULL;
+  TlsConn->HostName = NULL;
+  TlsConn->Port     = 0;
 
   //
   // Create a new SSL Object
@@ -185,6 +202,11 @@ TlsNew (
     return NULL;
   }
 
+  //
+  // Link the TLS connection to the SSL object for the session cache callback.
+  //
+  SSL_set_app_data (TlsConn->Ssl, TlsConn);
+
   //
   // This retains compatibility with previous version of OpenSSL.
   //
@@ -104,6 +104,10 @@ TlsDoHandshake (
     //
     PendingBufferSize = (UINTN) BIO_ctrl_pending (TlsConn->OutBio);
     if (PendingBufferSize == 0) {
+      //
+      // Offer the session cached for this server, if any, for an abbreviated handshake.
+      //
+      TlsSessionCacheResume (TlsConn);
       SSL_set_connect_state (TlsConn->Ssl);
       Ret = SSL_do_handshake (TlsConn->Ssl);
       PendingBufferSize = (UINTN) BIO_ctrl_pending (TlsConn->OutBio);
@@ -146,6 +150,10 @@ TlsDoHandshake (
             ));
         }
       DEBUG_CODE_END ();
+      //
+      // Don't offer the same session again if the failure happened in a resumption.
+      //
+      TlsSessionCacheRemove (TlsConn);
       return EFI_ABORTED;
     }
   }
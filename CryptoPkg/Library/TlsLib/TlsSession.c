@@ -0,0 +1,255 @@
+/** @file
+  SSL/TLS Session Cache Wrapper Implementation over OpenSSL.
+
+  The client sessions established by the TLS connections of this module are
+  kept in a small cache keyed by the server name and port, so that a later
+  connection to the same server can resume the session with an abbreviated
+  handshake (session ID or session ticket) instead of a full asymmetric
+  handshake.
+
+Copyright (c) 2026, agent. All rights reserved.<BR>
+SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "InternalTlsLib.h"
+
+//
+// The cached client sessions. A slot is free if its Session is NULL.
+//
+TLS_SESSION_CACHE_ENTRY  mTlsSessionCache[TLS_SESSION_CACHE_SIZE];
+
+//
+// Monotonic counter used to find the least recently used slot.
+//
+UINT64                   mTlsSessionCacheAge;
+
+/**
+  Release the session held by one cache slot.
+
+  @param[in, out]  Entry    Pointer to the cache slot to be released.
+
+**/
+VOID
+TlsSessionCacheFreeEntry (
+  IN OUT TLS_SESSION_CACHE_ENTRY  *Entry
+  )
+{
+  if (Entry->Session != NULL) {
+    SSL_SESSION_free (Entry->Session);
+    Entry->Session = NULL;
+  }
+
+  if (Entry->HostName != NULL) {
+    OPENSSL_free (Entry->HostName);
+    Entry->HostName = NULL;
+  }
+
+  Entry->Port = 0;
+  Entry->Age  = 0;
+}
+
+/**
+  Check whether a cache slot holds a session of the server of the TLS
+  connection.
+
+  Sessions are only shared between connections to the same host name and
+  port, as different ports of a host may be served by different servers.
+
+  @param[in]  Entry      Pointer to the cache slot.
+  @param[in]  TlsConn    Pointer to the TLS connection.
+
+  @retval  TRUE   The slot holds a session of the server.
+  @retval  FALSE  The slot is free or holds a session of another server.
+
+**/
+BOOLEAN
+TlsSessionCacheMatch (
+  IN     TLS_SESSION_CACHE_ENTRY  *Entry,
+  IN     TLS_CONNECTION           *TlsConn
+  )
+{
+  return (BOOLEAN) (Entry->Session != NULL &&
+                    Entry->Port == TlsConn->Port &&
+                    AsciiStrCmp (Entry->HostName, TlsConn->HostName) == 0);
+}
+
+/**
+  Callback invoked by OpenSSL each time a new client session (or TLS 1.3
+  session ticket) is available for the connection.
+
+  The session replaces the one cached for the same server. If the
+  cache is full, the least recently used session is evicted.
+
+  @param[in]  Ssl        Pointer to the SSL object of the connection.
+  @param[in]  Session    Pointer to the new SSL_SESSION object.
+
+  @retval  1   The cache took a reference of Session.
+  @retval  0   Session is not cached.
+
+**/
+int
+TlsSessionNewCallback (
+  IN     SSL                      *Ssl,
+  IN     SSL_SESSION              *Session
+  )
+{
+  TLS_CONNECTION           *TlsConn;
+  TLS_SESSION_CACHE_ENTRY  *Entry;
+  TLS_SESSION_CACHE_ENTRY  *Victim;
+  UINTN                    Index;
+
+  TlsConn = (TLS_CONNECTION *) SSL_get_app_data (Ssl);
+  if (TlsConn == NULL || TlsConn->HostName == NULL ||
+      SSL_SESSION_is_resumable (Session) != 1) {
+    return 0;
+  }
+
+  //
+  // Prefer the slot of the same server, then a free slot, then the oldest one.
+  //
+  Entry  = NULL;
+  Victim = &mTlsSessionCache[0];
+  for (Index = 0; Index < TLS_SESSION_CACHE_SIZE; Index++) {
+    if (TlsSessionCacheMatch (&mTlsSessionCache[Index], TlsConn)) {
+      Entry = &mTlsSessionCache[Index];
+      break;
+    }
+
+    if (Victim->Session != NULL &&
+        (mTlsSessionCache[Index].Session == NULL ||
+         mTlsSessionCache[Index].Age < Victim->Age)) {
+      Victim = &mTlsSessionCache[Index];
+    }
+  }
+
+  if (Entry == NULL) {
+    Entry = Victim;
+  }
+
+  TlsSessionCacheFreeEntry (Entry);
+
+  Entry->HostName = OPENSSL_strdup (TlsConn->HostName);
+  if (Entry->HostName == NULL) {
+    return 0;
+  }
+
+  Entry->Port    = TlsConn->Port;
+  Entry->Session = Session;
+  Entry->Age     = ++mTlsSessionCacheAge;
+
+  return 1;
+}
+
+/**
+  Resume the session cached for the server of the TLS connection.
+
+  This is only done before the handshake is started, and only if no session
+  was explicitly assigned to the connection.
+
+  @param[in]  TlsConn    Pointer to the TLS connection.
+
+  @retval  TRUE   A cached session is set to the connection.
+  @retval  FALSE  No session is cached for the server.
+
+**/
+BOOLEAN
+TlsSessionCacheResume (
+  IN     TLS_CONNECTION           *TlsConn
+  )
+{
+  UINTN  Index;
+
+  if (TlsConn->HostName == NULL || SSL_get_session (TlsConn->Ssl) != NULL) {
+    return FALSE;
+  }
+
+  for (Index = 0; Index < TLS_SESSION_CACHE_SIZE; Index++) {
+    if (TlsSessionCacheMatch (&mTlsSessionCache[Index], TlsConn)) {
+      if (SSL_set_session (TlsConn->Ssl, mTlsSessionCache[Index].Session) != 1) {
+        return FALSE;
+      }
+
+      mTlsSessionCache[Index].Age = ++mTlsSessionCacheAge;
+      return TRUE;
+    }
+  }
+
+  return FALSE;
+}
+
+/**
+  Resume the cached session identified by the session ID.
+
+  Only the sessions cached for the server of the TLS connection are looked
+  up, so that a session is never offered to another server.
+
+  @param[in]  TlsConn         Pointer to the TLS connection.
+  @param[in]  SessionId       Session ID of the session to be resumed.
+  @param[in]  SessionIdLen    Length of Session ID in bytes.
+
+  @retval  EFI_SUCCESS           The cached session is set to the connection.
+  @retval  EFI_NOT_FOUND         No session with this ID is cached for the server.
+  @retval  EFI_ABORTED           The session can't be set to the connection.
+
+**/
+EFI_STATUS
+TlsSessionCacheResumeById (
+  IN     TLS_CONNECTION           *TlsConn,
+  IN     UINT8                    *SessionId,
+  IN     UINT16                   SessionIdLen
+  )
+{
+  UINTN        Index;
+  CONST UINT8  *CachedId;
+  UINT32       CachedIdLen;
+
+  if (TlsConn->HostName == NULL) {
+    return EFI_NOT_FOUND;
+  }
+
+  for (Index = 0; Index < TLS_SESSION_CACHE_SIZE; Index++) {
+    if (!TlsSessionCacheMatch (&mTlsSessionCache[Index], TlsConn)) {
+      continue;
+    }
+
+    CachedId = SSL_SESSION_get_id (mTlsSessionCache[Index].Session, &CachedIdLen);
+    if (CachedIdLen == SessionIdLen && CompareMem (CachedId, SessionId, SessionIdLen) == 0) {
+      if (SSL_set_session (TlsConn->Ssl, mTlsSessionCache[Index].Session) != 1) {
+        return EFI_ABORTED;
+      }
+
+      mTlsSessionCache[Index].Age = ++mTlsSessionCacheAge;
+      return EFI_SUCCESS;
+    }
+  }
+
+  return EFI_NOT_FOUND;
+}
+
+/**
+  Drop the session cached for the server of the TLS connection.
+
+  This is used when the resumption of the cached session failed, so that the
+  following connections perform a full handshake.
+
+  @param[in]  TlsConn    Pointer to the TLS connection.
+
+**/
+VOID
+TlsSessionCacheRemove (
+  IN     TLS_CONNECTION           *TlsConn
+  )
+{
+  UINTN  Index;
+
+  if (TlsConn->HostName == NULL) {
+    return;
+  }
+
+  for (Index = 0; Index < TLS_SESSION_CACHE_SIZE; Index++) {
+    if (TlsSessionCacheMatch (&mTlsSessionCache[Index], TlsConn)) {
+      TlsSessionCacheFreeEntry (&mTlsSessionCache[Index]);
+    }
+  }
+}
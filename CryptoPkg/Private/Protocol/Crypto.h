@@ -21,7 +21,7 @@
 /// the EDK II Crypto Protocol is extended, this version define must be
 /// increased.
 ///
-#define EDKII_CRYPTO_VERSION 7
+#define EDKII_CRYPTO_VERSION 9
 
 ///
 /// EDK II Crypto Protocol forward declaration
@@ -3014,6 +3014,30 @@ EFI_STATUS
   IN     CHAR8                    *HostName
   );
 
+/**
+  Set the port of the server to be connected.
+
+  The client sessions of the TLS objects are cached for resumption. A cached
+  session is only resumed by a TLS object connecting to the same server, i.e.
+  with the same host name set by TlsSetVerifyHost() and the same port. The
+  port must be set before the handshake is started. A TLS object whose port is
+  not set only resumes the sessions cached with the port 0.
+
+  @param[in]  Tls           Pointer to the TLS object.
+  @param[in]  Port          The port of the server.
+
+  @retval  EFI_SUCCESS           The port was set successfully.
+  @retval  EFI_INVALID_PARAMETER The parameter is invalid.
+  @retval  EFI_UNSUPPORTED       The sessions are not cached.
+
+**/
+typedef
+EFI_STATUS
+(EFIAPI* EDKII_CRYPTO_TLS_SET_SERVER_PORT)(
+  IN     VOID                     *Tls,
+  IN     UINT16                   Port
+  );
+
 /**
   Sets a TLS/SSL session ID to be used during TLS/SSL connect.
 
@@ -3482,7 +3506,133 @@ BOOLEAN
   IN  UINT16       SaltLen
   );
 
+/**
+  Retrieves the size, in bytes, of the context buffer required for hash
+  operations with the given hash algorithm.
+
+  The hash algorithm is passed by the caller, so that the digest matches the
+  caller's PcdHashApiLibPolicy rather than the one of the crypto driver.
+
+  @param[in]  HashPolicy   Hash algorithm, one of the HASH_ALG_* values of
+                           PcdHashApiLibPolicy.
+
+  @return  The size, in bytes, of the context buffer required for hash operations.
+  @return  Zero if the hash algorithm or this interface is not supported.
+
+**/
+typedef
+UINTN
+(EFIAPI* EDKII_CRYPTO_HASH_API_GET_CONTEXT_SIZE)(
+  IN UINT32  HashPolicy
+  );
+
+/**
+  Init hash sequence with the given hash algorithm.
+
+  @param[in]  HashPolicy    Hash algorithm, one of the HASH_ALG_* values of
+                            PcdHashApiLibPolicy.
+  @param[out] HashContext   Hash context.
+
+  @retval TRUE         Hash start and HashHandle returned.
+  @retval FALSE        Hash Init unsuccessful.
+  @retval FALSE        The hash algorithm or this interface is not supported.
+
+**/
+typedef
+BOOLEAN
+(EFIAPI* EDKII_CRYPTO_HASH_API_INIT)(
+  IN  UINT32  HashPolicy,
+  OUT VOID    *HashContext
+  );
+
+/**
+  Makes a copy of an existing hash context of the given hash algorithm.
+
+  @param[in]  HashPolicy      Hash algorithm, one of the HASH_ALG_* values of
+                              PcdHashApiLibPolicy.
+  @param[in]  HashContext     Hash context.
+  @param[out] NewHashContext  New copy of hash context.
+
+  @retval TRUE         Hash context copy succeeded.
+  @retval FALSE        Hash context copy failed.
+  @retval FALSE        The hash algorithm or this interface is not supported.
+
+**/
+typedef
+BOOLEAN
+(EFIAPI* EDKII_CRYPTO_HASH_API_DUPLICATE)(
+  IN  UINT32  HashPolicy,
+  IN  VOID    *HashContext,
+  OUT VOID    *NewHashContext
+  );
+
+/**
+  Update hash data with the given hash algorithm.
 
+  @param[in] HashPolicy    Hash algorithm, one of the HASH_ALG_* values of
+                           PcdHashApiLibPolicy.
+  @param[in] HashContext   Hash context.
+  @param[in] DataToHash    Data to be hashed.
+  @param[in] DataToHashLen Data size.
+
+  @retval TRUE         Hash updated.
+  @retval FALSE        Hash updated unsuccessful.
+  @retval FALSE        The hash algorithm or this interface is not supported.
+
+**/
+typedef
+BOOLEAN
+(EFIAPI* EDKII_CRYPTO_HASH_API_UPDATE)(
+  IN UINT32  HashPolicy,
+  IN VOID    *HashContext,
+  IN VOID    *DataToHash,
+  IN UINTN   DataToHashLen
+  );
+
+/**
+  Hash complete with the given hash algorithm.
+
+  @param[in]  HashPolicy   Hash algorithm, one of the HASH_ALG_* values of
+                           PcdHashApiLibPolicy.
+  @param[in]  HashContext  Hash context.
+  @param[out] Digest       Hash Digest.
+
+  @retval TRUE         Hash complete and Digest is returned.
+  @retval FALSE        Hash complete unsuccessful.
+  @retval FALSE        The hash algorithm or this interface is not supported.
+
+**/
+typedef
+BOOLEAN
+(EFIAPI* EDKII_CRYPTO_HASH_API_FINAL)(
+  IN  UINT32  HashPolicy,
+  IN  VOID    *HashContext,
+  OUT UINT8   *Digest
+  );
+
+/**
+  Computes hash message digest of a input data buffer with the given hash
+  algorithm.
+
+  @param[in]  HashPolicy     Hash algorithm, one of the HASH_ALG_* values of
+                             PcdHashApiLibPolicy.
+  @param[in]  DataToHash     Data to be hashed.
+  @param[in]  DataToHashLen  Data size.
+  @param[out] Digest         Hash Digest.
+
+  @retval TRUE   Hash digest computation succeeded.
+  @retval FALSE  Hash digest computation failed.
+  @retval FALSE  The hash algorithm or this interface is not supported.
+
+**/
+typedef
+BOOLEAN
+(EFIAPI* EDKII_CRYPTO_HASH_API_HASH_ALL)(
+  IN  UINT32      HashPolicy,
+  IN  CONST VOID  *DataToHash,
+  IN  UINTN       DataToHashLen,
+  OUT UINT8       *Digest
+  );
 
 ///
 /// EDK II Crypto Protocol
@@ -3671,6 +3821,15 @@ struct _EDKII_CRYPTO_PROTOCOL {
   /// RSA PSS
   EDKII_CRYPTO_RSA_PSS_SIGN                       RsaPssSign;
   EDKII_CRYPTO_RSA_PSS_VERIFY                     RsaPssVerify;
+  /// Unified Hash API
+  EDKII_CRYPTO_HASH_API_GET_CONTEXT_SIZE          HashApiGetContextSize;
+  EDKII_CRYPTO_HASH_API_INIT                      HashApiInit;
+  EDKII_CRYPTO_HASH_API_DUPLICATE                 HashApiDuplicate;
+  EDKII_CRYPTO_HASH_API_UPDATE                    HashApiUpdate;
+  EDKII_CRYPTO_HASH_API_FINAL                     HashApiFinal;
+  EDKII_CRYPTO_HASH_API_HASH_ALL                  HashApiHashAll;
+  /// TLS Set (version 9)
+  EDKII_CRYPTO_TLS_SET_SERVER_PORT                TlsSetServerPort;
 };
 
 extern GUID gEdkiiCryptoProtocolGuid;
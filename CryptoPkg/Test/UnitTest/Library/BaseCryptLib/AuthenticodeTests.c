@@ -942,6 +942,12 @@ GLOBAL_REMOVE_IF_UNREFERENCED UINT8 HashOidValue[] = {
   0x60, 0x86, 0x48, 0x01, 0x65, 0x03, 0x04, 0x02, 0x03,   // OBJ_sha512
   };
 
+//
+// Sizes of the test data, for the crypto benchmarks that share it.
+//
+GLOBAL_REMOVE_IF_UNREFERENCED CONST UINTN AuthenticodeWithSha256Size = sizeof (AuthenticodeWithSha256);
+GLOBAL_REMOVE_IF_UNREFERENCED CONST UINTN TestRootCert2Size          = sizeof (TestRootCert2);
+
 UNIT_TEST_STATUS
 EFIAPI
 TestVerifyAuthenticodeVerify (
@@ -0,0 +1,262 @@
+/** @file
+  Benchmark of the BaseCryptLib primitives used during boot.
+
+  Every operation is repeated until it ran for BENCHMARK_MIN_CYCLES, and
+  reported both in a human readable table and as comma separated values,
+  one "BENCHMARK," line per measurement:
+
+    BENCHMARK,Provider,Operation,DataSize,Iterations,Cycles,Nanoseconds,
+    CyclesPerOperation,CyclesPerByte,OperationsPerSecond
+
+  Cycles are counted with the time stamp counter. Nanoseconds come from
+  TimerLib and are 0 if the platform has no usable timer.
+
+  Copyright (c) 2026, agent. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+#include "TestBaseCryptLibBenchmark.h"
+
+//
+// Input sizes of the data dependent operations: a network packet, a small
+// variable, a typical driver and a large image.
+//
+GLOBAL_REMOVE_IF_UNREFERENCED CONST UINTN mBenchmarkDataSizes[] = {
+  64, SIZE_1KB, SIZE_16KB, BENCHMARK_MAX_DATA_SIZE
+};
+
+typedef struct {
+  CHAR8           *Title;
+  UINTN           *BenchmarkNum;
+  BENCHMARK_DESC  *BenchmarkDesc;
+} BENCHMARK_SUITE_DESC;
+
+BENCHMARK_SUITE_DESC mBenchmarkSuite[] = {
+  //
+  // Title--------------------------Num-------------------Benchmarks
+  //
+  {"Hash and HMAC benchmarks",       &mHashBenchmarkNum,   mHashBenchmark},
+  {"Block cipher benchmarks",        &mCipherBenchmarkNum, mCipherBenchmark},
+  {"Public key benchmarks",          &mPkBenchmarkNum,     mPkBenchmark},
+};
+
+/**
+  Measure an operation on one input size.
+
+  @param[in]   Benchmark    The benchmark to run.
+  @param[in]   Context      The context returned by the setup of the benchmark.
+  @param[in]   Data         Input data.
+  @param[in]   DataSize     Size of the input data in bytes, 0 for operations
+                            that do not depend on the input.
+
+  @retval TRUE   The operation was measured.
+  @retval FALSE  The operation failed.
+
+**/
+BOOLEAN
+MeasureOperation (
+  IN BENCHMARK_DESC  *Benchmark,
+  IN VOID            *Context,
+  IN CONST UINT8     *Data,
+  IN UINTN           DataSize
+  )
+{
+  UINTN   Iterations;
+  UINTN   Index;
+  UINT64  StartCycles;
+  UINT64  Cycles;
+  UINT64  StartTicks;
+  UINT64  Nanoseconds;
+  UINT64  CyclesPerOperation;
+  UINT64  CyclesPerByteX100;
+  UINT64  OperationsPerSecond;
+
+  //
+  // Warm up the caches and let the provider do its lazy initialization.
+  //
+  if (!Benchmark->Operation (Context, Data, DataSize)) {
+    return FALSE;
+  }
+
+  //
+  // Double the iterations until the measurement is long enough to hide the
+  // resolution of the counters.
+  //
+  Iterations = 1;
+  while (TRUE) {
+    StartTicks  = GetPerformanceCounter ();
+    StartCycles = AsmReadTsc ();
+    for (Index = 0; Index < Iterations; Index++) {
+      if (!Benchmark->Operation (Context, Data, DataSize)) {
+        return FALSE;
+      }
+    }
+    Cycles      = AsmReadTsc () - StartCycles;
+    Nanoseconds = GetTimeInNanoSecond (GetPerformanceCounter () - StartTicks);
+
+    if ((Cycles >= BENCHMARK_MIN_CYCLES) || (Iterations >= BENCHMARK_MAX_ITERATIONS)) {
+      break;
+    }
+    Iterations *= 2;
+  }
+
+  CyclesPerOperation  = DivU64x64Remainder (Cycles, Iterations, NULL);
+  CyclesPerByteX100   = 0;
+  if (DataSize != 0) {
+    CyclesPerByteX100 = DivU64x64Remainder (MultU64x32 (Cycles, 100), MultU64x64 (Iterations, DataSize), NULL);
+  }
+  OperationsPerSecond = 0;
+  if (Nanoseconds != 0) {
+    OperationsPerSecond = DivU64x64Remainder (MultU64x32 (Iterations, 1000000000), Nanoseconds, NULL);
+  }
+
+  BenchmarkPrint (
+    "  %-20a %8d bytes %12ld cycles/op %6ld.%02ld cycles/byte %10ld ops/s\n",
+    Benchmark->Name,
+    (UINT32)DataSize,
+    CyclesPerOperation,
+    DivU64x32 (CyclesPerByteX100, 100),
+    ModU64x32 (CyclesPerByteX100, 100),
+    OperationsPerSecond
+    );
+  BenchmarkPrint (
+    "BENCHMARK,%a,%a,%d,%d,%ld,%ld,%ld,%ld.%02ld,%ld\n",
+    BENCHMARK_CRYPTO_PROVIDER,
+    Benchmark->Name,
+    (UINT32)DataSize,
+    (UINT32)Iterations,
+    Cycles,
+    Nanoseconds,
+    CyclesPerOperation,
+    DivU64x32 (CyclesPerByteX100, 100),
+    ModU64x32 (CyclesPerByteX100, 100),
+    OperationsPerSecond
+    );
+
+  return TRUE;
+}
+
+/**
+  Run one benchmark over all input sizes.
+
+  @param[in]  Benchmark  The benchmark to run.
+  @param[in]  Data       Input data, as large as the largest input size.
+
+  @retval EFI_SUCCESS      The benchmark was run or skipped.
+  @retval EFI_ABORTED      An operation of the benchmark failed.
+
+**/
+EFI_STATUS
+RunBenchmark (
+  IN BENCHMARK_DESC  *Benchmark,
+  IN CONST UINT8     *Data
+  )
+{
+  EFI_STATUS  Status;
+  VOID        *Context;
+  UINTN       Index;
+
+  Context = NULL;
+  if ((Benchmark->Setup != NULL) && !Benchmark->Setup (&Context)) {
+    BenchmarkPrint ("  %-20a skipped, not supported by the crypto provider\n", Benchmark->Name);
+    return EFI_SUCCESS;
+  }
+
+  Status = EFI_SUCCESS;
+  if (Benchmark->DataDependent) {
+    for (Index = 0; Index < ARRAY_SIZE (mBenchmarkDataSizes); Index++) {
+      if (!MeasureOperation (Benchmark, Context, Data, mBenchmarkDataSizes[Index])) {
+        Status = EFI_ABORTED;
+        break;
+      }
+    }
+  } else if (!MeasureOperation (Benchmark, Context, Data, 0)) {
+    Status = EFI_ABORTED;
+  }
+
+  if (EFI_ERROR (Status)) {
+    BenchmarkPrint ("  %-20a failed\n", Benchmark->Name);
+  }
+
+  if (Benchmark->CleanUp != NULL) {
+    Benchmark->CleanUp (Context);
+  }
+
+  return Status;
+}
+
+/**
+  Run all the benchmarks.
+
+  @retval  EFI_SUCCESS           All benchmarks were run.
+  @retval  EFI_ABORTED           At least one benchmark failed.
+  @retval  EFI_OUT_OF_RESOURCES  There are not enough resources available to
+                                 run the benchmarks.
+**/
+EFI_STATUS
+EFIAPI
+BenchmarkMain (
+  VOID
+  )
+{
+  EFI_STATUS  Status;
+  EFI_STATUS  BenchmarkStatus;
+  UINT8       *Data;
+  UINTN       SuiteIndex;
+  UINTN       Index;
+
+  BenchmarkPrint ("%a v%a, crypto provider %a\n", BENCHMARK_NAME, BENCHMARK_VERSION, BENCHMARK_CRYPTO_PROVIDER);
+
+  Data = AllocatePool (BENCHMARK_MAX_DATA_SIZE);
+  if (Data == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+  for (Index = 0; Index < BENCHMARK_MAX_DATA_SIZE; Index++) {
+    Data[Index] = (UINT8)Index;
+  }
+
+  BenchmarkPrint (
+    "BENCHMARK,Provider,Operation,DataSize,Iterations,Cycles,Nanoseconds,CyclesPerOperation,CyclesPerByte,OperationsPerSecond\n"
+    );
+
+  Status = EFI_SUCCESS;
+  for (SuiteIndex = 0; SuiteIndex < ARRAY_SIZE (mBenchmarkSuite); SuiteIndex++) {
+    BenchmarkPrint ("%a\n", mBenchmarkSuite[SuiteIndex].Title);
+    for (Index = 0; Index < *mBenchmarkSuite[SuiteIndex].BenchmarkNum; Index++) {
+      BenchmarkStatus = RunBenchmark (&mBenchmarkSuite[SuiteIndex].BenchmarkDesc[Index], Data);
+      if (EFI_ERROR (BenchmarkStatus)) {
+        Status = BenchmarkStatus;
+      }
+    }
+  }
+
+  FreePool (Data);
+
+  return Status;
+}
+
+/**
+  Standard UEFI entry point for target based benchmark execution from the
+  UEFI Shell.
+**/
+EFI_STATUS
+EFIAPI
+DxeEntryPoint (
+  IN EFI_HANDLE        ImageHandle,
+  IN EFI_SYSTEM_TABLE  *SystemTable
+  )
+{
+  return BenchmarkMain ();
+}
+
+/**
+  Standard POSIX C entry point for host based benchmark execution.
+**/
+int
+main (
+  int argc,
+  char *argv[]
+  )
+{
+  return (int)BenchmarkMain ();
+}
@@ -0,0 +1,37 @@
+/** @file
+  Output of the BaseCryptLib benchmark to the console of the UEFI Shell.
+
+  Copyright (c) 2026, agent. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+#include "TestBaseCryptLibBenchmark.h"
+#include <Library/PrintLib.h>
+#include <Library/UefiBootServicesTableLib.h>
+
+/**
+  Print a benchmark result line.
+
+  @param[in]  Format  ASCII format string, as defined by PrintLib.
+  @param[in]  ...     Variable argument list of the format string.
+**/
+VOID
+EFIAPI
+BenchmarkPrint (
+  IN CONST CHAR8  *Format,
+  ...
+  )
+{
+  VA_LIST  Marker;
+  CHAR16   String[256];
+  UINTN    Length;
+
+  VA_START (Marker, Format);
+  Length = UnicodeVSPrintAsciiFormat (String, sizeof (String), Format, Marker);
+  if (Length == 0) {
+    DEBUG ((DEBUG_ERROR, "%a formatted string is too long\n", __FUNCTION__));
+  } else {
+    gST->ConOut->OutputString (gST->ConOut, String);
+  }
+  VA_END (Marker);
+}
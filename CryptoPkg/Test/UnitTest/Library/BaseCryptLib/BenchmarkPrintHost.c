@@ -0,0 +1,39 @@
+/** @file
+  Output of the BaseCryptLib benchmark to the standard output of the host.
+
+  Copyright (c) 2026, agent. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+#include <stdio.h>
+
+#include "TestBaseCryptLibBenchmark.h"
+#include <Library/PrintLib.h>
+
+/**
+  Print a benchmark result line.
+
+  @param[in]  Format  ASCII format string, as defined by PrintLib.
+  @param[in]  ...     Variable argument list of the format string.
+**/
+VOID
+EFIAPI
+BenchmarkPrint (
+  IN CONST CHAR8  *Format,
+  ...
+  )
+{
+  VA_LIST  Marker;
+  CHAR8    String[256];
+  UINTN    Length;
+
+  VA_START (Marker, Format);
+  Length = AsciiVSPrint (String, sizeof (String), Format, Marker);
+  if (Length == 0) {
+    DEBUG ((DEBUG_ERROR, "%a formatted string is too long\n", __FUNCTION__));
+  } else {
+    printf ("%s", String);
+    fflush (stdout);
+  }
+  VA_END (Marker);
+}
@@ -0,0 +1,109 @@
+/** @file
+  Benchmarks of the block cipher primitives.
+
+  Copyright (c) 2026, agent. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "TestBaseCryptLibBenchmark.h"
+
+GLOBAL_REMOVE_IF_UNREFERENCED CONST UINT8 mBenchmarkAes256Key[32] = {
+  0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+  0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4
+  };
+
+GLOBAL_REMOVE_IF_UNREFERENCED CONST UINT8 mBenchmarkAesIvec[16] = {
+  0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f
+  };
+
+typedef struct {
+  VOID   *AesContext;
+  UINT8  *Output;
+} AES_BENCHMARK_CONTEXT;
+
+BOOLEAN
+EFIAPI
+BenchmarkAesSetup (
+  OUT VOID  **Context
+  )
+{
+  AES_BENCHMARK_CONTEXT  *AesBenchmark;
+
+  AesBenchmark = AllocateZeroPool (sizeof (AES_BENCHMARK_CONTEXT));
+  if (AesBenchmark == NULL) {
+    return FALSE;
+  }
+
+  AesBenchmark->AesContext = AllocatePool (AesGetContextSize ());
+  AesBenchmark->Output     = AllocatePool (BENCHMARK_MAX_DATA_SIZE);
+  if ((AesBenchmark->AesContext == NULL) || (AesBenchmark->Output == NULL) ||
+      !AesInit (AesBenchmark->AesContext, mBenchmarkAes256Key, 256)) {
+    if (AesBenchmark->AesContext != NULL) {
+      FreePool (AesBenchmark->AesContext);
+    }
+    if (AesBenchmark->Output != NULL) {
+      FreePool (AesBenchmark->Output);
+    }
+    FreePool (AesBenchmark);
+    return FALSE;
+  }
+
+  *Context = AesBenchmark;
+  return TRUE;
+}
+
+BOOLEAN
+EFIAPI
+BenchmarkAesCbcEncrypt (
+  IN VOID         *Context,
+  IN CONST UINT8  *Data,
+  IN UINTN        DataSize
+  )
+{
+  AES_BENCHMARK_CONTEXT  *AesBenchmark;
+
+  AesBenchmark = Context;
+  return AesCbcEncrypt (AesBenchmark->AesContext, Data, DataSize, mBenchmarkAesIvec, AesBenchmark->Output);
+}
+
+BOOLEAN
+EFIAPI
+BenchmarkAesCbcDecrypt (
+  IN VOID         *Context,
+  IN CONST UINT8  *Data,
+  IN UINTN        DataSize
+  )
+{
+  AES_BENCHMARK_CONTEXT  *AesBenchmark;
+
+  //
+  // Any input is a valid ciphertext for CBC without padding.
+  //
+  AesBenchmark = Context;
+  return AesCbcDecrypt (AesBenchmark->AesContext, Data, DataSize, mBenchmarkAesIvec, AesBenchmark->Output);
+}
+
+VOID
+EFIAPI
+BenchmarkAesCleanUp (
+  IN VOID  *Context
+  )
+{
+  AES_BENCHMARK_CONTEXT  *AesBenchmark;
+
+  AesBenchmark = Context;
+  FreePool (AesBenchmark->AesContext);
+  FreePool (AesBenchmark->Output);
+  FreePool (AesBenchmark);
+}
+
+BENCHMARK_DESC mCipherBenchmark[] = {
+    //
+    // -----Name------------Setup---------------Operation---------------CleanUp-------------DataDependent
+    //
+    {"AES-256-CBC-Encrypt", BenchmarkAesSetup,  BenchmarkAesCbcEncrypt, BenchmarkAesCleanUp, TRUE},
+    {"AES-256-CBC-Decrypt", BenchmarkAesSetup,  BenchmarkAesCbcDecrypt, BenchmarkAesCleanUp, TRUE},
+};
+
+UINTN mCipherBenchmarkNum = ARRAY_SIZE(mCipherBenchmark);
@@ -0,0 +1,169 @@
+/** @file
+  Benchmarks of the hash, HMAC and HKDF primitives.
+
+  Copyright (c) 2026, agent. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "TestBaseCryptLibBenchmark.h"
+
+//
+// Max Known Digest Size is SHA512 Output (64 bytes) by far
+//
+#define MAX_DIGEST_SIZE    64
+
+GLOBAL_REMOVE_IF_UNREFERENCED CONST UINT8 mBenchmarkHmacKey[SHA256_DIGEST_SIZE] = {
+  0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b,
+  0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b
+  };
+
+GLOBAL_REMOVE_IF_UNREFERENCED CONST UINT8 mBenchmarkHkdfSalt[SHA256_DIGEST_SIZE] = {
+  0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+  0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f
+  };
+
+GLOBAL_REMOVE_IF_UNREFERENCED CONST CHAR8 *mBenchmarkHkdfInfo = "BaseCryptLib Benchmark";
+
+BOOLEAN
+EFIAPI
+BenchmarkSha1 (
+  IN VOID         *Context,
+  IN CONST UINT8  *Data,
+  IN UINTN        DataSize
+  )
+{
+  UINT8  Digest[MAX_DIGEST_SIZE];
+
+  return Sha1HashAll (Data, DataSize, Digest);
+}
+
+BOOLEAN
+EFIAPI
+BenchmarkSha256 (
+  IN VOID         *Context,
+  IN CONST UINT8  *Data,
+  IN UINTN        DataSize
+  )
+{
+  UINT8  Digest[MAX_DIGEST_SIZE];
+
+  return Sha256HashAll (Data, DataSize, Digest);
+}
+
+BOOLEAN
+EFIAPI
+BenchmarkSha384 (
+  IN VOID         *Context,
+  IN CONST UINT8  *Data,
+  IN UINTN        DataSize
+  )
+{
+  UINT8  Digest[MAX_DIGEST_SIZE];
+
+  return Sha384HashAll (Data, DataSize, Digest);
+}
+
+BOOLEAN
+EFIAPI
+BenchmarkSha512 (
+  IN VOID         *Context,
+  IN CONST UINT8  *Data,
+  IN UINTN        DataSize
+  )
+{
+  UINT8  Digest[MAX_DIGEST_SIZE];
+
+  return Sha512HashAll (Data, DataSize, Digest);
+}
+
+BOOLEAN
+EFIAPI
+BenchmarkSm3 (
+  IN VOID         *Context,
+  IN CONST UINT8  *Data,
+  IN UINTN        DataSize
+  )
+{
+  UINT8  Digest[MAX_DIGEST_SIZE];
+
+  return Sm3HashAll (Data, DataSize, Digest);
+}
+
+BOOLEAN
+EFIAPI
+BenchmarkHmacSha256Setup (
+  OUT VOID  **Context
+  )
+{
+  *Context = HmacSha256New ();
+  return (BOOLEAN)(*Context != NULL);
+}
+
+BOOLEAN
+EFIAPI
+BenchmarkHmacSha256 (
+  IN VOID         *Context,
+  IN CONST UINT8  *Data,
+  IN UINTN        DataSize
+  )
+{
+  UINT8  Digest[MAX_DIGEST_SIZE];
+
+  //
+  // Setting the key starts a new MAC computation on the same context.
+  //
+  return HmacSha256SetKey (Context, mBenchmarkHmacKey, sizeof (mBenchmarkHmacKey)) &&
+         HmacSha256Update (Context, Data, DataSize) &&
+         HmacSha256Final (Context, Digest);
+}
+
+VOID
+EFIAPI
+BenchmarkHmacSha256CleanUp (
+  IN VOID  *Context
+  )
+{
+  HmacSha256Free (Context);
+}
+
+BOOLEAN
+EFIAPI
+BenchmarkHkdfSha256 (
+  IN VOID         *Context,
+  IN CONST UINT8  *Data,
+  IN UINTN        DataSize
+  )
+{
+  UINT8  Key[SHA256_DIGEST_SIZE];
+
+  //
+  // Derive one key from a 256-bit secret, as done for the session keys of
+  // secure channels.
+  //
+  return HkdfSha256ExtractAndExpand (
+           mBenchmarkHmacKey,
+           sizeof (mBenchmarkHmacKey),
+           mBenchmarkHkdfSalt,
+           sizeof (mBenchmarkHkdfSalt),
+           (CONST UINT8 *)mBenchmarkHkdfInfo,
+           AsciiStrLen (mBenchmarkHkdfInfo),
+           Key,
+           sizeof (Key)
+           );
+}
+
+BENCHMARK_DESC mHashBenchmark[] = {
+    //
+    // -----Name------------Setup---------------------Operation-----------CleanUp----------------------DataDependent
+    //
+    {"SHA1",               NULL,                      BenchmarkSha1,       NULL,                        TRUE},
+    {"SHA256",             NULL,                      BenchmarkSha256,     NULL,                        TRUE},
+    {"SHA384",             NULL,                      BenchmarkSha384,     NULL,                        TRUE},
+    {"SHA512",             NULL,                      BenchmarkSha512,     NULL,                        TRUE},
+    {"SM3",                NULL,                      BenchmarkSm3,        NULL,                        TRUE},
+    {"HMAC-SHA256",        BenchmarkHmacSha256Setup,  BenchmarkHmacSha256, BenchmarkHmacSha256CleanUp,  TRUE},
+    {"HKDF-SHA256",        NULL,                      BenchmarkHkdfSha256, NULL,                        FALSE},
+};
+
+UINTN mHashBenchmarkNum = ARRAY_SIZE(mHashBenchmark);
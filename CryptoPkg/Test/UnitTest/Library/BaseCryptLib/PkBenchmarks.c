@@ -0,0 +1,225 @@
+/** @file
+  Benchmarks of the public key primitives used to verify images and
+  variables.
+
+  The PKCS#7 and Authenticode benchmarks reuse the test data of the unit
+  tests in RsaPkcs7Tests.c and AuthenticodeTests.c.
+
+  Copyright (c) 2026, agent. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "TestBaseCryptLibBenchmark.h"
+
+//
+// Modulus length of the generated RSA key, the size of the keys in db.
+//
+#define BENCHMARK_RSA_MODULUS_LENGTH  2048
+
+GLOBAL_REMOVE_IF_UNREFERENCED CONST UINT8 mBenchmarkRsaE[] = { 0x01, 0x00, 0x01 };
+
+typedef struct {
+  VOID   *Rsa;
+  UINT8  MessageHash[SHA256_DIGEST_SIZE];
+  UINT8  Signature[BENCHMARK_RSA_MODULUS_LENGTH / 8];
+  UINTN  SigSize;
+} RSA_BENCHMARK_CONTEXT;
+
+typedef struct {
+  UINT8  *P7SignedData;
+  UINTN  P7SignedDataSize;
+} PKCS7_BENCHMARK_CONTEXT;
+
+BOOLEAN
+EFIAPI
+BenchmarkRsaSetup (
+  OUT VOID  **Context
+  )
+{
+  RSA_BENCHMARK_CONTEXT  *RsaBenchmark;
+
+  RsaBenchmark = AllocateZeroPool (sizeof (RSA_BENCHMARK_CONTEXT));
+  if (RsaBenchmark == NULL) {
+    return FALSE;
+  }
+
+  //
+  // Generate a fresh key rather than using the 1024-bit test key, so the
+  // numbers match the key sizes used for Secure Boot.
+  //
+  RsaBenchmark->Rsa     = RsaNew ();
+  RsaBenchmark->SigSize = sizeof (RsaBenchmark->Signature);
+  if ((RsaBenchmark->Rsa == NULL) ||
+      !RandomSeed (NULL, 0) ||
+      !RsaGenerateKey (RsaBenchmark->Rsa, BENCHMARK_RSA_MODULUS_LENGTH, mBenchmarkRsaE, sizeof (mBenchmarkRsaE)) ||
+      !Sha256HashAll (mBenchmarkRsaE, sizeof (mBenchmarkRsaE), RsaBenchmark->MessageHash) ||
+      !RsaPkcs1Sign (RsaBenchmark->Rsa, RsaBenchmark->MessageHash, SHA256_DIGEST_SIZE, RsaBenchmark->Signature, &RsaBenchmark->SigSize)) {
+    if (RsaBenchmark->Rsa != NULL) {
+      RsaFree (RsaBenchmark->Rsa);
+    }
+    FreePool (RsaBenchmark);
+    return FALSE;
+  }
+
+  *Context = RsaBenchmark;
+  return TRUE;
+}
+
+BOOLEAN
+EFIAPI
+BenchmarkRsaPkcs1Sign (
+  IN VOID         *Context,
+  IN CONST UINT8  *Data,
+  IN UINTN        DataSize
+  )
+{
+  RSA_BENCHMARK_CONTEXT  *RsaBenchmark;
+  UINT8                  Signature[BENCHMARK_RSA_MODULUS_LENGTH / 8];
+  UINTN                  SigSize;
+
+  RsaBenchmark = Context;
+  SigSize      = sizeof (Signature);
+  return RsaPkcs1Sign (RsaBenchmark->Rsa, RsaBenchmark->MessageHash, SHA256_DIGEST_SIZE, Signature, &SigSize);
+}
+
+BOOLEAN
+EFIAPI
+BenchmarkRsaPkcs1Verify (
+  IN VOID         *Context,
+  IN CONST UINT8  *Data,
+  IN UINTN        DataSize
+  )
+{
+  RSA_BENCHMARK_CONTEXT  *RsaBenchmark;
+
+  RsaBenchmark = Context;
+  return RsaPkcs1Verify (
+           RsaBenchmark->Rsa,
+           RsaBenchmark->MessageHash,
+           SHA256_DIGEST_SIZE,
+           RsaBenchmark->Signature,
+           RsaBenchmark->SigSize
+           );
+}
+
+VOID
+EFIAPI
+BenchmarkRsaCleanUp (
+  IN VOID  *Context
+  )
+{
+  RSA_BENCHMARK_CONTEXT  *RsaBenchmark;
+
+  RsaBenchmark = Context;
+  RsaFree (RsaBenchmark->Rsa);
+  FreePool (RsaBenchmark);
+}
+
+BOOLEAN
+EFIAPI
+BenchmarkPkcs7Setup (
+  OUT VOID  **Context
+  )
+{
+  PKCS7_BENCHMARK_CONTEXT  *Pkcs7Benchmark;
+  UINT8                    *SignCert;
+  BOOLEAN                  Status;
+
+  Pkcs7Benchmark = AllocateZeroPool (sizeof (PKCS7_BENCHMARK_CONTEXT));
+  if (Pkcs7Benchmark == NULL) {
+    return FALSE;
+  }
+
+  //
+  // Sign the payload once, only the verification is measured.
+  //
+  SignCert = NULL;
+  Status   = X509ConstructCertificate (TestCert, TestCertSize, &SignCert);
+  if (Status) {
+    Status = Pkcs7Sign (
+               TestKeyPem,
+               TestKeyPemSize,
+               (CONST UINT8 *)PemPass,
+               (UINT8 *)Payload,
+               AsciiStrLen (Payload),
+               SignCert,
+               NULL,
+               &Pkcs7Benchmark->P7SignedData,
+               &Pkcs7Benchmark->P7SignedDataSize
+               );
+    X509Free (SignCert);
+  }
+
+  if (!Status) {
+    FreePool (Pkcs7Benchmark);
+    return FALSE;
+  }
+
+  *Context = Pkcs7Benchmark;
+  return TRUE;
+}
+
+BOOLEAN
+EFIAPI
+BenchmarkPkcs7Verify (
+  IN VOID         *Context,
+  IN CONST UINT8  *Data,
+  IN UINTN        DataSize
+  )
+{
+  PKCS7_BENCHMARK_CONTEXT  *Pkcs7Benchmark;
+
+  Pkcs7Benchmark = Context;
+  return Pkcs7Verify (
+           Pkcs7Benchmark->P7SignedData,
+           Pkcs7Benchmark->P7SignedDataSize,
+           TestCACert,
+           TestCACertSize,
+           (CONST UINT8 *)Payload,
+           AsciiStrLen (Payload)
+           );
+}
+
+VOID
+EFIAPI
+BenchmarkPkcs7CleanUp (
+  IN VOID  *Context
+  )
+{
+  PKCS7_BENCHMARK_CONTEXT  *Pkcs7Benchmark;
+
+  Pkcs7Benchmark = Context;
+  FreePool (Pkcs7Benchmark->P7SignedData);
+  FreePool (Pkcs7Benchmark);
+}
+
+BOOLEAN
+EFIAPI
+BenchmarkAuthenticodeVerify (
+  IN VOID         *Context,
+  IN CONST UINT8  *Data,
+  IN UINTN        DataSize
+  )
+{
+  return AuthenticodeVerify (
+           AuthenticodeWithSha256,
+           AuthenticodeWithSha256Size,
+           TestRootCert2,
+           TestRootCert2Size,
+           PeSha256Hash,
+           SHA256_DIGEST_SIZE
+           );
+}
+
+BENCHMARK_DESC mPkBenchmark[] = {
+    //
+    // -----Name------------------Setup----------------Operation--------------------CleanUp----------------DataDependent
+    //
+    {"RSA2048-PKCS1-Sign",       BenchmarkRsaSetup,    BenchmarkRsaPkcs1Sign,       BenchmarkRsaCleanUp,   FALSE},
+    {"RSA2048-PKCS1-Verify",     BenchmarkRsaSetup,    BenchmarkRsaPkcs1Verify,     BenchmarkRsaCleanUp,   FALSE},
+    {"PKCS7-Verify",             BenchmarkPkcs7Setup,  BenchmarkPkcs7Verify,        BenchmarkPkcs7CleanUp, FALSE},
+    {"Authenticode-Verify",      NULL,                 BenchmarkAuthenticodeVerify, NULL,                  FALSE},
+};
+
+UINTN mPkBenchmarkNum = ARRAY_SIZE(mPkBenchmark);
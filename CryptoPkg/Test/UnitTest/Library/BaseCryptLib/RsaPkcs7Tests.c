@@ -241,6 +241,13 @@ GLOBAL_REMOVE_IF_UNREFERENCED CONST UINT8 MsgHash[] = {
 //
 GLOBAL_REMOVE_IF_UNREFERENCED CONST CHAR8 *Payload = "Payload Data for PKCS#7 Signing";
 
+//
+// Sizes of the test data, for the crypto benchmarks that share it.
+//
+GLOBAL_REMOVE_IF_UNREFERENCED CONST UINTN TestKeyPemSize = sizeof (TestKeyPem);
+GLOBAL_REMOVE_IF_UNREFERENCED CONST UINTN TestCACertSize = sizeof (TestCACert);
+GLOBAL_REMOVE_IF_UNREFERENCED CONST UINTN TestCertSize   = sizeof (TestCert);
+
 
 UNIT_TEST_STATUS
 EFIAPI
@@ -0,0 +1,146 @@
+/** @file
+  Definitions of the BaseCryptLib benchmarks.
+
+  Copyright (c) 2026, agent. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef __TEST_BASE_CRYPT_LIB_BENCHMARK_H__
+#define __TEST_BASE_CRYPT_LIB_BENCHMARK_H__
+
+#include "TestBaseCryptLib.h"
+#include <Library/TimerLib.h>
+
+#define BENCHMARK_NAME        "BaseCryptLib Benchmark"
+#define BENCHMARK_VERSION     "1.0"
+
+//
+// Name of the crypto provider under test, reported with every result. Set
+// BENCHMARK_CRYPTO_PROVIDER_PROTOCOL when BaseCryptLib is mapped to
+// BaseCryptLibOnProtocolPpi.
+//
+#ifdef BENCHMARK_CRYPTO_PROVIDER_PROTOCOL
+#define BENCHMARK_CRYPTO_PROVIDER  "BaseCryptLibOnProtocolPpi"
+#else
+#define BENCHMARK_CRYPTO_PROVIDER  "OpensslLib"
+#endif
+
+//
+// An operation is repeated until it ran for at least this many TSC cycles.
+//
+#define BENCHMARK_MIN_CYCLES  200000000ULL
+
+//
+// Largest input size of the data dependent operations.
+//
+#define BENCHMARK_MAX_DATA_SIZE  SIZE_1MB
+
+//
+// Upper bound of the iterations of one measurement.
+//
+#define BENCHMARK_MAX_ITERATIONS  1000000
+
+/**
+  Prepare a benchmark.
+
+  @param[out]  Context  Returns the context passed to the operation and the
+                        clean up function.
+
+  @retval TRUE   The benchmark is ready to run.
+  @retval FALSE  The benchmark can't run, e.g. the algorithm is not supported.
+
+**/
+typedef
+BOOLEAN
+(EFIAPI *BENCHMARK_SETUP) (
+  OUT VOID  **Context
+  );
+
+/**
+  Run the measured operation once.
+
+  @param[in]  Context   The context returned by the setup function.
+  @param[in]  Data      Input data of the operation.
+  @param[in]  DataSize  Size of Data in bytes, always a multiple of 16.
+
+  @retval TRUE   The operation succeeded.
+  @retval FALSE  The operation failed, the benchmark is aborted.
+
+**/
+typedef
+BOOLEAN
+(EFIAPI *BENCHMARK_OPERATION) (
+  IN VOID         *Context,
+  IN CONST UINT8  *Data,
+  IN UINTN        DataSize
+  );
+
+/**
+  Release the resources of a benchmark.
+
+  @param[in]  Context  The context returned by the setup function.
+
+**/
+typedef
+VOID
+(EFIAPI *BENCHMARK_CLEANUP) (
+  IN VOID  *Context
+  );
+
+typedef struct {
+  CHAR8                *Name;
+  BENCHMARK_SETUP      Setup;
+  BENCHMARK_OPERATION  Operation;
+  BENCHMARK_CLEANUP    CleanUp;
+  //
+  // TRUE if the operation processes the input data, and is measured for
+  // every size of mBenchmarkDataSizes. FALSE if its cost does not depend on
+  // the input, it is measured once per operation.
+  //
+  BOOLEAN              DataDependent;
+} BENCHMARK_DESC;
+
+extern UINTN mHashBenchmarkNum;
+extern BENCHMARK_DESC mHashBenchmark[];
+
+extern UINTN mCipherBenchmarkNum;
+extern BENCHMARK_DESC mCipherBenchmark[];
+
+extern UINTN mPkBenchmarkNum;
+extern BENCHMARK_DESC mPkBenchmark[];
+
+/**
+  Print a benchmark result line.
+
+  The UEFI Shell build prints to the console and the host build to the
+  standard output, so that the results are seen whatever DebugLib is used.
+
+  @param[in]  Format  ASCII format string, as defined by PrintLib.
+  @param[in]  ...     Variable argument list of the format string.
+**/
+VOID
+EFIAPI
+BenchmarkPrint (
+  IN CONST CHAR8  *Format,
+  ...
+  );
+
+//
+// Test data shared with the unit tests.
+//
+extern CONST UINT8  TestKeyPem[];
+extern CONST UINTN  TestKeyPemSize;
+extern CONST CHAR8  *PemPass;
+extern CONST UINT8  TestCACert[];
+extern CONST UINTN  TestCACertSize;
+extern CONST UINT8  TestCert[];
+extern CONST UINTN  TestCertSize;
+extern CONST CHAR8  *Payload;
+extern UINT8        AuthenticodeWithSha256[];
+extern CONST UINTN  AuthenticodeWithSha256Size;
+extern UINT8        TestRootCert2[];
+extern CONST UINTN  TestRootCert2Size;
+extern UINT8        PeSha256Hash[];
+
+#endif
@@ -9,6 +9,152 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 
 #include "PeiMain.h"
 
+/**
+  Discover all PEIMs in one FV from the dispatch plan given for it by the
+  EDKII_PEI_DISPATCH_PLAN_PPI.
+
+  The plan is only followed if it was recorded from the same FV and all the files
+  it lists are found at their offsets. The PEIMs are then ordered as they were
+  dispatched when the plan was recorded, without walking the FV.
+
+  @param Private          Pointer to the private data passed in from caller
+  @param CoreFileHandle   The instance of PEI_CORE_FV_HANDLE.
+
+  @retval TRUE            The PEIMs are discovered from the dispatch plan.
+  @retval FALSE           There is no valid dispatch plan for the FV.
+
+**/
+BOOLEAN
+DiscoverPeimsWithDispatchPlan (
+  IN  PEI_CORE_INSTANCE    *Private,
+  IN  PEI_CORE_FV_HANDLE   *CoreFileHandle
+  )
+{
+  EFI_STATUS                          Status;
+  EDKII_PEI_DISPATCH_PLAN_PPI         *DispatchPlanPpi;
+  EDKII_PEI_DISPATCH_PLAN             FvPlan;
+  CONST EDKII_PEI_DISPATCH_PLAN       *Plan;
+  CONST EDKII_PEI_DISPATCH_PLAN_FILE  *PlanFile;
+  EFI_PEI_FILE_HANDLE                 *FileHandles;
+  UINTN                               Index;
+  UINTN                               Index2;
+
+  Status = PeiServicesLocatePpi (
+             &gEdkiiPeiDispatchPlanPpiGuid,
+             0,
+             NULL,
+             (VOID **) &DispatchPlanPpi
+             );
+  if (EFI_ERROR (Status)) {
+    return FALSE;
+  }
+
+  if (!InitializeDispatchPlanHeader (CoreFileHandle, &FvPlan)) {
+    return FALSE;
+  }
+
+  //
+  // Find the plan recorded from this FV.
+  //
+  Plan = NULL;
+  for (Index = 0; Index < DispatchPlanPpi->PlanCount; Index++) {
+    Plan = DispatchPlanPpi->Plans[Index];
+    if ((Plan != NULL) &&
+        (Plan->Signature == EDKII_PEI_DISPATCH_PLAN_SIGNATURE) &&
+        CompareGuid (&Plan->FvName, &FvPlan.FvName) &&
+        (Plan->FvLength == FvPlan.FvLength) &&
+        (Plan->FvChecksum == FvPlan.FvChecksum) &&
+        IsDispatchPlanFreeSpaceOffset (CoreFileHandle->FvHandle, Plan)) {
+      break;
+    }
+  }
+  if (Index == DispatchPlanPpi->PlanCount) {
+    return FALSE;
+  }
+
+  if ((Plan->Size < sizeof (EDKII_PEI_DISPATCH_PLAN)) ||
+      (Plan->FileCount == 0) ||
+      (Plan->FileCount > (Plan->Size - sizeof (EDKII_PEI_DISPATCH_PLAN)) / sizeof (EDKII_PEI_DISPATCH_PLAN_FILE)) ||
+      (Plan->AprioriCount > Plan->FileCount)) {
+    DEBUG ((DEBUG_WARN, "%a(): Invalid dispatch plan for FV %g\n", __FUNCTION__, &FvPlan.FvName));
+    return FALSE;
+  }
+
+  //
+  // Check all the files of the plan are still in the FV, at the same place.
+  //
+  FileHandles = AllocatePool (sizeof (EFI_PEI_FILE_HANDLE) * Plan->FileCount);
+  ASSERT (FileHandles != NULL);
+  PlanFile = (CONST EDKII_PEI_DISPATCH_PLAN_FILE *) (Plan + 1);
+  for (Index = 0; Index < Plan->FileCount; Index++) {
+    FileHandles[Index] = GetDispatchPlanFileHandle (CoreFileHandle->FvHandle, &PlanFile[Index]);
+    if (FileHandles[Index] == NULL) {
+      break;
+    }
+    //
+    // A file listed twice would be dispatched twice.
+    //
+    for (Index2 = 0; Index2 < Index; Index2++) {
+      if (FileHandles[Index2] == FileHandles[Index]) {
+        break;
+      }
+    }
+    if (Index2 < Index) {
+      break;
+    }
+  }
+  if (Index < Plan->FileCount) {
+    DEBUG ((DEBUG_INFO, "%a(): The dispatch plan doesn't match FV %g\n", __FUNCTION__, &FvPlan.FvName));
+    FreePool (FileHandles);
+    return FALSE;
+  }
+
+  //
+  // Record PeimCount, allocate buffer for PeimState.
+  //
+  CoreFileHandle->PeimCount     = Plan->FileCount;
+  CoreFileHandle->PeimState     = AllocateZeroPool (sizeof (UINT8) * Plan->FileCount);
+  ASSERT (CoreFileHandle->PeimState != NULL);
+  CoreFileHandle->FvFileHandles = FileHandles;
+  CoreFileHandle->AprioriCount  = Plan->AprioriCount;
+  Private->AprioriCount         = Plan->AprioriCount;
+
+  DEBUG ((
+    DEBUG_INFO,
+    "%a(): Found 0x%x PEI FFS files in the %dth FV from its dispatch plan\n",
+    __FUNCTION__,
+    Plan->FileCount,
+    Private->CurrentPeimFvCount
+    ));
+
+  return TRUE;
+}
+
+/**
+  Record a PEIM or FV file of a FV is dispatched, if PcdRecordPeiDispatchPlan is TRUE.
+
+  @param CoreFvHandle     The instance of PEI_CORE_FV_HANDLE of the FV.
+  @param PeimIndex        The index of the file in the FvFileHandles of the FV.
+
+**/
+VOID
+RecordPeimDispatch (
+  IN  PEI_CORE_FV_HANDLE   *CoreFvHandle,
+  IN  UINTN                PeimIndex
+  )
+{
+  if (!PcdGetBool (PcdRecordPeiDispatchPlan)) {
+    return;
+  }
+
+  if (CoreFvHandle->DispatchOrder == NULL) {
+    CoreFvHandle->DispatchOrder = AllocatePool (sizeof (UINT32) * CoreFvHandle->PeimCount);
+    ASSERT (CoreFvHandle->DispatchOrder != NULL);
+  }
+  ASSERT (CoreFvHandle->DispatchedCount < CoreFvHandle->PeimCount);
+  CoreFvHandle->DispatchOrder[CoreFvHandle->DispatchedCount++] = (UINT32) PeimIndex;
+}
+
 /**
 
   Discover all PEIMs and optional Apriori file in one FV. There is at most one
@@ -56,6 +202,15 @@ DiscoverPeimsAndOrderWithApriori (
     return;
   }
 
+  //
+  // If the platform gives a valid dispatch plan for the current FV, get the PEIMs from it.
+  //
+  if (DiscoverPeimsWithDispatchPlan (Private, CoreFileHandle)) {
+    CoreFileHandle->ScanFv = TRUE;
+    Private->CurrentFvFileHandles = CoreFileHandle->FvFileHandles;
+    return;
+  }
+
   TempFileHandles = Private->TempFileHandles;
   TempFileGuid    = Private->TempFileGuid;
 
@@ -193,6 +348,8 @@ DiscoverPeimsAndOrderWithApriori (
     CopyMem (CoreFileHandle->FvFileHandles, TempFileHandles, sizeof (EFI_PEI_FILE_HANDLE) * PeimCount);
   }
 
+  CoreFileHandle->AprioriCount = Private->AprioriCount;
+
   //
   // The current FV File Handles have been cached. So that we don't have to scan the FV again.
   // Instead, we can retrieve the file handles within this FV from cached records.
@@ -1540,6 +1697,7 @@ PeiDispatcher (
                 // PEIM_STATE_NOT_DISPATCHED move to PEIM_STATE_DISPATCHED
                 //
                 Private->Fv[FvCount].PeimState[PeimCount]++;
+                RecordPeimDispatch (&Private->Fv[FvCount], PeimCount);
                 Private->PeimDispatchOnThisPass = TRUE;
               } else {
                 //
@@ -1580,6 +1738,7 @@ PeiDispatcher (
                   // PEIM_STATE_NOT_DISPATCHED move to PEIM_STATE_DISPATCHED
                   //
                   Private->Fv[FvCount].PeimState[PeimCount]++;
+                  RecordPeimDispatch (&Private->Fv[FvCount], PeimCount);
                   //
                   // Call the PEIM entry point for PEIM driver
                   //
@@ -1693,6 +1852,98 @@ PeiDispatcher (
 
 }
 
+/**
+  Record the dispatch plan of each FV in a gEdkiiPeiDispatchPlanGuid HOB.
+
+  The files of a plan are the files listed in the Apriori file of the FV, then the
+  other files in the order they were dispatched, then the files not dispatched.
+
+  @param Private         PeiCore's private data structure
+
+**/
+VOID
+PeiRecordDispatchPlans (
+  IN PEI_CORE_INSTANCE          *Private
+  )
+{
+  PEI_CORE_FV_HANDLE              *CoreFvHandle;
+  EDKII_PEI_DISPATCH_PLAN         FvPlan;
+  EDKII_PEI_DISPATCH_PLAN         *Plan;
+  EDKII_PEI_DISPATCH_PLAN_FILE    *PlanFile;
+  UINT64                          FvLength;
+  UINTN                           FvIndex;
+  UINTN                           Index;
+  UINTN                           FileIndex;
+  UINTN                           Count;
+
+  for (FvIndex = 0; FvIndex < Private->FvCount; FvIndex++) {
+    CoreFvHandle = &Private->Fv[FvIndex];
+    if (!CoreFvHandle->ScanFv || (CoreFvHandle->PeimCount == 0)) {
+      continue;
+    }
+
+    if (!InitializeDispatchPlanHeader (CoreFvHandle, &FvPlan)) {
+      continue;
+    }
+
+    //
+    // The offsets of the files in the FV must fit in the plan.
+    //
+    FvLength = FvPlan.FvLength;
+    for (Index = 0; Index < CoreFvHandle->PeimCount; Index++) {
+      if (((UINTN) CoreFvHandle->FvFileHandles[Index] <= (UINTN) CoreFvHandle->FvHandle) ||
+          ((UINT64) ((UINTN) CoreFvHandle->FvFileHandles[Index] - (UINTN) CoreFvHandle->FvHandle) >= FvLength) ||
+          ((UINT64) ((UINTN) CoreFvHandle->FvFileHandles[Index] - (UINTN) CoreFvHandle->FvHandle) > MAX_UINT32)) {
+        break;
+      }
+    }
+    if (Index < CoreFvHandle->PeimCount) {
+      continue;
+    }
+
+    FvPlan.Size              = (UINT32) (sizeof (EDKII_PEI_DISPATCH_PLAN) + sizeof (EDKII_PEI_DISPATCH_PLAN_FILE) * CoreFvHandle->PeimCount);
+    FvPlan.FvFreeSpaceOffset = GetFvFreeSpaceOffset (CoreFvHandle->FvHandle);
+    FvPlan.AprioriCount      = (UINT32) CoreFvHandle->AprioriCount;
+    FvPlan.FileCount         = (UINT32) CoreFvHandle->PeimCount;
+    Plan = BuildGuidHob (&gEdkiiPeiDispatchPlanGuid, FvPlan.Size);
+    if (Plan == NULL) {
+      return;
+    }
+    CopyMem (Plan, &FvPlan, sizeof (EDKII_PEI_DISPATCH_PLAN));
+    PlanFile = (EDKII_PEI_DISPATCH_PLAN_FILE *) (Plan + 1);
+
+    //
+    // The files in the Apriori file are at the beginning of FvFileHandles.
+    //
+    Count = 0;
+    for (FileIndex = 0; FileIndex < CoreFvHandle->AprioriCount; FileIndex++) {
+      PlanFile[Count].Offset = (UINT32) ((UINTN) CoreFvHandle->FvFileHandles[FileIndex] - (UINTN) CoreFvHandle->FvHandle);
+      CopyGuid (&PlanFile[Count].FileName, &((EFI_FFS_FILE_HEADER *) CoreFvHandle->FvFileHandles[FileIndex])->Name);
+      Count++;
+    }
+
+    for (Index = 0; Index < CoreFvHandle->DispatchedCount; Index++) {
+      FileIndex = CoreFvHandle->DispatchOrder[Index];
+      if (FileIndex >= CoreFvHandle->AprioriCount) {
+        PlanFile[Count].Offset = (UINT32) ((UINTN) CoreFvHandle->FvFileHandles[FileIndex] - (UINTN) CoreFvHandle->FvHandle);
+        CopyGuid (&PlanFile[Count].FileName, &((EFI_FFS_FILE_HEADER *) CoreFvHandle->FvFileHandles[FileIndex])->Name);
+        Count++;
+      }
+    }
+
+    for (FileIndex = CoreFvHandle->AprioriCount; FileIndex < CoreFvHandle->PeimCount; FileIndex++) {
+      if (CoreFvHandle->PeimState[FileIndex] == PEIM_STATE_NOT_DISPATCHED) {
+        PlanFile[Count].Offset = (UINT32) ((UINTN) CoreFvHandle->FvFileHandles[FileIndex] - (UINTN) CoreFvHandle->FvHandle);
+        CopyGuid (&PlanFile[Count].FileName, &((EFI_FFS_FILE_HEADER *) CoreFvHandle->FvFileHandles[FileIndex])->Name);
+        Count++;
+      }
+    }
+    ASSERT (Count == CoreFvHandle->PeimCount);
+
+    DEBUG ((DEBUG_INFO, "Dispatch plan recorded for FV %g with 0x%x files\n", &FvPlan.FvName, Count));
+  }
+}
+
 /**
   Initialize the Dispatcher's data members
 
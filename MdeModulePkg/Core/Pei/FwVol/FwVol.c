@@ -1358,6 +1358,290 @@ GetFvUsedSize (
   return FALSE;
 }
 
+/**
+  Initialize the header of the dispatch plan of a FV with the fields identifying the FV.
+
+  Only the FVs processed by the FFS2 and FFS3 EFI_PEI_FIRMWARE_VOLUME_PPI of the PEI Core,
+  and named by a FV extension header, can have a dispatch plan.
+
+  @param CoreFvHandle   Pointer of PEI_CORE_FV_HANDLE of the FV.
+  @param Plan           Pointer to the header of the dispatch plan.
+
+  @retval TRUE          The header is initialized.
+  @retval FALSE         The FV can't have a dispatch plan.
+
+**/
+BOOLEAN
+InitializeDispatchPlanHeader (
+  IN  PEI_CORE_FV_HANDLE        *CoreFvHandle,
+  OUT EDKII_PEI_DISPATCH_PLAN   *Plan
+  )
+{
+  EFI_FIRMWARE_VOLUME_HEADER        *FwVolHeader;
+  EFI_FIRMWARE_VOLUME_EXT_HEADER    *FwVolExtHeader;
+
+  if ((CoreFvHandle->FvPpi != &mPeiFfs2FwVol.Fv) && (CoreFvHandle->FvPpi != &mPeiFfs3FwVol.Fv)) {
+    return FALSE;
+  }
+
+  FwVolHeader = (EFI_FIRMWARE_VOLUME_HEADER *) CoreFvHandle->FvHandle;
+  if (FwVolHeader->ExtHeaderOffset == 0) {
+    return FALSE;
+  }
+  FwVolExtHeader = (EFI_FIRMWARE_VOLUME_EXT_HEADER *) ((UINT8 *) FwVolHeader + FwVolHeader->ExtHeaderOffset);
+
+  ZeroMem (Plan, sizeof (EDKII_PEI_DISPATCH_PLAN));
+  Plan->Signature  = EDKII_PEI_DISPATCH_PLAN_SIGNATURE;
+  Plan->Size       = sizeof (EDKII_PEI_DISPATCH_PLAN);
+  CopyGuid (&Plan->FvName, &FwVolExtHeader->FvName);
+  Plan->FvLength   = FwVolHeader->FvLength;
+  Plan->FvChecksum = FwVolHeader->Checksum;
+
+  return TRUE;
+}
+
+/**
+  Check whether FindFileEx() goes on walking the FV after a file in the given state.
+
+  @param FileState      The state of the file returned by GetFileState().
+
+  @retval TRUE          FindFileEx() skips the file and walks the next one.
+  @retval FALSE         FindFileEx() stops at the file, it is the free space of the FV.
+
+**/
+BOOLEAN
+IsFileStateWalked (
+  IN UINT8                  FileState
+  )
+{
+  switch (FileState) {
+  case EFI_FILE_HEADER_CONSTRUCTION:
+  case EFI_FILE_HEADER_INVALID:
+  case EFI_FILE_DATA_VALID:
+  case EFI_FILE_MARKED_FOR_UPDATE:
+  case EFI_FILE_DELETED:
+    return TRUE;
+
+  default:
+    return FALSE;
+  }
+}
+
+/**
+  Get the offset of the free space of a FV, where FindFileEx() stops walking its files.
+
+  The files of the FV are walked as FindFileEx() does, so the offset is only computed
+  when the dispatch plans are recorded.
+
+  @param FvHandle       The handle of the FV.
+
+  @return The offset of the free space from the FV header.
+
+**/
+UINT32
+GetFvFreeSpaceOffset (
+  IN EFI_PEI_FV_HANDLE      FvHandle
+  )
+{
+  EFI_FIRMWARE_VOLUME_HEADER            *FwVolHeader;
+  EFI_FIRMWARE_VOLUME_EXT_HEADER        *FwVolExtHeader;
+  EFI_FFS_FILE_HEADER                   *FfsFileHeader;
+  UINT64                                FileOffset;
+  UINT32                                FileLength;
+  UINT8                                 ErasePolarity;
+  UINT8                                 FileState;
+
+  FwVolHeader = (EFI_FIRMWARE_VOLUME_HEADER *) FvHandle;
+  if ((FwVolHeader->Attributes & EFI_FVB2_ERASE_POLARITY) != 0) {
+    ErasePolarity = 1;
+  } else {
+    ErasePolarity = 0;
+  }
+
+  if (FwVolHeader->ExtHeaderOffset != 0) {
+    FwVolExtHeader = (EFI_FIRMWARE_VOLUME_EXT_HEADER *) ((UINT8 *) FwVolHeader + FwVolHeader->ExtHeaderOffset);
+    FileOffset = FwVolHeader->ExtHeaderOffset + FwVolExtHeader->ExtHeaderSize;
+  } else {
+    FileOffset = FwVolHeader->HeaderLength;
+  }
+  FileOffset = ALIGN_VALUE (FileOffset, 8);
+
+  while (FileOffset < FwVolHeader->FvLength - sizeof (EFI_FFS_FILE_HEADER)) {
+    FfsFileHeader = (EFI_FFS_FILE_HEADER *) ((UINT8 *) FwVolHeader + FileOffset);
+    FileState = GetFileState (ErasePolarity, FfsFileHeader);
+    if (!IsFileStateWalked (FileState)) {
+      break;
+    }
+
+    if ((FileState == EFI_FILE_HEADER_CONSTRUCTION) || (FileState == EFI_FILE_HEADER_INVALID)) {
+      if (IS_FFS_FILE2 (FfsFileHeader)) {
+        FileLength = sizeof (EFI_FFS_FILE_HEADER2);
+      } else {
+        FileLength = sizeof (EFI_FFS_FILE_HEADER);
+      }
+    } else if ((FileState != EFI_FILE_DELETED) && (CalculateHeaderChecksum (FfsFileHeader) != 0)) {
+      break;
+    } else if (IS_FFS_FILE2 (FfsFileHeader)) {
+      FileLength = FFS_FILE2_SIZE (FfsFileHeader);
+    } else {
+      FileLength = FFS_FILE_SIZE (FfsFileHeader);
+    }
+    if (FileLength == 0) {
+      break;
+    }
+
+    FileOffset += GET_OCCUPIED_SIZE (FileLength, 8);
+  }
+
+  if (FileOffset > FwVolHeader->FvLength) {
+    FileOffset = FwVolHeader->FvLength;
+  }
+  ASSERT (FileOffset <= MAX_UINT32);
+  return (UINT32) FileOffset;
+}
+
+/**
+  Check the offset of the free space of a FV recorded in its dispatch plan.
+
+  Only the state of the file header at the offset is read: no file was added to
+  the free space of the FV if FindFileEx() still stops walking its files there.
+
+  @param FvHandle       The handle of the FV.
+  @param Plan           Pointer to the dispatch plan of the FV.
+
+  @retval TRUE          FindFileEx() stops walking the files of the FV at the offset.
+  @retval FALSE         The offset is invalid or a file was added to the free space.
+
+**/
+BOOLEAN
+IsDispatchPlanFreeSpaceOffset (
+  IN EFI_PEI_FV_HANDLE                  FvHandle,
+  IN CONST EDKII_PEI_DISPATCH_PLAN      *Plan
+  )
+{
+  EFI_FIRMWARE_VOLUME_HEADER            *FwVolHeader;
+  EFI_FFS_FILE_HEADER                   *FfsFileHeader;
+  UINT32                                FileOffset;
+  UINT8                                 ErasePolarity;
+
+  FwVolHeader = (EFI_FIRMWARE_VOLUME_HEADER *) FvHandle;
+  FileOffset  = Plan->FvFreeSpaceOffset;
+
+  if ((FileOffset < FwVolHeader->HeaderLength) || (FileOffset > FwVolHeader->FvLength)) {
+    return FALSE;
+  }
+
+  //
+  // FindFileEx() doesn't look for a file header at the end of the FV.
+  //
+  if (FileOffset >= FwVolHeader->FvLength - sizeof (EFI_FFS_FILE_HEADER)) {
+    return TRUE;
+  }
+  if ((FileOffset & 0x07) != 0) {
+    return FALSE;
+  }
+  FfsFileHeader = (EFI_FFS_FILE_HEADER *) ((UINT8 *) FwVolHeader + FileOffset);
+
+  if ((FwVolHeader->Attributes & EFI_FVB2_ERASE_POLARITY) != 0) {
+    ErasePolarity = 1;
+  } else {
+    ErasePolarity = 0;
+  }
+  return (BOOLEAN) !IsFileStateWalked (GetFileState (ErasePolarity, FfsFileHeader));
+}
+
+/**
+  Get the handle of a file listed in the dispatch plan of a FV.
+
+  The file header at the offset given by the plan is checked as FindFileEx() does
+  when it walks the FV.
+
+  @param FvHandle       The handle of the FV.
+  @param PlanFile       Pointer to the file entry of the dispatch plan.
+
+  @return The handle of the file, or NULL if the file is not a valid PEIM, combined
+          PEIM/driver or FV image file with the name given by the plan.
+
+**/
+EFI_PEI_FILE_HANDLE
+GetDispatchPlanFileHandle (
+  IN EFI_PEI_FV_HANDLE                      FvHandle,
+  IN CONST EDKII_PEI_DISPATCH_PLAN_FILE     *PlanFile
+  )
+{
+  EFI_FIRMWARE_VOLUME_HEADER            *FwVolHeader;
+  EFI_FFS_FILE_HEADER                   *FfsFileHeader;
+  UINT32                                FileOffset;
+  UINT32                                FileLength;
+  UINT32                                HeaderLength;
+  UINT8                                 ErasePolarity;
+  UINT8                                 FileState;
+  UINT8                                 DataCheckSum;
+
+  FwVolHeader = (EFI_FIRMWARE_VOLUME_HEADER *) FvHandle;
+  FileOffset  = PlanFile->Offset;
+
+  //
+  // The FFS file headers are 8 byte aligned, after the FV header.
+  //
+  if (((FileOffset & 0x07) != 0) ||
+      (FileOffset < FwVolHeader->HeaderLength) ||
+      (FileOffset >= FwVolHeader->FvLength - sizeof (EFI_FFS_FILE_HEADER))) {
+    return NULL;
+  }
+  FfsFileHeader = (EFI_FFS_FILE_HEADER *) ((UINT8 *) FwVolHeader + FileOffset);
+
+  if (!CompareGuid (&FfsFileHeader->Name, &PlanFile->FileName)) {
+    return NULL;
+  }
+
+  if ((FwVolHeader->Attributes & EFI_FVB2_ERASE_POLARITY) != 0) {
+    ErasePolarity = 1;
+  } else {
+    ErasePolarity = 0;
+  }
+  FileState = GetFileState (ErasePolarity, FfsFileHeader);
+  if ((FileState != EFI_FILE_DATA_VALID) && (FileState != EFI_FILE_MARKED_FOR_UPDATE)) {
+    return NULL;
+  }
+
+  if (IS_FFS_FILE2 (FfsFileHeader)) {
+    if (!CompareGuid (&FwVolHeader->FileSystemGuid, &gEfiFirmwareFileSystem3Guid) ||
+        (FileOffset >= FwVolHeader->FvLength - sizeof (EFI_FFS_FILE_HEADER2))) {
+      return NULL;
+    }
+    FileLength   = FFS_FILE2_SIZE (FfsFileHeader);
+    HeaderLength = sizeof (EFI_FFS_FILE_HEADER2);
+  } else {
+    FileLength   = FFS_FILE_SIZE (FfsFileHeader);
+    HeaderLength = sizeof (EFI_FFS_FILE_HEADER);
+  }
+
+  if (CalculateHeaderChecksum (FfsFileHeader) != 0) {
+    return NULL;
+  }
+
+  if ((FileLength < HeaderLength) || (FileLength > FwVolHeader->FvLength - FileOffset)) {
+    return NULL;
+  }
+
+  if ((FfsFileHeader->Type != EFI_FV_FILETYPE_PEIM) &&
+      (FfsFileHeader->Type != EFI_FV_FILETYPE_COMBINED_PEIM_DRIVER) &&
+      (FfsFileHeader->Type != EFI_FV_FILETYPE_FIRMWARE_VOLUME_IMAGE)) {
+    return NULL;
+  }
+
+  DataCheckSum = FFS_FIXED_CHECKSUM;
+  if ((FfsFileHeader->Attributes & FFS_ATTRIB_CHECKSUM) == FFS_ATTRIB_CHECKSUM) {
+    DataCheckSum = CalculateCheckSum8 ((CONST UINT8 *) FfsFileHeader + HeaderLength, FileLength - HeaderLength);
+  }
+  if (FfsFileHeader->IntegrityCheck.Checksum.File != DataCheckSum) {
+    return NULL;
+  }
+
+  return (EFI_PEI_FILE_HANDLE) FfsFileHeader;
+}
+
 /**
   Get FV image(s) from the FV type file, then install FV INFO(2) PPI, Build FV(2, 3) HOB.
 
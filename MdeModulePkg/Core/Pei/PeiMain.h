@@ -26,6 +26,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Ppi/TemporaryRamDone.h>
 #include <Ppi/SecHobData.h>
 #include <Ppi/PeiCoreFvLocation.h>
+#include <Ppi/PeiDispatchPlan.h>
 #include <Library/DebugLib.h>
 #include <Library/PeiCoreEntryPoint.h>
 #include <Library/BaseLib.h>
@@ -45,6 +46,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Guid/FirmwareFileSystem3.h>
 #include <Guid/AprioriFileName.h>
 #include <Guid/MigratedFvInfo.h>
+#include <Guid/PeiDispatchPlan.h>
 
 ///
 /// It is an FFS type extension used for PeiFindFileEx. It indicates current
@@ -68,6 +70,28 @@ typedef union {
 #define CALLBACK_NOTIFY_GROWTH_STEP 32
 #define DISPATCH_NOTIFY_GROWTH_STEP 8
 
+///
+/// Number of buckets of the GUID hash index of a PPI or notify list, a power of 2
+///
+#define PPI_HASH_BUCKET_COUNT       32
+
+///
+/// GUID hash index of a PPI or notify list.
+/// The entries of the list whose GUID falls in the same bucket are chained
+/// in the order they were added to the list. A link holds the index of the
+/// entry plus 1, so that 0 ends a chain and a zeroed index is empty.
+///
+typedef struct {
+  ///
+  /// Link to the first entry of each bucket.
+  ///
+  UINT16                Buckets[PPI_HASH_BUCKET_COUNT];
+  ///
+  /// MaxCount number of entries. Link to the next entry in the same bucket.
+  ///
+  UINT16                *Next;
+} PEI_PPI_HASH_INDEX;
+
 typedef struct {
   UINTN                 CurrentCount;
   UINTN                 MaxCount;
@@ -76,6 +100,10 @@ typedef struct {
   /// MaxCount number of entries.
   ///
   PEI_PPI_LIST_POINTERS *PpiPtrs;
+  ///
+  /// GUID hash index of the CurrentCount entries.
+  ///
+  PEI_PPI_HASH_INDEX    HashIndex;
 } PEI_PPI_LIST;
 
 typedef struct {
@@ -85,6 +113,10 @@ typedef struct {
   /// MaxCount number of entries.
   ///
   PEI_PPI_LIST_POINTERS *NotifyPtrs;
+  ///
+  /// GUID hash index of the CurrentCount entries.
+  ///
+  PEI_PPI_HASH_INDEX    HashIndex;
 } PEI_CALLBACK_NOTIFY_LIST;
 
 typedef struct {
@@ -95,6 +127,10 @@ typedef struct {
   /// MaxCount number of entries.
   ///
   PEI_PPI_LIST_POINTERS *NotifyPtrs;
+  ///
+  /// GUID hash index of the CurrentCount entries.
+  ///
+  PEI_PPI_HASH_INDEX    HashIndex;
 } PEI_DISPATCH_NOTIFY_LIST;
 
 ///
@@ -146,6 +182,17 @@ typedef struct {
   EFI_PEI_FILE_HANDLE                 *FvFileHandles;
   BOOLEAN                             ScanFv;
   UINT32                              AuthenticationStatus;
+  //
+  // Number of files at the beginning of FvFileHandles listed in the Apriori file.
+  //
+  UINTN                               AprioriCount;
+  //
+  // Pointer to the buffer with the PeimCount number of Entries, holding the
+  // indexes in FvFileHandles of the DispatchedCount dispatched files in
+  // dispatch order. Only allocated when PcdRecordPeiDispatchPlan is TRUE.
+  //
+  UINT32                              *DispatchOrder;
+  UINTN                               DispatchedCount;
 } PEI_CORE_FV_HANDLE;
 
 typedef struct {
@@ -480,6 +527,17 @@ DepexSatisfied (
   IN UINTN                      PeimCount
   );
 
+/**
+  Record the dispatch plan of each firmware volume in a gEdkiiPeiDispatchPlanGuid HOB.
+
+  @param Private         PeiCore's private data structure
+
+**/
+VOID
+PeiRecordDispatchPlans (
+  IN PEI_CORE_INSTANCE          *Private
+  );
+
 //
 // PPI support functions
 //
@@ -1500,6 +1558,79 @@ FindNextCoreFvHandle (
   IN UINTN              Instance
   );
 
+/**
+  Initialize the header of the dispatch plan of a FV with the fields identifying the FV.
+
+  Only the FVs processed by the FFS2 and FFS3 EFI_PEI_FIRMWARE_VOLUME_PPI of the PEI Core,
+  and named by a FV extension header, can have a dispatch plan.
+
+  @param CoreFvHandle   Pointer of PEI_CORE_FV_HANDLE of the FV.
+  @param Plan           Pointer to the header of the dispatch plan.
+
+  @retval TRUE          The header is initialized.
+  @retval FALSE         The FV can't have a dispatch plan.
+
+**/
+BOOLEAN
+InitializeDispatchPlanHeader (
+  IN  PEI_CORE_FV_HANDLE        *CoreFvHandle,
+  OUT EDKII_PEI_DISPATCH_PLAN   *Plan
+  );
+
+/**
+  Get the offset of the free space of a FV, where FindFileEx() stops walking its files.
+
+  The files of the FV are walked as FindFileEx() does, so the offset is only computed
+  when the dispatch plans are recorded.
+
+  @param FvHandle       The handle of the FV.
+
+  @return The offset of the free space from the FV header.
+
+**/
+UINT32
+GetFvFreeSpaceOffset (
+  IN EFI_PEI_FV_HANDLE      FvHandle
+  );
+
+/**
+  Check the offset of the free space of a FV recorded in its dispatch plan.
+
+  Only the state of the file header at the offset is read: no file was added to
+  the free space of the FV if FindFileEx() still stops walking its files there.
+
+  @param FvHandle       The handle of the FV.
+  @param Plan           Pointer to the dispatch plan of the FV.
+
+  @retval TRUE          FindFileEx() stops walking the files of the FV at the offset.
+  @retval FALSE         The offset is invalid or a file was added to the free space.
+
+**/
+BOOLEAN
+IsDispatchPlanFreeSpaceOffset (
+  IN EFI_PEI_FV_HANDLE                  FvHandle,
+  IN CONST EDKII_PEI_DISPATCH_PLAN      *Plan
+  );
+
+/**
+  Get the handle of a file listed in the dispatch plan of a FV.
+
+  The file header at the offset given by the plan is checked as FindFileEx() does
+  when it walks the FV.
+
+  @param FvHandle       The handle of the FV.
+  @param PlanFile       Pointer to the file entry of the dispatch plan.
+
+  @return The handle of the file, or NULL if the file is not a valid PEIM, combined
+          PEIM/driver or FV image file with the name given by the plan.
+
+**/
+EFI_PEI_FILE_HANDLE
+GetDispatchPlanFileHandle (
+  IN EFI_PEI_FV_HANDLE                      FvHandle,
+  IN CONST EDKII_PEI_DISPATCH_PLAN_FILE     *PlanFile
+  );
+
 //
 // Default EFI_PEI_CPU_IO_PPI support for EFI_PEI_SERVICES table when PeiCore initialization.
 //
@@ -228,6 +228,9 @@ PeiCore (
           if (OldCoreData->Fv[Index].FvFileHandles != NULL) {
             OldCoreData->Fv[Index].FvFileHandles = (EFI_PEI_FILE_HANDLE *) ((UINT8 *) OldCoreData->Fv[Index].FvFileHandles + OldCoreData->HeapOffset);
           }
+          if (OldCoreData->Fv[Index].DispatchOrder != NULL) {
+            OldCoreData->Fv[Index].DispatchOrder = (UINT32 *) ((UINT8 *) OldCoreData->Fv[Index].DispatchOrder + OldCoreData->HeapOffset);
+          }
         }
         OldCoreData->TempFileGuid         = (EFI_GUID *) ((UINT8 *) OldCoreData->TempFileGuid + OldCoreData->HeapOffset);
         OldCoreData->TempFileHandles      = (EFI_PEI_FILE_HANDLE *) ((UINT8 *) OldCoreData->TempFileHandles + OldCoreData->HeapOffset);
@@ -256,6 +259,9 @@ PeiCore (
           if (OldCoreData->Fv[Index].FvFileHandles != NULL) {
             OldCoreData->Fv[Index].FvFileHandles = (EFI_PEI_FILE_HANDLE *) ((UINT8 *) OldCoreData->Fv[Index].FvFileHandles - OldCoreData->HeapOffset);
           }
+          if (OldCoreData->Fv[Index].DispatchOrder != NULL) {
+            OldCoreData->Fv[Index].DispatchOrder = (UINT32 *) ((UINT8 *) OldCoreData->Fv[Index].DispatchOrder - OldCoreData->HeapOffset);
+          }
         }
         OldCoreData->TempFileGuid         = (EFI_GUID *) ((UINT8 *) OldCoreData->TempFileGuid - OldCoreData->HeapOffset);
         OldCoreData->TempFileHandles      = (EFI_PEI_FILE_HANDLE *) ((UINT8 *) OldCoreData->TempFileHandles - OldCoreData->HeapOffset);
@@ -476,6 +482,13 @@ PeiCore (
     // Check if InstallPeiMemory service was called on non-S3 resume boot path.
     //
     ASSERT(PrivateData.PeiMemoryInstalled == TRUE);
+
+    //
+    // Record the dispatch plans for the platform to use on the next boots.
+    //
+    if (PcdGetBool (PcdRecordPeiDispatchPlan)) {
+      PeiRecordDispatchPlans (&PrivateData);
+    }
   }
 
   //
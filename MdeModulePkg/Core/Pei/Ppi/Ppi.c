@@ -196,6 +196,14 @@ ConvertPpiPointers (
       &PrivateData->PpiData.DispatchNotifyList.NotifyPtrs[Index]
       );
   }
+
+  //
+  // Convert the links of the GUID hash indexes. The GUIDs don't change, so the
+  // buckets stay valid.
+  //
+  ConvertPointerInRanges (SecCoreData, PrivateData, (VOID **) &PrivateData->PpiData.PpiList.HashIndex.Next);
+  ConvertPointerInRanges (SecCoreData, PrivateData, (VOID **) &PrivateData->PpiData.CallbackNotifyList.HashIndex.Next);
+  ConvertPointerInRanges (SecCoreData, PrivateData, (VOID **) &PrivateData->PpiData.DispatchNotifyList.HashIndex.Next);
 }
 
 /**
@@ -419,6 +427,172 @@ DumpPpiList (
   DEBUG_CODE_END ();
 }
 
+/**
+
+  Get the bucket of a GUID in the GUID hash index of a PPI or notify list.
+
+  @param Guid            Pointer to the GUID.
+
+  @return The index of the bucket.
+
+**/
+UINTN
+PpiGuidHash (
+  IN CONST EFI_GUID       *Guid
+  )
+{
+  UINT32                Hash;
+
+  Hash = ((UINT32 *)Guid)[0] ^ ((UINT32 *)Guid)[1] ^ ((UINT32 *)Guid)[2] ^ ((UINT32 *)Guid)[3];
+  Hash ^= Hash >> 16;
+  Hash ^= Hash >> 8;
+  return Hash & (PPI_HASH_BUCKET_COUNT - 1);
+}
+
+/**
+
+  Grow the GUID hash index of a PPI or notify list along with the list.
+
+  @param HashIndex       Pointer to the GUID hash index.
+  @param OldMaxCount     Number of entries of the list before it grows.
+  @param NewMaxCount     Number of entries of the list after it grows.
+
+**/
+VOID
+GrowPpiHashIndex (
+  IN OUT PEI_PPI_HASH_INDEX  *HashIndex,
+  IN UINTN                   OldMaxCount,
+  IN UINTN                   NewMaxCount
+  )
+{
+  VOID                  *TempPtr;
+
+  //
+  // The links are UINT16 indexes plus 1.
+  //
+  ASSERT (NewMaxCount < MAX_UINT16);
+  TempPtr = AllocateZeroPool (sizeof (UINT16) * NewMaxCount);
+  ASSERT (TempPtr != NULL);
+  CopyMem (
+    TempPtr,
+    HashIndex->Next,
+    sizeof (UINT16) * OldMaxCount
+    );
+  HashIndex->Next = TempPtr;
+}
+
+/**
+
+  Add the last entry of a PPI or notify list to the GUID hash index of the list.
+  The entry is chained at the end of its bucket, so that the chains stay in the
+  order of the list.
+
+  @param HashIndex       Pointer to the GUID hash index.
+  @param Guid            Pointer to the GUID of the entry.
+  @param Index           Index of the entry in the list.
+
+**/
+VOID
+AddPpiHashEntry (
+  IN OUT PEI_PPI_HASH_INDEX  *HashIndex,
+  IN CONST EFI_GUID          *Guid,
+  IN UINTN                   Index
+  )
+{
+  UINT16                *Link;
+
+  Link = &HashIndex->Buckets[PpiGuidHash (Guid)];
+  while (*Link != 0) {
+    Link = &HashIndex->Next[*Link - 1];
+  }
+  *Link = (UINT16) (Index + 1);
+  HashIndex->Next[Index] = 0;
+}
+
+/**
+
+  Rebuild the GUID hash index of a PPI or notify list from the entries of the list.
+
+  @param HashIndex       Pointer to the GUID hash index.
+  @param ListPtrs        Pointer to the entries of the list.
+  @param Count           Number of entries of the list.
+
+**/
+VOID
+RebuildPpiHashIndex (
+  IN OUT PEI_PPI_HASH_INDEX     *HashIndex,
+  IN PEI_PPI_LIST_POINTERS      *ListPtrs,
+  IN UINTN                      Count
+  )
+{
+  UINTN                 Index;
+
+  ZeroMem (HashIndex->Buckets, sizeof (HashIndex->Buckets));
+  for (Index = 0; Index < Count; Index++) {
+    //
+    // The PPI and notify descriptors both start with the Flags and the Guid.
+    //
+    AddPpiHashEntry (HashIndex, ListPtrs[Index].Ppi->Guid, Index);
+  }
+}
+
+/**
+
+  Find the first entry of a PPI or notify list with a given GUID in a range of
+  entries, using the GUID hash index of the list.
+
+  @param HashIndex       Pointer to the GUID hash index.
+  @param ListPtrs        Pointer to the entries of the list.
+  @param Guid            Pointer to the GUID to find.
+  @param StartIndex      Index of the first entry of the range.
+  @param StopIndex       Index after the last entry of the range.
+
+  @return The index of the entry found, StopIndex if no entry of the range has the GUID.
+
+**/
+UINTN
+FindPpiHashEntry (
+  IN PEI_PPI_HASH_INDEX       *HashIndex,
+  IN PEI_PPI_LIST_POINTERS    *ListPtrs,
+  IN CONST EFI_GUID           *Guid,
+  IN UINTN                    StartIndex,
+  IN UINTN                    StopIndex
+  )
+{
+  UINT16                Link;
+  UINTN                 Index;
+  EFI_GUID              *CheckGuid;
+
+  for (Link = HashIndex->Buckets[PpiGuidHash (Guid)]; Link != 0; Link = HashIndex->Next[Index]) {
+    Index = Link - 1;
+    if (Index >= StopIndex) {
+      //
+      // The chain is in the order of the list, no more entries in the range.
+      //
+      break;
+    }
+    if (Index < StartIndex) {
+      continue;
+    }
+
+    //
+    // The PPI and notify descriptors both start with the Flags and the Guid.
+    // Don't use CompareGuid function here for performance reasons.
+    // Instead we compare the GUID as INT32 at a time and branch
+    // on the first failed comparison.
+    //
+    CheckGuid = ListPtrs[Index].Ppi->Guid;
+    if ((((INT32 *)Guid)[0] == ((INT32 *)CheckGuid)[0]) &&
+        (((INT32 *)Guid)[1] == ((INT32 *)CheckGuid)[1]) &&
+        (((INT32 *)Guid)[2] == ((INT32 *)CheckGuid)[2]) &&
+        (((INT32 *)Guid)[3] == ((INT32 *)CheckGuid)[3])) {
+      return Index;
+    }
+  }
+
+  return StopIndex;
+}
+
 /**
 
   This function installs an interface in the PEI PPI database by GUID.
@@ -492,6 +666,11 @@ InternalPeiInstallPpi (
         sizeof (PEI_PPI_LIST_POINTERS) * PpiListPointer->MaxCount
         );
       PpiListPointer->PpiPtrs = TempPtr;
+      GrowPpiHashIndex (
+        &PpiListPointer->HashIndex,
+        PpiListPointer->MaxCount,
+        PpiListPointer->MaxCount + PPI_GROWTH_STEP
+        );
       PpiListPointer->MaxCount = PpiListPointer->MaxCount + PPI_GROWTH_STEP;
     }
 
@@ -518,6 +697,13 @@ InternalPeiInstallPpi (
     PpiList++;
   }
 
+  //
+  // Add the newly installed PPIs to the GUID hash index.
+  //
+  for (Index = LastCount; Index < PpiListPointer->CurrentCount; Index++) {
+    AddPpiHashEntry (&PpiListPointer->HashIndex, PpiListPointer->PpiPtrs[Index].Ppi->Guid, Index);
+  }
+
   //
   // Process any callback level notifies for newly installed PPIs.
   //
@@ -616,6 +802,18 @@ PeiReInstallPpi (
   DEBUG((EFI_D_INFO, "Reinstall PPI: %g\n", NewPpi->Guid));
   PrivateData->PpiData.PpiList.PpiPtrs[Index].Ppi = (EFI_PEI_PPI_DESCRIPTOR *) NewPpi;
 
+  //
+  // The new PPI may have another GUID, which moves it to another bucket of
+  // the GUID hash index.
+  //
+  if (!CompareGuid (OldPpi->Guid, NewPpi->Guid)) {
+    RebuildPpiHashIndex (
+      &PrivateData->PpiData.PpiList.HashIndex,
+      PrivateData->PpiData.PpiList.PpiPtrs,
+      PrivateData->PpiData.PpiList.CurrentCount
+      );
+  }
+
   //
   // Process any callback level notifies for the newly installed PPI.
   //
@@ -658,18 +856,23 @@ PeiLocatePpi (
   )
 {
   PEI_CORE_INSTANCE         *PrivateData;
-  UINTN                     Index;
+  PEI_PPI_LIST              *PpiListPointer;
+  UINT16                    Link;
   EFI_GUID                  *CheckGuid;
   EFI_PEI_PPI_DESCRIPTOR    *TempPtr;
 
 
   PrivateData = PEI_CORE_INSTANCE_FROM_PS_THIS(PeiServices);
+  PpiListPointer = &PrivateData->PpiData.PpiList;
 
   //
-  // Search the data base for the matching instance of the GUIDed PPI.
+  // Search the bucket of the GUID in the GUID hash index for the matching
+  // instance of the GUIDed PPI. The bucket is in the order of installation.
   //
-  for (Index = 0; Index < PrivateData->PpiData.PpiList.CurrentCount; Index++) {
-    TempPtr = PrivateData->PpiData.PpiList.PpiPtrs[Index].Ppi;
+  for (Link = PpiListPointer->HashIndex.Buckets[PpiGuidHash (Guid)];
+       Link != 0;
+       Link = PpiListPointer->HashIndex.Next[Link - 1]) {
+    TempPtr = PpiListPointer->PpiPtrs[Link - 1].Ppi;
     CheckGuid = TempPtr->Guid;
 
     //
@@ -780,6 +983,11 @@ InternalPeiNotifyPpi (
           sizeof (PEI_PPI_LIST_POINTERS) * CallbackNotifyListPointer->MaxCount
           );
         CallbackNotifyListPointer->NotifyPtrs = TempPtr;
+        GrowPpiHashIndex (
+          &CallbackNotifyListPointer->HashIndex,
+          CallbackNotifyListPointer->MaxCount,
+          CallbackNotifyListPointer->MaxCount + CALLBACK_NOTIFY_GROWTH_STEP
+          );
         CallbackNotifyListPointer->MaxCount = CallbackNotifyListPointer->MaxCount + CALLBACK_NOTIFY_GROWTH_STEP;
       }
       CallbackNotifyListPointer->NotifyPtrs[CallbackNotifyIndex].Notify = (EFI_PEI_NOTIFY_DESCRIPTOR *) NotifyList;
@@ -800,6 +1008,11 @@ InternalPeiNotifyPpi (
           sizeof (PEI_PPI_LIST_POINTERS) * DispatchNotifyListPointer->MaxCount
           );
         DispatchNotifyListPointer->NotifyPtrs = TempPtr;
+        GrowPpiHashIndex (
+          &DispatchNotifyListPointer->HashIndex,
+          DispatchNotifyListPointer->MaxCount,
+          DispatchNotifyListPointer->MaxCount + DISPATCH_NOTIFY_GROWTH_STEP
+          );
         DispatchNotifyListPointer->MaxCount = DispatchNotifyListPointer->MaxCount + DISPATCH_NOTIFY_GROWTH_STEP;
       }
       DispatchNotifyListPointer->NotifyPtrs[DispatchNotifyIndex].Notify = (EFI_PEI_NOTIFY_DESCRIPTOR *) NotifyList;
@@ -827,6 +1040,24 @@ InternalPeiNotifyPpi (
     NotifyList++;
   }
 
+  //
+  // Add the newly registered notifies to the GUID hash indexes.
+  //
+  for (CallbackNotifyIndex = LastCallbackNotifyCount; CallbackNotifyIndex < CallbackNotifyListPointer->CurrentCount; CallbackNotifyIndex++) {
+    AddPpiHashEntry (
+      &CallbackNotifyListPointer->HashIndex,
+      CallbackNotifyListPointer->NotifyPtrs[CallbackNotifyIndex].Notify->Guid,
+      CallbackNotifyIndex
+      );
+  }
+  for (DispatchNotifyIndex = LastDispatchNotifyCount; DispatchNotifyIndex < DispatchNotifyListPointer->CurrentCount; DispatchNotifyIndex++) {
+    AddPpiHashEntry (
+      &DispatchNotifyListPointer->HashIndex,
+      DispatchNotifyListPointer->NotifyPtrs[DispatchNotifyIndex].Notify->Guid,
+      DispatchNotifyIndex
+      );
+  }
+
   //
   // Process any callback level notifies for all previously installed PPIs.
   //
@@ -954,40 +1185,70 @@ ProcessNotify (
 {
   INTN                          Index1;
   INTN                          Index2;
+  INTN                          NextIndex;
+  BOOLEAN                       SearchNotifies;
   EFI_GUID                      *SearchGuid;
   EFI_GUID                      *CheckGuid;
   EFI_PEI_NOTIFY_DESCRIPTOR     *NotifyDescriptor;
+  PEI_PPI_LIST                  *PpiListPointer;
+  PEI_PPI_HASH_INDEX            *NotifyHashIndex;
+  PEI_PPI_LIST_POINTERS         **NotifyPtrs;
+
+  PpiListPointer = &PrivateData->PpiData.PpiList;
+  if (NotifyType == EFI_PEI_PPI_DESCRIPTOR_NOTIFY_CALLBACK) {
+    NotifyHashIndex = &PrivateData->PpiData.CallbackNotifyList.HashIndex;
+    NotifyPtrs      = &PrivateData->PpiData.CallbackNotifyList.NotifyPtrs;
+  } else {
+    NotifyHashIndex = &PrivateData->PpiData.DispatchNotifyList.HashIndex;
+    NotifyPtrs      = &PrivateData->PpiData.DispatchNotifyList.NotifyPtrs;
+  }
+
+  //
+  // The notifies are fired in the order of the notify list, and for each notify
+  // in the order of the PPI list, as the nested scan of both lists would do.
+  // When fewer PPIs than notifies are processed, the notifies matching the PPIs
+  // are found through the GUID hash index of the notify list, otherwise each
+  // notify finds its PPIs through the GUID hash index of the PPI list.
+  // The lists and the indexes are read again after each notify, which may
+  // install PPIs and notifies.
+  //
+  SearchNotifies = (BOOLEAN) ((InstallStopIndex - InstallStartIndex) < (NotifyStopIndex - NotifyStartIndex));
 
   for (Index1 = NotifyStartIndex; Index1 < NotifyStopIndex; Index1++) {
-    if (NotifyType == EFI_PEI_PPI_DESCRIPTOR_NOTIFY_CALLBACK) {
-      NotifyDescriptor = PrivateData->PpiData.CallbackNotifyList.NotifyPtrs[Index1].Notify;
-    } else {
-      NotifyDescriptor = PrivateData->PpiData.DispatchNotifyList.NotifyPtrs[Index1].Notify;
+    if (SearchNotifies) {
+      NextIndex = NotifyStopIndex;
+      for (Index2 = InstallStartIndex; Index2 < InstallStopIndex; Index2++) {
+        NextIndex = (INTN) FindPpiHashEntry (
+                             NotifyHashIndex,
+                             *NotifyPtrs,
+                             PpiListPointer->PpiPtrs[Index2].Ppi->Guid,
+                             (UINTN) Index1,
+                             (UINTN) NextIndex
+                             );
+      }
+      Index1 = NextIndex;
+      if (Index1 == NotifyStopIndex) {
+        break;
+      }
     }
 
+    NotifyDescriptor = (*NotifyPtrs)[Index1].Notify;
+
     CheckGuid = NotifyDescriptor->Guid;
 
-    for (Index2 = InstallStartIndex; Index2 < InstallStopIndex; Index2++) {
-      SearchGuid = PrivateData->PpiData.PpiList.PpiPtrs[Index2].Ppi->Guid;
-      //
-      // Don't use CompareGuid function here for performance reasons.
-      // Instead we compare the GUID as INT32 at a time and branch
-      // on the first failed comparison.
-      //
-      if ((((INT32 *)SearchGuid)[0] == ((INT32 *)CheckGuid)[0]) &&
-          (((INT32 *)SearchGuid)[1] == ((INT32 *)CheckGuid)[1]) &&
-          (((INT32 *)SearchGuid)[2] == ((INT32 *)CheckGuid)[2]) &&
-          (((INT32 *)SearchGuid)[3] == ((INT32 *)CheckGuid)[3])) {
-        DEBUG ((EFI_D_INFO, "Notify: PPI Guid: %g, Peim notify entry point: %p\n",
-          SearchGuid,
-          NotifyDescriptor->Notify
-          ));
-        NotifyDescriptor->Notify (
-                            (EFI_PEI_SERVICES **) GetPeiServicesTablePointer (),
-                            NotifyDescriptor,
-                            (PrivateData->PpiData.PpiList.PpiPtrs[Index2].Ppi)->Ppi
-                            );
-      }
+    for (Index2 = (INTN) FindPpiHashEntry (&PpiListPointer->HashIndex, PpiListPointer->PpiPtrs, CheckGuid, (UINTN) InstallStartIndex, (UINTN) InstallStopIndex);
+         Index2 < InstallStopIndex;
+         Index2 = (INTN) FindPpiHashEntry (&PpiListPointer->HashIndex, PpiListPointer->PpiPtrs, CheckGuid, (UINTN) Index2 + 1, (UINTN) InstallStopIndex)) {
+      SearchGuid = PpiListPointer->PpiPtrs[Index2].Ppi->Guid;
+      DEBUG ((EFI_D_INFO, "Notify: PPI Guid: %g, Peim notify entry point: %p\n",
+        SearchGuid,
+        NotifyDescriptor->Notify
+        ));
+      NotifyDescriptor->Notify (
+                          (EFI_PEI_SERVICES **) GetPeiServicesTablePointer (),
+                          NotifyDescriptor,
+                          (PpiListPointer->PpiPtrs[Index2].Ppi)->Ppi
+                          );
     }
   }
 }
@@ -23,7 +23,16 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #define LZMAF86_CUSTOM_DECOMPRESS_GUID  \
   { 0xD42AE6BD, 0x1352, 0x4bfb, { 0x90, 0x9A, 0xCA, 0x72, 0xA6, 0xEA, 0xE8, 0x89 } }
 
+///
+/// The Global ID used to identify a section of an FFS file of type
+/// EFI_SECTION_GUID_DEFINED, whose contents have been compressed using LZMA
+/// in independent blocks, so that they can be compressed in parallel.
+///
+#define LZMA_PARALLEL_CUSTOM_DECOMPRESS_GUID  \
+  { 0xE98A1649, 0xE980, 0x45EB, { 0x8A, 0xA4, 0xA8, 0xD8, 0x84, 0x54, 0xE6, 0x3B } }
+
 extern GUID gLzmaCustomDecompressGuid;
 extern GUID gLzmaF86CustomDecompressGuid;
+extern GUID gLzmaParallelCustomDecompressGuid;
 
 #endif
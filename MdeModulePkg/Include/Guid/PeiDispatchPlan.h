@@ -0,0 +1,80 @@
+/** @file
+  Define the PEI dispatch plan of a firmware volume.
+
+  A dispatch plan lists the offsets of the PEIM and FV image files of a
+  firmware volume, in the order they were dispatched by the PEI Core. The PEI
+  Core records the plan of each firmware volume in a GUID HOB at the end of the
+  PEI phase when PcdRecordPeiDispatchPlan is TRUE. A platform may save the
+  plans and give them back to the PEI Core on a later boot through the
+  EDKII_PEI_DISPATCH_PLAN_PPI, so that the PEI Core does not have to walk the
+  firmware volume to discover its PEIMs.
+
+  Copyright (c) 2026, agent. All rights reserved.<BR>
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef __EDKII_PEI_DISPATCH_PLAN_GUID_H__
+#define __EDKII_PEI_DISPATCH_PLAN_GUID_H__
+
+///
+/// The GUID of the HOBs holding the dispatch plans recorded by the PEI Core.
+///
+#define EDKII_PEI_DISPATCH_PLAN_GUID \
+  { \
+    0x6289bb96, 0x0305, 0x4251, { 0x8d, 0x33, 0x05, 0x21, 0x9f, 0xb4, 0x60, 0x7c } \
+  }
+
+#define EDKII_PEI_DISPATCH_PLAN_SIGNATURE  SIGNATURE_32 ('P', 'D', 'P', 'L')
+
+typedef struct {
+  ///
+  /// Offset of the FFS file header from the firmware volume header.
+  ///
+  UINT32                          Offset;
+  ///
+  /// Name of the FFS file.
+  ///
+  EFI_GUID                        FileName;
+} EDKII_PEI_DISPATCH_PLAN_FILE;
+
+typedef struct {
+  ///
+  /// EDKII_PEI_DISPATCH_PLAN_SIGNATURE.
+  ///
+  UINT32                          Signature;
+  ///
+  /// Size in bytes of the plan, including the array of files.
+  ///
+  UINT32                          Size;
+  ///
+  /// The firmware volume the plan was recorded from: FvName of its extended
+  /// header, FvLength and Checksum of its header, and the offset of its free
+  /// space, i.e. the offset at which the PEI Core stops walking the files of
+  /// the firmware volume. A file added to the free space of the firmware
+  /// volume changes the offset, which the PEI Core checks with a single read
+  /// of the file header state at that offset.
+  ///
+  EFI_GUID                        FvName;
+  UINT64                          FvLength;
+  UINT32                          FvFreeSpaceOffset;
+  UINT16                          FvChecksum;
+  UINT16                          Reserved;
+  ///
+  /// Number of files at the beginning of the array which are dispatched
+  /// without evaluating their dependency expression, as the files listed
+  /// in the PEI Apriori file.
+  ///
+  UINT32                          AprioriCount;
+  ///
+  /// Number of files in the array following this structure. The files are
+  /// the PEIM and FV image files of the firmware volume in dispatch order.
+  ///
+  UINT32                          FileCount;
+//EDKII_PEI_DISPATCH_PLAN_FILE    File[FileCount];
+} EDKII_PEI_DISPATCH_PLAN;
+
+extern EFI_GUID gEdkiiPeiDispatchPlanGuid;
+
+#endif // #ifndef __EDKII_PEI_DISPATCH_PLAN_GUID_H__
@@ -0,0 +1,49 @@
+/** @file
+  Define the EDKII_PEI_DISPATCH_PLAN_PPI that gives the PEI Core the dispatch
+  plans recorded on a previous boot.
+
+  The PEI Core looks for the PPI when it discovers the PEIMs of a firmware
+  volume. A plan is only followed if it was recorded from the same firmware
+  volume and all the files it lists are found at their offsets, otherwise the
+  PEI Core walks the firmware volume. To use the plans of the boot firmware
+  volume, the PPI must be in the PPI list passed by SEC to the PEI Core.
+
+  The PEI Core trusts the order and the offsets of the files given by a plan:
+  it only checks the identity of the firmware volume, the headers of the files
+  listed by the plan and the start of the free space of the firmware volume. A
+  PEIM written in place of a file not listed by the plan is not detected. The
+  plans must therefore come from storage protected like the firmware volume
+  itself, e.g. in the same write protected or verified region, and must not be
+  read from storage that can be modified after the firmware volume is locked.
+
+  Copyright (c) 2026, agent. All rights reserved.<BR>
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef __EDKII_PEI_DISPATCH_PLAN_PPI_H__
+#define __EDKII_PEI_DISPATCH_PLAN_PPI_H__
+
+#include <Guid/PeiDispatchPlan.h>
+
+#define EDKII_PEI_DISPATCH_PLAN_PPI_GUID \
+  { \
+    0x3aed1926, 0xb646, 0x4c1c, { 0x9a, 0x8a, 0xa6, 0x6c, 0xc2, 0x41, 0x7e, 0x90 } \
+  }
+
+typedef struct {
+  ///
+  /// Number of entries of Plans.
+  ///
+  UINTN                           PlanCount;
+  ///
+  /// Pointers to the dispatch plans, in the format of the data of the
+  /// gEdkiiPeiDispatchPlanGuid HOBs.
+  ///
+  CONST EDKII_PEI_DISPATCH_PLAN   **Plans;
+} EDKII_PEI_DISPATCH_PLAN_PPI;
+
+extern EFI_GUID gEdkiiPeiDispatchPlanPpiGuid;
+
+#endif // #ifndef __EDKII_PEI_DISPATCH_PLAN_PPI_H__
@@ -219,3 +219,144 @@ LzmaUefiDecompress (
   }
 }
 
+/**
+  Given a LZMA block container, this function retrieves the size of the
+  uncompressed buffer and the size of the scratch buffer required to
+  decompress it.
+
+  @param  Source          The source buffer containing the compressed data.
+  @param  SourceSize      The size, in bytes, of the source buffer.
+  @param  DestinationSize A pointer to the size, in bytes, of the uncompressed buffer
+                          that will be generated when the compressed buffer specified
+                          by Source and SourceSize is decompressed.
+  @param  ScratchSize     A pointer to the size, in bytes, of the scratch buffer that
+                          is required to decompress the compressed buffer specified
+                          by Source and SourceSize.
+
+  @retval  RETURN_SUCCESS The size of the uncompressed data was returned
+                          in DestinationSize and the size of the scratch
+                          buffer was returned in ScratchSize.
+  @retval  RETURN_INVALID_PARAMETER
+                          Source is not a LZMA block container.
+  @retval  RETURN_UNSUPPORTED
+                          DestinationSize cannot be output because the
+                          uncompressed buffer size (in bytes) does not fit
+                          in a UINT32. Output parameters have not been
+                          modified.
+**/
+RETURN_STATUS
+EFIAPI
+LzmaParallelUefiDecompressGetInfo (
+  IN  CONST VOID  *Source,
+  IN  UINT32      SourceSize,
+  OUT UINT32      *DestinationSize,
+  OUT UINT32      *ScratchSize
+  )
+{
+  CONST LZMA_PARALLEL_HEADER  *Header;
+  UINT64                      DecodedSize;
+
+  Header = (CONST LZMA_PARALLEL_HEADER *)Source;
+  if ((SourceSize < sizeof (LZMA_PARALLEL_HEADER)) ||
+      (ReadUnaligned32 (&Header->Signature) != LZMA_PARALLEL_SIGNATURE)) {
+    return RETURN_INVALID_PARAMETER;
+  }
+
+  DecodedSize = ReadUnaligned64 (&Header->UncompressedSize);
+  if (DecodedSize > MAX_UINT32) {
+    return RETURN_UNSUPPORTED;
+  }
+
+  //
+  // The blocks are decompressed one at a time, they share the scratch buffer.
+  //
+  *DestinationSize = (UINT32)DecodedSize;
+  *ScratchSize     = SCRATCH_BUFFER_REQUEST_SIZE;
+  return RETURN_SUCCESS;
+}
+
+/**
+  Decompresses a LZMA block container.
+
+  The blocks are decompressed one after the other into Destination, reusing
+  the same scratch buffer.
+
+  @param  Source      The source buffer containing the compressed data.
+  @param  SourceSize  The size of source buffer.
+  @param  Destination The destination buffer to store the decompressed data
+  @param  Scratch     A temporary scratch buffer that is used to perform the decompression.
+
+  @retval  RETURN_SUCCESS Decompression completed successfully, and
+                          the uncompressed buffer is returned in Destination.
+  @retval  RETURN_INVALID_PARAMETER
+                          The source buffer specified by Source is corrupted
+                          (not in a valid compressed format).
+**/
+RETURN_STATUS
+EFIAPI
+LzmaParallelUefiDecompress (
+  IN CONST VOID  *Source,
+  IN UINTN       SourceSize,
+  IN OUT VOID    *Destination,
+  IN OUT VOID    *Scratch
+  )
+{
+  CONST LZMA_PARALLEL_HEADER  *Header;
+  CONST UINT8                 *SizeTable;
+  CONST UINT8                 *Block;
+  UINT32                      BlockSize;
+  UINT32                      BlockCount;
+  UINT64                      DecodedSize;
+  UINTN                       Offset;
+  UINTN                       DestinationOffset;
+  UINTN                       BlockInSize;
+  UINT64                      BlockOutSize;
+  UINT32                      Index;
+  RETURN_STATUS               Status;
+
+  Header = (CONST LZMA_PARALLEL_HEADER *)Source;
+  if ((SourceSize < sizeof (LZMA_PARALLEL_HEADER)) ||
+      (ReadUnaligned32 (&Header->Signature) != LZMA_PARALLEL_SIGNATURE)) {
+    return RETURN_INVALID_PARAMETER;
+  }
+
+  BlockSize   = ReadUnaligned32 (&Header->BlockSize);
+  BlockCount  = ReadUnaligned32 (&Header->BlockCount);
+  DecodedSize = ReadUnaligned64 (&Header->UncompressedSize);
+  if ((BlockSize == 0) ||
+      (DecodedSize > MAX_UINT32) ||
+      (BlockCount > (SourceSize - sizeof (LZMA_PARALLEL_HEADER)) / sizeof (UINT32)) ||
+      (DivU64x32 (DecodedSize + BlockSize - 1, BlockSize) != BlockCount)) {
+    return RETURN_INVALID_PARAMETER;
+  }
+
+  SizeTable         = (CONST UINT8 *)(Header + 1);
+  Offset            = sizeof (LZMA_PARALLEL_HEADER) + BlockCount * sizeof (UINT32);
+  DestinationOffset = 0;
+  for (Index = 0; Index < BlockCount; Index++) {
+    Block        = (CONST UINT8 *)Source + Offset;
+    BlockInSize  = ReadUnaligned32 ((CONST UINT32 *)(SizeTable + Index * sizeof (UINT32)));
+    BlockOutSize = MIN (BlockSize, DecodedSize - DestinationOffset);
+    if ((BlockInSize < LZMA_HEADER_SIZE) ||
+        (BlockInSize > SourceSize - Offset) ||
+        (GetDecodedSizeOfBuf ((UINT8 *)Block) != BlockOutSize)) {
+      return RETURN_INVALID_PARAMETER;
+    }
+
+    Status = LzmaUefiDecompress (
+               Block,
+               BlockInSize,
+               (UINT8 *)Destination + DestinationOffset,
+               Scratch
+               );
+    if (RETURN_ERROR (Status)) {
+      return Status;
+    }
+
+    Offset            += BlockInSize;
+    DestinationOffset += (UINTN)BlockOutSize;
+  }
+
+  return RETURN_SUCCESS;
+}
+
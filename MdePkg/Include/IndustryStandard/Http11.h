@@ -247,6 +247,20 @@
 ///
 #define  HTTP_EXPECT_100_CONTINUE       "100-continue"
 
+///
+/// Connection Header
+/// The "Connection" header field allows the sender to indicate desired
+/// control options for the current connection. A sender uses the "close"
+/// connection option to signal that the connection will be closed after
+/// completion of the response.
+///
+#define  HTTP_HEADER_CONNECTION         "Connection"
+
+///
+/// Connection Header Value
+///
+#define  HTTP_CONNECTION_CLOSE          "close"
+
 #pragma pack()
 
 #endif
@@ -28,25 +28,105 @@ EFI_DPC_PROTOCOL mDpc = {
 };
 
 //
-// Global variables used to measure the DPC Queue Depths
+// Counters used to measure the DPC queues
 //
-UINTN  mDpcQueueDepth = 0;
-UINTN  mMaxDpcQueueDepth = 0;
+DPC_STATISTICS  mDpcStatistics;
 
 //
-// Free list of DPC entries.  As DPCs are queued, entries are removed from this
-// free list.  As DPC entries are dispatched, DPC entries are added to the free list.
-// If the free list is empty and a DPC is queued, the free list is grown by allocating
-// an additional set of DPC entries.
+// An array of DPC queues.  A DPC queue is allocated for every level EFI_TPL value.
+// As DPCs are queued, they are added to the tail of the ring buffer.
+// As DPCs are dispatched, they are removed from the head of the ring buffer.
+// The ring buffer of a DPC queue is allocated when the first DPC is queued at
+// its EFI_TPL, and grows when it is full.
 //
-LIST_ENTRY      mDpcEntryFreeList = INITIALIZE_LIST_HEAD_VARIABLE(mDpcEntryFreeList);
+DPC_QUEUE       mDpcQueue[TPL_HIGH_LEVEL + 1];
 
 //
-// An array of DPC queues.  A DPC queue is allocated for every level EFI_TPL value.
-// As DPCs are queued, they are added to the end of the linked list.
-// As DPCs are dispatched, they are removed from the beginning of the linked list.
+// An array of DPC batches, one for every level EFI_TPL value.  A DPC batch holds
+// the DPCs taken off the DPC queue of the same EFI_TPL that are being invoked.
+// It is only accessed at that EFI_TPL or above, so the DPCs in a batch can be
+// invoked one after the other without raising the TPL to TPL_HIGH_LEVEL.
 //
-LIST_ENTRY      mDpcQueue[TPL_HIGH_LEVEL + 1];
+DPC_BATCH       mDpcBatch[TPL_HIGH_LEVEL + 1];
+
+/**
+  Grow the ring buffer of a DPC queue so that at least one more DPC can be added.
+
+  This function must be called at TPL_HIGH_LEVEL.  The TPL is temporarily lowered
+  to OriginalTpl to perform the memory allocation, so the DPC queue may change
+  while this function runs.
+
+  @param  Queue         The DPC queue to grow.
+  @param  OriginalTpl   The TPL that the DPC was queued at.
+
+  @retval EFI_SUCCESS            The DPC queue has room for one more DPC.
+  @retval EFI_OUT_OF_RESOURCES   The DPC queue is full and could not be grown.
+
+**/
+EFI_STATUS
+DpcQueueGrow (
+  IN DPC_QUEUE  *Queue,
+  IN EFI_TPL    OriginalTpl
+  )
+{
+  DPC_ENTRY  *NewEntries;
+  DPC_ENTRY  *FreeEntries;
+  UINTN      NewSize;
+  UINTN      Index;
+
+  //
+  // If the current TPL is greater than TPL_NOTIFY, then memory allocations
+  // can not be performed, so the DPC queue can not be expanded.
+  //
+  if (OriginalTpl > TPL_NOTIFY) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  NewSize = (Queue->Size == 0) ? DPC_QUEUE_INITIAL_SIZE : Queue->Size * 2;
+
+  //
+  // Lower the TPL level to perform a memory allocation
+  //
+  gBS->RestoreTPL (OriginalTpl);
+  NewEntries = AllocatePool (NewSize * sizeof (DPC_ENTRY));
+  gBS->RaiseTPL (TPL_HIGH_LEVEL);
+
+  if (NewEntries == NULL) {
+    return (Queue->Count < Queue->Size) ? EFI_SUCCESS : EFI_OUT_OF_RESOURCES;
+  }
+
+  //
+  // The DPC queue may have been grown by a DPC queued at a higher TPL while the
+  // TPL was lowered.  Only replace the ring buffer if it is still smaller.
+  //
+  if (Queue->Size < NewSize) {
+    for (Index = 0; Index < Queue->Count; Index++) {
+      CopyMem (
+        &NewEntries[Index],
+        &Queue->Entries[(Queue->Head + Index) & (Queue->Size - 1)],
+        sizeof (DPC_ENTRY)
+        );
+    }
+
+    FreeEntries    = Queue->Entries;
+    Queue->Entries = NewEntries;
+    Queue->Size    = NewSize;
+    Queue->Head    = 0;
+  } else {
+    FreeEntries = NewEntries;
+  }
+
+  if (FreeEntries != NULL) {
+    //
+    // Lower the TPL level to free the unused ring buffer
+    //
+    gBS->RestoreTPL (OriginalTpl);
+    FreePool (FreeEntries);
+    gBS->RaiseTPL (TPL_HIGH_LEVEL);
+  }
+
+  return EFI_SUCCESS;
+}
 
 /**
   Add a Deferred Procedure Call to the end of the DPC queue.
@@ -75,8 +155,9 @@ DpcQueueDpc (
 {
   EFI_STATUS  ReturnStatus;
   EFI_TPL     OriginalTpl;
+  DPC_QUEUE   *Queue;
   DPC_ENTRY   *DpcEntry;
-  UINTN       Index;
+  UINT64      QueuedTime;
 
   //
   // Make sure DpcTpl is valid
@@ -98,93 +179,51 @@ DpcQueueDpc (
   ReturnStatus = EFI_SUCCESS;
 
   //
-  // Raise the TPL level to TPL_HIGH_LEVEL for DPC list operation and save the
+  // Read the performance counter before raising the TPL, it may be slow.
+  //
+  QueuedTime = 0;
+  if (FeaturePcdGet (PcdDpcLatencyStatistics)) {
+    QueuedTime = GetPerformanceCounter ();
+  }
+
+  //
+  // Raise the TPL level to TPL_HIGH_LEVEL for DPC queue operation and save the
   // current TPL value so it can be restored when this function returns.
   //
   OriginalTpl = gBS->RaiseTPL (TPL_HIGH_LEVEL);
 
   //
-  // Check to see if there are any entries in the DPC free list
+  // Make sure there is room in the DPC queue for the specified DpcTpl
   //
-  if (IsListEmpty (&mDpcEntryFreeList)) {
-    //
-    // If the current TPL is greater than TPL_NOTIFY, then memory allocations
-    // can not be performed, so the free list can not be expanded.  In this case
-    // return EFI_OUT_OF_RESOURCES.
-    //
-    if (OriginalTpl > TPL_NOTIFY) {
-      ReturnStatus = EFI_OUT_OF_RESOURCES;
+  Queue = &mDpcQueue[DpcTpl];
+  while (Queue->Count == Queue->Size) {
+    ReturnStatus = DpcQueueGrow (Queue, OriginalTpl);
+    if (EFI_ERROR (ReturnStatus)) {
       goto Done;
     }
-
-    //
-    // Add 64 DPC entries to the free list
-    //
-    for (Index = 0; Index < 64; Index++) {
-      //
-      // Lower the TPL level to perform a memory allocation
-      //
-      gBS->RestoreTPL (OriginalTpl);
-
-      //
-      // Allocate a new DPC entry
-      //
-      DpcEntry = AllocatePool (sizeof (DPC_ENTRY));
-
-      //
-      // Raise the TPL level back to TPL_HIGH_LEVEL for DPC list operations
-      //
-      gBS->RaiseTPL (TPL_HIGH_LEVEL);
-
-      //
-      // If the allocation of a DPC entry fails, and the free list is empty,
-      // then return EFI_OUT_OF_RESOURCES.
-      //
-      if (DpcEntry == NULL) {
-        if (IsListEmpty (&mDpcEntryFreeList)) {
-          ReturnStatus = EFI_OUT_OF_RESOURCES;
-          goto Done;
-        }
-      }
-
-      //
-      // Add the newly allocated DPC entry to the DPC free list
-      //
-      InsertTailList (&mDpcEntryFreeList, &DpcEntry->ListEntry);
-    }
   }
 
   //
-  // Retrieve the first node from the free list of DPCs
-  //
-  DpcEntry = (DPC_ENTRY *)(GetFirstNode (&mDpcEntryFreeList));
-
-  //
-  // Remove the first node from the free list of DPCs
-  //
-  RemoveEntryList (&DpcEntry->ListEntry);
-
-  //
-  // Fill in the DPC entry with the DpcProcedure and DpcContext
+  // Fill in the DPC entry at the tail of the ring buffer with the DpcProcedure
+  // and DpcContext
   //
+  DpcEntry = &Queue->Entries[(Queue->Head + Queue->Count) & (Queue->Size - 1)];
   DpcEntry->DpcProcedure = DpcProcedure;
   DpcEntry->DpcContext   = DpcContext;
-
-  //
-  // Add the DPC entry to the end of the list for the specified DplTpl.
-  //
-  InsertTailList (&mDpcQueue[DpcTpl], &DpcEntry->ListEntry);
+  DpcEntry->QueuedTime   = QueuedTime;
+  Queue->Count++;
 
   //
   // Increment the measured DPC queue depth across all TPLs
   //
-  mDpcQueueDepth++;
+  mDpcStatistics.QueuedDpcs++;
+  mDpcStatistics.QueueDepth++;
 
   //
   // Measure the maximum DPC queue depth across all TPLs
   //
-  if (mDpcQueueDepth > mMaxDpcQueueDepth) {
-    mMaxDpcQueueDepth = mDpcQueueDepth;
+  if (mDpcStatistics.QueueDepth > mDpcStatistics.MaxQueueDepth) {
+    mDpcStatistics.MaxQueueDepth = mDpcStatistics.QueueDepth;
   }
 
 Done:
@@ -196,6 +235,86 @@ Done:
   return ReturnStatus;
 }
 
+/**
+  Take a batch of DPCs off the head of the DPC queue for a specific EFI_TPL.
+
+  This function must be called at TPL_HIGH_LEVEL, and only once all the DPCs
+  of the previous batch of the same EFI_TPL were invoked.
+
+  @param  Tpl    The EFI_TPL of the DPC queue.
+
+  @return The number of DPCs in the new batch.
+
+**/
+UINTN
+DpcFetchBatch (
+  IN EFI_TPL  Tpl
+  )
+{
+  DPC_QUEUE  *Queue;
+  DPC_BATCH  *Batch;
+  UINTN      Count;
+  UINTN      Index;
+
+  Queue = &mDpcQueue[Tpl];
+  Batch = &mDpcBatch[Tpl];
+
+  Count = MIN (Queue->Count, DPC_DISPATCH_BATCH_SIZE);
+  for (Index = 0; Index < Count; Index++) {
+    CopyMem (&Batch->Entries[Index], &Queue->Entries[Queue->Head], sizeof (DPC_ENTRY));
+    Queue->Head = (Queue->Head + 1) & (Queue->Size - 1);
+  }
+
+  Queue->Count -= Count;
+  Batch->Next   = 0;
+  Batch->Count  = Count;
+
+  //
+  // Decrement the measured DPC Queue Depth across all TPLs.  All the DPCs of a
+  // batch are invoked, by this dispatch or by a nested one.
+  //
+  mDpcStatistics.QueueDepth -= Count;
+  if (Count > 0) {
+    mDpcStatistics.DispatchedDpcs += Count;
+    mDpcStatistics.DispatchedBatches++;
+  }
+
+  return Count;
+}
+
+/**
+  Update the dispatch latency statistics with a DPC about to be invoked.
+
+  @param  DpcEntry   The DPC entry about to be invoked.
+
+**/
+VOID
+DpcMeasureLatency (
+  IN DPC_ENTRY  *DpcEntry
+  )
+{
+  UINT64   Latency;
+  UINT64   Start;
+  UINT64   End;
+  UINT64   Now;
+  EFI_TPL  OriginalTpl;
+
+  Now = GetPerformanceCounter ();
+  GetPerformanceCounterProperties (&Start, &End);
+  if (End >= Start) {
+    Latency = (Now >= DpcEntry->QueuedTime) ? Now - DpcEntry->QueuedTime : (End - DpcEntry->QueuedTime) + (Now - Start);
+  } else {
+    Latency = (Now <= DpcEntry->QueuedTime) ? DpcEntry->QueuedTime - Now : (DpcEntry->QueuedTime - End) + (Start - Now);
+  }
+
+  OriginalTpl = gBS->RaiseTPL (TPL_HIGH_LEVEL);
+  mDpcStatistics.TotalDispatchLatency += Latency;
+  if (Latency > mDpcStatistics.MaxDispatchLatency) {
+    mDpcStatistics.MaxDispatchLatency = Latency;
+  }
+  gBS->RestoreTPL (OriginalTpl);
+}
+
 /**
   Dispatch the queue of DPCs.  ALL DPCs that have been queued with a DpcTpl
   value greater than or equal to the current TPL are invoked in the order that
@@ -217,7 +336,8 @@ DpcDispatchDpc (
   EFI_STATUS  ReturnStatus;
   EFI_TPL     OriginalTpl;
   EFI_TPL     Tpl;
-  DPC_ENTRY   *DpcEntry;
+  DPC_BATCH   *Batch;
+  DPC_ENTRY   DpcEntry;
 
   //
   // Assume that no DPCs will be invoked
@@ -225,63 +345,54 @@ DpcDispatchDpc (
   ReturnStatus = EFI_NOT_FOUND;
 
   //
-  // Raise the TPL level to TPL_HIGH_LEVEL for DPC list operation and save the
+  // Raise the TPL level to TPL_HIGH_LEVEL for DPC queue operation and save the
   // current TPL value so it can be restored when this function returns.
   //
   OriginalTpl = gBS->RaiseTPL (TPL_HIGH_LEVEL);
 
   //
-  // Check to see if there are 1 or more DPCs currently queued
+  // Loop from TPL_HIGH_LEVEL down to the current TPL value
   //
-  if (mDpcQueueDepth > 0) {
+  for (Tpl = TPL_HIGH_LEVEL; Tpl >= OriginalTpl; Tpl--) {
+    Batch = &mDpcBatch[Tpl];
+
     //
-    // Loop from TPL_HIGH_LEVEL down to the current TPL value
+    // Check to see if there are DPCs left in the batch of an outer dispatch
+    // or in the DPC queue
     //
-    for (Tpl = TPL_HIGH_LEVEL; Tpl >= OriginalTpl; Tpl--) {
+    while (Batch->Next < Batch->Count || DpcFetchBatch (Tpl) > 0) {
       //
-      // Check to see if the DPC queue is empty
+      // Lower the TPL to TPL value of the current DPC queue
       //
-      while (!IsListEmpty (&mDpcQueue[Tpl])) {
-        //
-        // Retrieve the first DPC entry from the DPC queue specified by Tpl
-        //
-        DpcEntry = (DPC_ENTRY *)(GetFirstNode (&mDpcQueue[Tpl]));
+      gBS->RestoreTPL (Tpl);
 
-        //
-        // Remove the first DPC entry from the DPC queue specified by Tpl
-        //
-        RemoveEntryList (&DpcEntry->ListEntry);
-
-        //
-        // Decrement the measured DPC Queue Depth across all TPLs
-        //
-        mDpcQueueDepth--;
+      //
+      // Invoke all the DPCs of the batch.  A DPC may dispatch DPCs itself, in
+      // which case the nested dispatch continues with the same batch.
+      //
+      while (Batch->Next < Batch->Count) {
+        CopyMem (&DpcEntry, &Batch->Entries[Batch->Next], sizeof (DPC_ENTRY));
+        Batch->Next++;
 
-        //
-        // Lower the TPL to TPL value of the current DPC queue
-        //
-        gBS->RestoreTPL (Tpl);
+        if (FeaturePcdGet (PcdDpcLatencyStatistics)) {
+          DpcMeasureLatency (&DpcEntry);
+        }
 
         //
         // Invoke the DPC passing in its context
         //
-        (DpcEntry->DpcProcedure) (DpcEntry->DpcContext);
+        (DpcEntry.DpcProcedure) (DpcEntry.DpcContext);
 
         //
         // At least one DPC has been invoked, so set the return status to EFI_SUCCESS
         //
         ReturnStatus = EFI_SUCCESS;
-
-        //
-        // Raise the TPL level back to TPL_HIGH_LEVEL for DPC list operations
-        //
-        gBS->RaiseTPL (TPL_HIGH_LEVEL);
-
-        //
-        // Add the invoked DPC entry to the DPC free list
-        //
-        InsertTailList (&mDpcEntryFreeList, &DpcEntry->ListEntry);
       }
+
+      //
+      // Raise the TPL level back to TPL_HIGH_LEVEL for DPC queue operations
+      //
+      gBS->RaiseTPL (TPL_HIGH_LEVEL);
     }
   }
 
@@ -293,6 +404,39 @@ DpcDispatchDpc (
   return ReturnStatus;
 }
 
+/**
+  Print the DPC statistics when ExitBootServices() is called.
+
+  @param  Event     The event whose notification function is being invoked.
+  @param  Context   The pointer to the notification function's context.
+
+**/
+VOID
+EFIAPI
+DpcPrintStatistics (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  )
+{
+  DEBUG ((
+    DEBUG_INFO,
+    "DPC: %Lu queued, %Lu dispatched in %Lu batches, max queue depth %Lu\n",
+    mDpcStatistics.QueuedDpcs,
+    mDpcStatistics.DispatchedDpcs,
+    mDpcStatistics.DispatchedBatches,
+    (UINT64) mDpcStatistics.MaxQueueDepth
+    ));
+
+  if (FeaturePcdGet (PcdDpcLatencyStatistics) && (mDpcStatistics.DispatchedDpcs != 0)) {
+    DEBUG ((
+      DEBUG_INFO,
+      "DPC: dispatch latency average %Lu ns, max %Lu ns\n",
+      GetTimeInNanoSecond (DivU64x64Remainder (mDpcStatistics.TotalDispatchLatency, mDpcStatistics.DispatchedDpcs, NULL)),
+      GetTimeInNanoSecond (mDpcStatistics.MaxDispatchLatency)
+      ));
+  }
+}
+
 /**
   The entry point for DPC driver which installs the EFI_DPC_PROTOCOL onto a new handle.
 
@@ -312,20 +456,13 @@ DpcDriverEntryPoint (
   )
 {
   EFI_STATUS  Status;
-  UINTN       Index;
+  EFI_EVENT   Event;
 
   //
   // ASSERT() if the EFI_DPC_PROTOCOL is already present in the handle database
   //
   ASSERT_PROTOCOL_ALREADY_INSTALLED (NULL, &gEfiDpcProtocolGuid);
 
-  //
-  // Initialize the DPC queue for all possible TPL values
-  //
-  for (Index = 0; Index <= TPL_HIGH_LEVEL; Index++) {
-    InitializeListHead (&mDpcQueue[Index]);
-  }
-
   //
   // Install the EFI_DPC_PROTOCOL instance onto a new handle
   //
@@ -337,5 +474,16 @@ DpcDriverEntryPoint (
                   );
   ASSERT_EFI_ERROR (Status);
 
+  DEBUG_CODE_BEGIN ();
+    gBS->CreateEventEx (
+           EVT_NOTIFY_SIGNAL,
+           TPL_CALLBACK,
+           DpcPrintStatistics,
+           NULL,
+           &gEfiEventExitBootServicesGuid,
+           &Event
+           );
+  DEBUG_CODE_END ();
+
   return Status;
 }
@@ -21,18 +21,71 @@ Abstract:
 #include <Library/UefiDriverEntryPoint.h>
 #include <Library/UefiBootServicesTableLib.h>
 #include <Library/MemoryAllocationLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/TimerLib.h>
+#include <Library/PcdLib.h>
 #include <Protocol/Dpc.h>
+#include <Guid/EventGroup.h>
 
 //
-// Internal data structure for managing DPCs.  A DPC entry is either on the free
-// list or on a DPC queue at a specific EFI_TPL.
+// The number of DPC entries a DPC queue grows by when it is full for the first time.
+// The queue then doubles its size each time it is full.
+//
+#define DPC_QUEUE_INITIAL_SIZE    64
+
+//
+// The maximum number of DPCs taken off a DPC queue at once and invoked without
+// switching the TPL in between.
+//
+#define DPC_DISPATCH_BATCH_SIZE   16
+
+//
+// Internal data structure for managing DPCs.  A DPC entry is stored by value in the
+// ring buffer of the DPC queue at a specific EFI_TPL, or in the dispatch batch of
+// that EFI_TPL once it is taken off the queue to be invoked.
 //
 typedef struct {
-  LIST_ENTRY             ListEntry;
   EFI_DPC_PROCEDURE  DpcProcedure;
   VOID               *DpcContext;
+  UINT64             QueuedTime;
 } DPC_ENTRY;
 
+//
+// A DPC queue is a ring buffer of DPC entries.  Its size is always a power of 2.
+//
+typedef struct {
+  DPC_ENTRY          *Entries;
+  UINTN              Size;
+  UINTN              Head;
+  UINTN              Count;
+} DPC_QUEUE;
+
+//
+// The DPCs taken off a DPC queue and not invoked yet.  They precede all the DPCs
+// still in the queue, so nested dispatches invoke them first to keep the DPCs in
+// the order that they were queued.
+//
+typedef struct {
+  DPC_ENTRY          Entries[DPC_DISPATCH_BATCH_SIZE];
+  UINTN              Next;
+  UINTN              Count;
+} DPC_BATCH;
+
+//
+// Counters to measure the DPC queues, printed when ExitBootServices() is called in
+// DEBUG builds.  Latency values are in the units of the performance counter, and
+// are only collected if PcdDpcLatencyStatistics is TRUE.
+//
+typedef struct {
+  UINT64             QueuedDpcs;
+  UINT64             DispatchedDpcs;
+  UINT64             DispatchedBatches;
+  UINTN              QueueDepth;
+  UINTN              MaxQueueDepth;
+  UINT64             TotalDispatchLatency;
+  UINT64             MaxDispatchLatency;
+} DPC_STATISTICS;
+
 /**
   Add a Deferred Procedure Call to the end of the DPC queue.
 
@@ -47,6 +47,7 @@
 #include <Protocol/Ip6Config.h>
 #include <Protocol/Tls.h>
 #include <Protocol/TlsConfig.h>
+#include <Protocol/EdkiiTlsSessionData.h>
 
 #include <Guid/ImageAuthentication.h>
 //
@@ -439,7 +439,8 @@ EfiHttpRequest (
       //
       ReConfigure = FALSE;
     } else {
-      if ((HttpInstance->RemotePort == RemotePort) &&
+      if (!HttpInstance->ConnectionClose &&
+          (HttpInstance->RemotePort == RemotePort) &&
           (AsciiStrCmp (HttpInstance->RemoteHost, HostName) == 0) &&
           (!HttpInstance->UseHttps || (HttpInstance->UseHttps &&
                                        !TlsConfigure &&
@@ -493,6 +494,7 @@ EfiHttpRequest (
       } else {
         //
         // Need close existing TCP instance and create a new TCP instance for data transmit.
+        // This is also the case when the server asked to close the previous connection.
         //
         if (HttpInstance->RemoteHost != NULL) {
           FreePool (HttpInstance->RemoteHost);
@@ -556,7 +558,10 @@ EfiHttpRequest (
 
     if (HttpInstance->UseHttps && !TlsConfigure) {
       Status = TlsCloseSession (HttpInstance);
-      if (EFI_ERROR (Status)) {
+      if (EFI_ERROR (Status) && !HttpInstance->ConnectionClose) {
+        //
+        // The close notification can't be sent if the server already closed the connection.
+        //
         goto Error1;
       }
 
@@ -567,6 +572,13 @@ EfiHttpRequest (
     EfiHttpCancel (This, NULL);
   }
 
+  if (Configure) {
+    //
+    // A new connection will be created, it can be reused by the following requests.
+    //
+    HttpInstance->ConnectionClose = FALSE;
+  }
+
   //
   // Wrap the HTTP token in HTTP_TOKEN_WRAP
   //
@@ -983,6 +995,7 @@ HttpResponseWorker (
   HTTP_TOKEN_WRAP               *ValueInItem;
   UINTN                         HdrLen;
   NET_FRAGMENT                  Fragment;
+  EFI_HTTP_HEADER               *Header;
 
   if (Wrap == NULL || Wrap->HttpInstance == NULL) {
     return EFI_INVALID_PARAMETER;
@@ -1185,6 +1198,14 @@ HttpResponseWorker (
       FreePool (HttpHeaders);
       HttpHeaders = NULL;
 
+      //
+      // Check whether the server will close the connection after this response.
+      // If so, the next request must create a new connection instead of reusing it.
+      //
+      Header = HttpFindHeader (HttpMsg->HeaderCount, HttpMsg->Headers, HTTP_HEADER_CONNECTION);
+      if ((Header != NULL) && (AsciiStriCmp (Header->FieldValue, HTTP_CONNECTION_CLOSE) == 0)) {
+        HttpInstance->ConnectionClose = TRUE;
+      }
 
       //
       // Init message-body parser by header information.
@@ -121,6 +121,11 @@ typedef struct _HTTP_PROTOCOL {
   CHAR8                         *RemoteHost;
   UINT16                        RemotePort;
   EFI_IPv4_ADDRESS              RemoteAddr;
+  //
+  // Set when the remote peer asks to close the connection after the
+  // current response, so the next request reconnects instead of reusing it.
+  //
+  BOOLEAN                       ConnectionClose;
 
   EFI_HANDLE                    Tcp6ChildHandle;
   EFI_TCP6_PROTOCOL             *Tcp6;
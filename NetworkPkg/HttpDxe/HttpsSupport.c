@@ -603,6 +603,56 @@ ON_EXIT:
   return Status;
 }
 
+/**
+  Configure the server of the TLS session: the host name to be verified and,
+  with TlsDxe, the port which identifies the cached sessions that can be resumed.
+
+  The server is configured before each connection, as the HTTP instance may
+  connect to another host or port with the same TLS child.
+
+  @param[in, out]  HttpInstance       The HTTP instance private data.
+
+  @retval EFI_SUCCESS            The server of the TLS session is configured.
+  @retval Others                 Other error as indicated.
+
+**/
+EFI_STATUS
+TlsConfigureServer (
+  IN OUT HTTP_PROTOCOL      *HttpInstance
+  )
+{
+  EFI_STATUS                 Status;
+
+  HttpInstance->TlsConfigData.VerifyHost.Flags    = EFI_TLS_VERIFY_FLAG_NO_WILDCARDS;
+  HttpInstance->TlsConfigData.VerifyHost.HostName = HttpInstance->RemoteHost;
+
+  Status = HttpInstance->Tls->SetSessionData (
+                                HttpInstance->Tls,
+                                EfiTlsVerifyHost,
+                                &HttpInstance->TlsConfigData.VerifyHost,
+                                sizeof (EFI_TLS_VERIFY_HOST)
+                                );
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  //
+  // The TLS driver resumes the session cached for the same host name and port,
+  // if any. This is an EDK II extension, other TLS drivers may not support it.
+  //
+  Status = HttpInstance->Tls->SetSessionData (
+                                HttpInstance->Tls,
+                                EDKII_TLS_SESSION_DATA_SERVER_PORT,
+                                &HttpInstance->RemotePort,
+                                sizeof (UINT16)
+                                );
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_INFO, "TlsConfigureServer: TLS session resumption by port not supported - %r\n", Status));
+  }
+
+  return EFI_SUCCESS;
+}
+
 /**
   Configure TLS session data.
 
@@ -625,16 +675,15 @@ TlsConfigureSession (
   //
   HttpInstance->TlsConfigData.ConnectionEnd       = EfiTlsClient;
   HttpInstance->TlsConfigData.VerifyMethod        = EFI_TLS_VERIFY_PEER;
-  HttpInstance->TlsConfigData.VerifyHost.Flags    = EFI_TLS_VERIFY_FLAG_NO_WILDCARDS;
-  HttpInstance->TlsConfigData.VerifyHost.HostName = HttpInstance->RemoteHost;
   HttpInstance->TlsConfigData.SessionState        = EfiTlsSessionNotStarted;
 
   //
   // EfiTlsConnectionEnd,
   // EfiTlsVerifyMethod,
-  // EfiTlsVerifyHost,
   // EfiTlsSessionState
   //
+  // EfiTlsVerifyHost is set by TlsConnectSession() for each connection.
+  //
   Status = HttpInstance->Tls->SetSessionData (
                                 HttpInstance->Tls,
                                 EfiTlsConnectionEnd,
@@ -655,16 +704,6 @@ TlsConfigureSession (
     return Status;
   }
 
-  Status = HttpInstance->Tls->SetSessionData (
-                                HttpInstance->Tls,
-                                EfiTlsVerifyHost,
-                                &HttpInstance->TlsConfigData.VerifyHost,
-                                sizeof (EFI_TLS_VERIFY_HOST)
-                                );
-  if (EFI_ERROR (Status)) {
-    return Status;
-  }
-
   Status = HttpInstance->Tls->SetSessionData (
                                 HttpInstance->Tls,
                                 EfiTlsSessionState,
@@ -1157,6 +1196,14 @@ TlsConnectSession (
     return Status;
   }
 
+  //
+  // The host or the port may differ from the previous connection of the TLS child.
+  //
+  Status = TlsConfigureServer (HttpInstance);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
   //
   // Create ClientHello
   //
@@ -0,0 +1,36 @@
+/** @file
+  EDK II extension of the session data types of the EFI TLS Protocol.
+
+  EFI_TLS_PROTOCOL.SetSessionData() of TlsDxe accepts the data types below in
+  addition to the ones of the UEFI Specification. Other implementations of
+  the EFI TLS Protocol return EFI_UNSUPPORTED for them, so a consumer must
+  not fail the connection if setting them fails.
+
+  Copyright (c) 2026, agent. All rights reserved.<BR>
+
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef __EDKII_TLS_SESSION_DATA_H__
+#define __EDKII_TLS_SESSION_DATA_H__
+
+#include <Protocol/Tls.h>
+
+///
+/// Range of the EDK II session data types. The UEFI Specification numbers its
+/// data types from 0, the range is far above them as the OEM range of the
+/// memory types, so that the data types added by new revisions of the UEFI
+/// Specification never collide with it.
+///
+#define EDKII_TLS_SESSION_DATA_TYPE_VENDOR_START  0x70000000
+#define EDKII_TLS_SESSION_DATA_TYPE_VENDOR_END    0x7FFFFFFF
+
+///
+/// Port of the server to be connected, as a UINT16. Together with the host
+/// name set by EfiTlsVerifyHost, it identifies the server whose cached
+/// sessions can be resumed by the TLS session.
+///
+#define EDKII_TLS_SESSION_DATA_SERVER_PORT  ((EFI_TLS_SESSION_DATA_TYPE) (EDKII_TLS_SESSION_DATA_TYPE_VENDOR_START + 0))
+
+#endif
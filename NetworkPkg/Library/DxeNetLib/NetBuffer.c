@@ -1642,6 +1642,11 @@ NetbufQueFlush (
 /**
   Compute the checksum for a bulk of data.
 
+  The data is summed 32 bits at a time into a 64-bit accumulator, which is
+  folded to 16 bits at the end. The one's complement sum is independent of
+  the width of the words it is computed on, as long as the words are summed
+  with the byte order of the host.
+
   @param[in]   Bulk                  Pointer to the data.
   @param[in]   Len                   Length of the data, in bytes.
 
@@ -1655,10 +1660,24 @@ NetblockChecksum (
   IN UINT32                 Len
   )
 {
-  register UINT32           Sum;
+  register UINT64           Sum;
+  BOOLEAN                   Odd;
+  UINT32                    *Bulk32;
 
   Sum = 0;
 
+  //
+  // If the data starts at an odd address, sum the first byte as the high
+  // byte of a 16-bit word, so the rest of the data is summed from an even
+  // address. The sum is then byte swapped once it is folded.
+  //
+  Odd = (BOOLEAN) ((((UINTN) Bulk) & 0x01) != 0);
+  if (Odd && (Len > 0)) {
+    Sum  = (UINT64) (*Bulk) << 8;
+    Bulk++;
+    Len--;
+  }
+
   //
   // Add left-over byte, if any
   //
@@ -1666,18 +1685,47 @@ NetblockChecksum (
     Sum += *(Bulk + Len - 1);
   }
 
-  while (Len > 1) {
-    Sum += *(UINT16 *) Bulk;
+  //
+  // Sum 16-bit words until the data is aligned on a 32-bit boundary.
+  //
+  if ((((UINTN) Bulk) & 0x02) != 0 && Len > 1) {
+    Sum  += *(UINT16 *) Bulk;
     Bulk += 2;
-    Len -= 2;
+    Len  -= 2;
+  }
+
+  //
+  // Sum 32-bit words, 16 bytes at a time.
+  //
+  Bulk32 = (UINT32 *) Bulk;
+  while (Len >= 16) {
+    Sum += (UINT64) Bulk32[0] + Bulk32[1] + Bulk32[2] + Bulk32[3];
+    Bulk32 += 4;
+    Len    -= 16;
+  }
+
+  while (Len >= 4) {
+    Sum += *Bulk32;
+    Bulk32++;
+    Len -= 4;
+  }
+
+  Bulk = (UINT8 *) Bulk32;
+  if (Len > 1) {
+    Sum += *(UINT16 *) Bulk;
   }
 
   //
-  // Fold 32-bit sum to 16 bits
+  // Fold 64-bit sum to 16 bits
   //
+  Sum = (Sum & 0xffffffff) + (Sum >> 32);
+  Sum = (Sum & 0xffffffff) + (Sum >> 32);
   while ((Sum >> 16) != 0) {
     Sum = (Sum & 0xffff) + (Sum >> 16);
+  }
 
+  if (Odd) {
+    Sum = SwapBytes16 ((UINT16) Sum);
   }
 
   return (UINT16) Sum;
@@ -77,6 +77,8 @@ Mtftp4CleanOperation (
   Instance->WindowSize    = 1;
   Instance->TotalBlock    = 0;
   Instance->AckedBlock    = 0;
+  Instance->LossAcked     = FALSE;
+  Instance->LossDropped   = 0;
   Instance->LastBlock     = 0;
   Instance->ServerIp      = 0;
   Instance->ListeningPort = 0;
@@ -129,6 +129,16 @@ struct _MTFTP4_PROTOCOL {
   //
   UINT64                        AckedBlock;
 
+  //
+  // Set once the loss of the expected block has been reported to the
+  // server, so the rest of the in-flight window doesn't trigger an ACK
+  // for every out-of-order block. Cleared when the next block is saved or
+  // the last packet is retransmitted on timeout. LossDropped counts the
+  // out-of-order blocks dropped since the loss was reported.
+  //
+  BOOLEAN                       LossAcked;
+  UINT16                        LossDropped;
+
   //
   // The server's communication end point: IP and two ports. one for
   // initial request, one for its selected port.
@@ -270,11 +270,30 @@ Mtftp4RrqHandleData (
   // the ACK for the block we received, then restart receiving the
   // expected one. If we are passive (Slave), save the block.
   //
+  // With a window larger than one block, a single lost block is followed
+  // by the rest of the window. Only the first of them is acknowledged, the
+  // server restarts the window from the expected block on receiving it.
+  // Acknowledging each of them would make the server restart the window
+  // over and over again. Once a whole window of out-of-order blocks has
+  // been dropped, the first block of the restarted window was lost too, so
+  // the loss is acknowledged again. If that ACK is lost, the retransmit
+  // timer resends it.
+  //
   if (Instance->Master && (Expected != BlockNum)) {
+    if (Instance->LossAcked && (++Instance->LossDropped < Instance->WindowSize)) {
+      return EFI_SUCCESS;
+    }
+
     //
     // If Expected is 0, (UINT16) (Expected - 1) is also the expected Ack number (65535).
     //
-    return Mtftp4RrqSendAck (Instance,  (UINT16) (Expected - 1));
+    Status = Mtftp4RrqSendAck (Instance,  (UINT16) (Expected - 1));
+    if (!EFI_ERROR (Status) && (Instance->WindowSize > 1)) {
+      Instance->LossAcked   = TRUE;
+      Instance->LossDropped = 0;
+    }
+
+    return Status;
   }
 
   Status = Mtftp4RrqSaveBlock (Instance, Packet, Len);
@@ -283,6 +302,8 @@ Mtftp4RrqHandleData (
     return Status;
   }
 
+  Instance->LossAcked = FALSE;
+
   //
   // Record the total received and saved block number.
   //
@@ -653,6 +653,11 @@ Mtftp4OnTimerTick (
     // otherwise exit the transfer.
     //
     if (++Instance->CurRetry < Instance->MaxRetry) {
+      //
+      // The retransmitted ACK reports the loss again, so the first
+      // out-of-order block of the next window is acknowledged again too.
+      //
+      Instance->LossAcked = FALSE;
       Mtftp4Retransmit (Instance);
       Mtftp4SetTimeout (Instance);
     } else {
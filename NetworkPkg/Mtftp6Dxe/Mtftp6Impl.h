@@ -86,6 +86,16 @@ struct _MTFTP6_INSTANCE {
   //
   UINT64                        AckedBlock;
 
+  //
+  // Set once the loss of the expected block has been reported to the
+  // server, so the rest of the in-flight window doesn't trigger an ACK
+  // for every out-of-order block. Cleared when the next block is saved or
+  // the last packet is retransmitted on timeout. LossDropped counts the
+  // out-of-order blocks dropped since the loss was reported.
+  //
+  BOOLEAN                       LossAcked;
+  UINT16                        LossDropped;
+
   EFI_IPv6_ADDRESS              ServerIp;
   UINT16                        ServerCmdPort;
   UINT16                        ServerDataPort;
@@ -237,7 +237,15 @@ Mtftp6RrqHandleData (
   // the ACK for the block we received, then restart receiving the
   // expected one. If we are passive (Slave), save the block.
   //
+  // With a window larger than one block, only the first out-of-order block
+  // after a loss is acknowledged, and again after a whole window of
+  // out-of-order blocks, see Mtftp4RrqHandleData.
+  //
   if (Instance->IsMaster && (Expected != BlockNum)) {
+    if (Instance->LossAcked && (++Instance->LossDropped < Instance->WindowSize)) {
+      return EFI_SUCCESS;
+    }
+
     //
     // Free the received packet before send new packet in ReceiveNotify,
     // since the udpio might need to be reconfigured.
@@ -248,7 +256,13 @@ Mtftp6RrqHandleData (
     //
     // If Expected is 0, (UINT16) (Expected - 1) is also the expected Ack number (65535).
     //
-    return Mtftp6RrqSendAck (Instance,  (UINT16) (Expected - 1));
+    Status = Mtftp6RrqSendAck (Instance,  (UINT16) (Expected - 1));
+    if (!EFI_ERROR (Status) && (Instance->WindowSize > 1)) {
+      Instance->LossAcked   = TRUE;
+      Instance->LossDropped = 0;
+    }
+
+    return Status;
   }
 
   Status = Mtftp6RrqSaveBlock (Instance, Packet, Len, UdpPacket);
@@ -257,6 +271,8 @@ Mtftp6RrqHandleData (
     return Status;
   }
 
+  Instance->LossAcked = FALSE;
+
   //
   // Record the total received and saved block number.
   //
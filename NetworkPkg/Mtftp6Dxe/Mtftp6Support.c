@@ -977,6 +977,8 @@ Mtftp6OperationClean (
   Instance->WindowSize     = 1;
   Instance->TotalBlock     = 0;
   Instance->AckedBlock     = 0;
+  Instance->LossAcked      = FALSE;
+  Instance->LossDropped    = 0;
   Instance->LastBlk        = 0;
   Instance->PacketToLive   = 0;
   Instance->MaxRetry       = 0;
@@ -1231,6 +1233,11 @@ Mtftp6OnTimerTick (
     // otherwise exit the transfer.
     //
     if (Instance->CurRetry < Instance->MaxRetry) {
+      //
+      // The retransmitted ACK reports the loss again, so the first
+      // out-of-order block of the next window is acknowledged again too.
+      //
+      Instance->LossAcked = FALSE;
       Mtftp6TransmitPacket (Instance, Instance->LastPacket);
     } else {
       Mtftp6OperationClean (Instance, EFI_TIMEOUT);
@@ -28,6 +28,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 //
 #include <Protocol/Tls.h>
 #include <Protocol/TlsConfig.h>
+#include <Protocol/EdkiiTlsSessionData.h>
 
 #include <IndustryStandard/Tls1.h>
 
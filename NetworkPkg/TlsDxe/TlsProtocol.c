@@ -80,6 +80,20 @@ TlsSetSessionData (
     goto ON_EXIT;
   }
 
+  //
+  // EDK II extension: the port of the server, used with the host name to find
+  // the cached sessions that can be resumed.
+  //
+  if (DataType == EDKII_TLS_SESSION_DATA_SERVER_PORT) {
+    if (DataSize != sizeof (UINT16)) {
+      Status = EFI_INVALID_PARAMETER;
+      goto ON_EXIT;
+    }
+
+    Status = TlsSetServerPort (Instance->TlsConn, ReadUnaligned16 ((UINT16 *) Data));
+    goto ON_EXIT;
+  }
+
   switch (DataType) {
   //
   // Session Configuration
@@ -10,6 +10,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #define _TPM2_COMMAND_LIB_H_
 
 #include <IndustryStandard/Tpm20.h>
+#include <Library/Tpm2DeviceLib.h>
 
 /**
   This command starts a hash or an Event sequence.
@@ -485,6 +486,67 @@ Tpm2PcrExtend (
   IN      TPML_DIGEST_VALUES        *Digests
   );
 
+/**
+  This command is used to cause an update to the indicated PCR, without waiting
+  for the TPM to complete it.
+
+  The TPM extends the PCR while the caller goes on with other work. The result
+  must be collected with Tpm2PcrExtendComplete(). If another TPM command is
+  sent in between, it waits for the PCR extend first and the result is kept
+  for Tpm2PcrExtendComplete().
+
+  This is only supported once the asynchronous TPM2 device services have been
+  registered with Tpm2RegisterAsyncCommandServices().
+
+  @param[in] PcrHandle   Handle of the PCR
+  @param[in] Digests     List of tagged digest values to be extended
+
+  @retval EFI_SUCCESS      The command was sent to the TPM.
+  @retval EFI_UNSUPPORTED  The TPM2 device only supports synchronous commands.
+                           Tpm2PcrExtend() must be used instead.
+  @retval EFI_ALREADY_STARTED The result of an earlier PCR extend has not been
+                           collected yet.
+  @retval EFI_DEVICE_ERROR Unexpected device behavior.
+**/
+EFI_STATUS
+EFIAPI
+Tpm2PcrExtendAsync (
+  IN      TPMI_DH_PCR               PcrHandle,
+  IN      TPML_DIGEST_VALUES        *Digests
+  );
+
+/**
+  Wait for the PCR extend sent by Tpm2PcrExtendAsync() to complete.
+
+  @retval EFI_SUCCESS      The PCR was extended.
+  @retval EFI_NOT_FOUND    No PCR extend is pending.
+  @retval EFI_DEVICE_ERROR Unexpected device behavior.
+**/
+EFI_STATUS
+EFIAPI
+Tpm2PcrExtendComplete (
+  VOID
+  );
+
+/**
+  Register the TPM2 device services used by Tpm2PcrExtendAsync() and
+  Tpm2PcrExtendComplete().
+
+  Tpm2CommandAsyncLib registers them when it is linked into a DXE driver.
+
+  @param[in] SubmitCommandAsync  Service sending a command without waiting for it.
+  @param[in] CompleteCommand     Service waiting for the command and returning its response.
+
+  @retval EFI_SUCCESS            The services are registered.
+  @retval EFI_INVALID_PARAMETER  SubmitCommandAsync or CompleteCommand is NULL.
+**/
+EFI_STATUS
+EFIAPI
+Tpm2RegisterAsyncCommandServices (
+  IN TPM2_SUBMIT_COMMAND_ASYNC  SubmitCommandAsync,
+  IN TPM2_COMPLETE_COMMAND      CompleteCommand
+  );
+
 /**
   This command is used to cause an update to the indicated PCR.
   The data in eventData is hashed using the hash algorithm associated with each bank in which the
@@ -0,0 +1,66 @@
+/** @file
+  This library sends commands to the TPM2 without waiting for them to complete.
+
+  It is only needed by the modules that link Tpm2CommandAsyncLib, which passes
+  these services to Tpm2CommandLib. The instance must drive the same TPM2 device
+  as the Tpm2DeviceLib instance of the module.
+
+Copyright (c) 2026, agent. All rights reserved.<BR>
+SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef _TPM2_DEVICE_ASYNC_LIB_H_
+#define _TPM2_DEVICE_ASYNC_LIB_H_
+
+#include <Uefi.h>
+
+/**
+  This service sends a command to the TPM2 without waiting for its response.
+
+  The TPM2 executes the command while the caller goes on with other work. The
+  response must be collected with Tpm2CompleteCommand(). If another command is
+  submitted first, the pending response is read and kept for
+  Tpm2CompleteCommand(). Only one response is kept: a command that would need to
+  keep a second one is rejected until Tpm2CompleteCommand() is called.
+
+  @param[in]      InputParameterBlockSize  Size of the TPM2 input parameter block.
+  @param[in]      InputParameterBlock      Pointer to the TPM2 input parameter block.
+
+  @retval EFI_SUCCESS            The command byte stream was successfully sent to the device.
+  @retval EFI_DEVICE_ERROR       The command was not successfully sent to the device.
+  @retval EFI_ALREADY_STARTED    The response of an earlier command has not been
+                                 collected with Tpm2CompleteCommand() yet.
+  @retval EFI_UNSUPPORTED        The TPM2 device does not support asynchronous commands.
+                                 The caller should use Tpm2SubmitCommand() instead.
+**/
+EFI_STATUS
+EFIAPI
+Tpm2SubmitCommandAsync (
+  IN UINT32            InputParameterBlockSize,
+  IN UINT8             *InputParameterBlock
+  );
+
+/**
+  This service waits for the command sent by Tpm2SubmitCommandAsync() to
+  complete and returns its response.
+
+  If another command was submitted in between, the response it collected is
+  returned.
+
+  @param[in,out]  OutputParameterBlockSize Size of the TPM2 output parameter block.
+  @param[in]      OutputParameterBlock     Pointer to the TPM2 output parameter block.
+
+  @retval EFI_SUCCESS            A response was successfully received.
+  @retval EFI_NOT_FOUND          No command is pending.
+  @retval EFI_DEVICE_ERROR       A response was not successfully received from the device.
+  @retval EFI_BUFFER_TOO_SMALL   The output parameter block is too small.
+**/
+EFI_STATUS
+EFIAPI
+Tpm2CompleteCommand (
+  IN OUT UINT32        *OutputParameterBlockSize,
+  IN UINT8             *OutputParameterBlock
+  );
+
+#endif
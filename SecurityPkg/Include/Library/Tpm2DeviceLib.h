@@ -89,10 +89,49 @@ EFI_STATUS
   VOID
   );
 
+/**
+  This service sends a command to the TPM2 without waiting for its response.
+
+  @param[in]      InputParameterBlockSize  Size of the TPM2 input parameter block.
+  @param[in]      InputParameterBlock      Pointer to the TPM2 input parameter block.
+
+  @retval EFI_SUCCESS            The command byte stream was successfully sent to the device.
+  @retval EFI_DEVICE_ERROR       The command was not successfully sent to the device.
+**/
+typedef
+EFI_STATUS
+(EFIAPI *TPM2_SUBMIT_COMMAND_ASYNC) (
+  IN UINT32            InputParameterBlockSize,
+  IN UINT8             *InputParameterBlock
+  );
+
+/**
+  This service waits for the pending TPM2 command to complete and returns its response.
+
+  @param[in,out]  OutputParameterBlockSize Size of the TPM2 output parameter block.
+  @param[in]      OutputParameterBlock     Pointer to the TPM2 output parameter block.
+
+  @retval EFI_SUCCESS            A response was successfully received.
+  @retval EFI_NOT_FOUND          No command is pending.
+  @retval EFI_DEVICE_ERROR       A response was not successfully received from the device.
+  @retval EFI_BUFFER_TOO_SMALL   The output parameter block is too small.
+**/
+typedef
+EFI_STATUS
+(EFIAPI *TPM2_COMPLETE_COMMAND) (
+  IN OUT UINT32        *OutputParameterBlockSize,
+  IN UINT8             *OutputParameterBlock
+  );
+
 typedef struct {
   EFI_GUID                           ProviderGuid;
   TPM2_SUBMIT_COMMAND                Tpm2SubmitCommand;
   TPM2_REQUEST_USE_TPM               Tpm2RequestUseTpm;
+  //
+  // Optional, NULL if the device only supports synchronous commands.
+  //
+  TPM2_SUBMIT_COMMAND_ASYNC          Tpm2SubmitCommandAsync;
+  TPM2_COMPLETE_COMMAND              Tpm2CompleteCommand;
 } TPM2_DEVICE_INTERFACE;
 
 /**
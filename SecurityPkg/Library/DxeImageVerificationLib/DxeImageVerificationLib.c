@@ -825,8 +825,7 @@ AddImageExeInfo (
 
   @param[in]  Certificate       Pointer to X.509 Certificate that is searched for.
   @param[in]  CertSize          Size of X.509 Certificate.
-  @param[in]  SignatureList     Pointer to the Signature List in forbidden database.
-  @param[in]  SignatureListSize Size of Signature List.
+  @param[in]  Dbx               Pointer to the indexed forbidden database.
   @param[out] RevocationTime    Return the time that the certificate was revoked.
   @param[out] IsFound           Search result. Only valid if EFI_SUCCESS returned.
 
@@ -838,34 +837,33 @@ EFI_STATUS
 IsCertHashFoundInDbx (
   IN  UINT8               *Certificate,
   IN  UINTN               CertSize,
-  IN  EFI_SIGNATURE_LIST  *SignatureList,
-  IN  UINTN               SignatureListSize,
+  IN  SIGNATURE_DATABASE  *Dbx,
   OUT EFI_TIME            *RevocationTime,
   OUT BOOLEAN             *IsFound
   )
 {
   EFI_STATUS          Status;
-  EFI_SIGNATURE_LIST  *DbxList;
-  UINTN               DbxSize;
   EFI_SIGNATURE_DATA  *CertHash;
-  UINTN               CertHashCount;
   UINTN               Index;
   UINT32              HashAlg;
   VOID                *HashCtx;
   UINT8               CertDigest[MAX_DIGEST_SIZE];
-  UINT8               *DbxCertHash;
-  UINTN               SiglistHeaderSize;
   UINT8               *TBSCert;
   UINTN               TBSCertSize;
+  STATIC struct {
+    EFI_GUID          *SignatureType;
+    UINT32            HashAlg;
+  } DbxCertHashTypes[] = {
+    { &gEfiCertX509Sha256Guid, HASHALG_SHA256 },
+    { &gEfiCertX509Sha384Guid, HASHALG_SHA384 },
+    { &gEfiCertX509Sha512Guid, HASHALG_SHA512 }
+  };
 
   Status   = EFI_ABORTED;
   *IsFound = FALSE;
-  DbxList  = SignatureList;
-  DbxSize  = SignatureListSize;
   HashCtx  = NULL;
-  HashAlg  = HASHALG_MAX;
 
-  if ((RevocationTime == NULL) || (DbxList == NULL)) {
+  if ((RevocationTime == NULL) || (Dbx == NULL)) {
     return EFI_INVALID_PARAMETER;
   }
 
@@ -876,21 +874,14 @@ IsCertHashFoundInDbx (
     return Status;
   }
 
-  while ((DbxSize > 0) && (SignatureListSize >= DbxList->SignatureListSize)) {
+  for (Index = 0; Index < ARRAY_SIZE (DbxCertHashTypes); Index++) {
     //
-    // Determine Hash Algorithm of Certificate in the forbidden database.
+    // Only hash the TBSCertificate with algorithms actually used in the forbidden database.
     //
-    if (CompareGuid (&DbxList->SignatureType, &gEfiCertX509Sha256Guid)) {
-      HashAlg = HASHALG_SHA256;
-    } else if (CompareGuid (&DbxList->SignatureType, &gEfiCertX509Sha384Guid)) {
-      HashAlg = HASHALG_SHA384;
-    } else if (CompareGuid (&DbxList->SignatureType, &gEfiCertX509Sha512Guid)) {
-      HashAlg = HASHALG_SHA512;
-    } else {
-      DbxSize -= DbxList->SignatureListSize;
-      DbxList  = (EFI_SIGNATURE_LIST *) ((UINT8 *) DbxList + DbxList->SignatureListSize);
+    if (!FindSignatureInDatabase (Dbx, DbxCertHashTypes[Index].SignatureType, NULL, 0, 0, NULL, NULL)) {
       continue;
     }
+    HashAlg = DbxCertHashTypes[Index].HashAlg;
 
     //
     // Calculate the hash value of current TBSCertificate for comparision.
@@ -916,32 +907,27 @@ IsCertHashFoundInDbx (
     FreePool (HashCtx);
     HashCtx = NULL;
 
-    SiglistHeaderSize = sizeof (EFI_SIGNATURE_LIST) + DbxList->SignatureHeaderSize;
-    CertHash          = (EFI_SIGNATURE_DATA *) ((UINT8 *) DbxList + SiglistHeaderSize);
-    CertHashCount     = (DbxList->SignatureListSize - SiglistHeaderSize) / DbxList->SignatureSize;
-    for (Index = 0; Index < CertHashCount; Index++) {
+    if (FindSignatureInDatabase (
+          Dbx,
+          DbxCertHashTypes[Index].SignatureType,
+          CertDigest,
+          mHash[HashAlg].DigestLength,
+          0,
+          NULL,
+          &CertHash
+          )) {
       //
-      // Iterate each Signature Data Node within this CertList for verify.
+      // Hash of Certificate is found in forbidden database.
       //
-      DbxCertHash = CertHash->SignatureData;
-      if (CompareMem (DbxCertHash, CertDigest, mHash[HashAlg].DigestLength) == 0) {
-        //
-        // Hash of Certificate is found in forbidden database.
-        //
-        Status   = EFI_SUCCESS;
-        *IsFound = TRUE;
+      Status   = EFI_SUCCESS;
+      *IsFound = TRUE;
 
-        //
-        // Return the revocation time.
-        //
-        CopyMem (RevocationTime, (EFI_TIME *)(DbxCertHash + mHash[HashAlg].DigestLength), sizeof (EFI_TIME));
-        goto Done;
-      }
-      CertHash = (EFI_SIGNATURE_DATA *) ((UINT8 *) CertHash + DbxList->SignatureSize);
+      //
+      // Return the revocation time.
+      //
+      CopyMem (RevocationTime, (EFI_TIME *)(CertHash->SignatureData + mHash[HashAlg].DigestLength), sizeof (EFI_TIME));
+      goto Done;
     }
-
-    DbxSize -= DbxList->SignatureListSize;
-    DbxList  = (EFI_SIGNATURE_LIST *) ((UINT8 *) DbxList + DbxList->SignatureListSize);
   }
 
   Status = EFI_SUCCESS;
@@ -977,21 +963,16 @@ IsSignatureFoundInDatabase (
   )
 {
   EFI_STATUS          Status;
+  SIGNATURE_DATABASE  *Database;
   EFI_SIGNATURE_LIST  *CertList;
   EFI_SIGNATURE_DATA  *Cert;
-  UINTN               DataSize;
-  UINT8               *Data;
-  UINTN               Index;
-  UINTN               CertCount;
 
   //
   // Read signature database variable.
   //
-  *IsFound  = FALSE;
-  Data      = NULL;
-  DataSize  = 0;
-  Status    = gRT->GetVariable (VariableName, &gEfiImageSecurityDatabaseGuid, NULL, &DataSize, NULL);
-  if (Status != EFI_BUFFER_TOO_SMALL) {
+  *IsFound = FALSE;
+  Status   = GetSignatureDatabase (VariableName, &Database);
+  if (EFI_ERROR (Status)) {
     if (Status == EFI_NOT_FOUND) {
       //
       // No database, no need to search.
@@ -1002,56 +983,31 @@ IsSignatureFoundInDatabase (
     return Status;
   }
 
-  Data = (UINT8 *) AllocateZeroPool (DataSize);
-  if (Data == NULL) {
-    return EFI_OUT_OF_RESOURCES;
-  }
-
-  Status = gRT->GetVariable (VariableName, &gEfiImageSecurityDatabaseGuid, NULL, &DataSize, Data);
-  if (EFI_ERROR (Status)) {
-    goto Done;
-  }
   //
-  // Enumerate all signature data in SigDB to check if signature exists for executable.
+  // Look up the signature in the index of the database.
   //
-  CertList = (EFI_SIGNATURE_LIST *) Data;
-  while ((DataSize > 0) && (DataSize >= CertList->SignatureListSize)) {
-    CertCount = (CertList->SignatureListSize - sizeof (EFI_SIGNATURE_LIST) - CertList->SignatureHeaderSize) / CertList->SignatureSize;
-    Cert      = (EFI_SIGNATURE_DATA *) ((UINT8 *) CertList + sizeof (EFI_SIGNATURE_LIST) + CertList->SignatureHeaderSize);
-    if ((CertList->SignatureSize == sizeof(EFI_SIGNATURE_DATA) - 1 + SignatureSize) && (CompareGuid(&CertList->SignatureType, CertType))) {
-      for (Index = 0; Index < CertCount; Index++) {
-        if (CompareMem (Cert->SignatureData, Signature, SignatureSize) == 0) {
-          //
-          // Find the signature in database.
-          //
-          *IsFound = TRUE;
-          //
-          // Entries in UEFI_IMAGE_SECURITY_DATABASE that are used to validate image should be measured
-          //
-          if (StrCmp(VariableName, EFI_IMAGE_SECURITY_DATABASE) == 0) {
-            SecureBootHook (VariableName, &gEfiImageSecurityDatabaseGuid, CertList->SignatureSize, Cert);
-          }
-          break;
-        }
-
-        Cert = (EFI_SIGNATURE_DATA *) ((UINT8 *) Cert + CertList->SignatureSize);
-      }
-
-      if (*IsFound) {
-        break;
-      }
+  if (FindSignatureInDatabase (
+        Database,
+        CertType,
+        Signature,
+        SignatureSize,
+        sizeof (EFI_SIGNATURE_DATA) - 1 + SignatureSize,
+        &CertList,
+        &Cert
+        )) {
+    //
+    // Find the signature in database.
+    //
+    *IsFound = TRUE;
+    //
+    // Entries in UEFI_IMAGE_SECURITY_DATABASE that are used to validate image should be measured
+    //
+    if (StrCmp(VariableName, EFI_IMAGE_SECURITY_DATABASE) == 0) {
+      SecureBootHook (VariableName, &gEfiImageSecurityDatabaseGuid, CertList->SignatureSize, Cert);
     }
-
-    DataSize -= CertList->SignatureListSize;
-    CertList = (EFI_SIGNATURE_LIST *) ((UINT8 *) CertList + CertList->SignatureListSize);
   }
 
-Done:
-  if (Data != NULL) {
-    FreePool (Data);
-  }
-
-  return Status;
+  return EFI_SUCCESS;
 }
 
 /**
@@ -1233,8 +1189,7 @@ IsForbiddenByDbx (
   EFI_STATUS                Status;
   BOOLEAN                   IsForbidden;
   BOOLEAN                   IsFound;
-  UINT8                     *Data;
-  UINTN                     DataSize;
+  SIGNATURE_DATABASE        *Dbx;
   EFI_SIGNATURE_LIST        *CertList;
   UINTN                     CertListSize;
   EFI_SIGNATURE_DATA        *CertData;
@@ -1255,7 +1210,6 @@ IsForbiddenByDbx (
   // Variable Initialization
   //
   IsForbidden       = TRUE;
-  Data              = NULL;
   CertList          = NULL;
   CertData          = NULL;
   RootCert          = NULL;
@@ -1269,10 +1223,8 @@ IsForbiddenByDbx (
   //
   // The image will not be forbidden if dbx can't be got.
   //
-  DataSize = 0;
-  Status   = gRT->GetVariable (EFI_IMAGE_SECURITY_DATABASE1, &gEfiImageSecurityDatabaseGuid, NULL, &DataSize, NULL);
-  ASSERT (EFI_ERROR (Status));
-  if (Status != EFI_BUFFER_TOO_SMALL) {
+  Status = GetSignatureDatabase (EFI_IMAGE_SECURITY_DATABASE1, &Dbx);
+  if (EFI_ERROR (Status)) {
     if (Status == EFI_NOT_FOUND) {
       //
       // Evidently not in dbx if the database doesn't exist.
@@ -1281,22 +1233,13 @@ IsForbiddenByDbx (
     }
     return IsForbidden;
   }
-  Data = (UINT8 *) AllocateZeroPool (DataSize);
-  if (Data == NULL) {
-    return IsForbidden;
-  }
-
-  Status = gRT->GetVariable (EFI_IMAGE_SECURITY_DATABASE1, &gEfiImageSecurityDatabaseGuid, NULL, &DataSize, (VOID *) Data);
-  if (EFI_ERROR (Status)) {
-    goto Done;
-  }
 
   //
   // Verify image signature with RAW X509 certificates in DBX database.
   // If passed, the image will be forbidden.
   //
-  CertList     = (EFI_SIGNATURE_LIST *) Data;
-  CertListSize = DataSize;
+  CertList     = (EFI_SIGNATURE_LIST *) Dbx->Data;
+  CertListSize = Dbx->DataSize;
   while ((CertListSize > 0) && (CertListSize >= CertList->SignatureListSize)) {
     if (CompareGuid (&CertList->SignatureType, &gEfiCertX509Guid)) {
       CertData  = (EFI_SIGNATURE_DATA *) ((UINT8 *) CertList + sizeof (EFI_SIGNATURE_LIST) + CertList->SignatureHeaderSize);
@@ -1368,7 +1311,7 @@ IsForbiddenByDbx (
     //
     CertPtr = CertPtr + sizeof (UINT32) + CertSize;
 
-    Status = IsCertHashFoundInDbx (Cert, CertSize, (EFI_SIGNATURE_LIST *)Data, DataSize, &RevocationTime, &IsFound);
+    Status = IsCertHashFoundInDbx (Cert, CertSize, Dbx, &RevocationTime, &IsFound);
     if (EFI_ERROR (Status)) {
       //
       // Error in searching dbx. Consider it as 'found'. RevocationTime might
@@ -1398,10 +1341,6 @@ IsForbiddenByDbx (
   IsForbidden = FALSE;
 
 Done:
-  if (Data != NULL) {
-    FreePool (Data);
-  }
-
   Pkcs7FreeSigners (CertBuffer);
   Pkcs7FreeSigners (TrustedCert);
 
@@ -1431,20 +1370,18 @@ IsAllowedByDb (
   EFI_SIGNATURE_LIST        *CertList;
   EFI_SIGNATURE_DATA        *CertData;
   UINTN                     DataSize;
-  UINT8                     *Data;
+  SIGNATURE_DATABASE        *Db;
   UINT8                     *RootCert;
   UINTN                     RootCertSize;
   UINTN                     Index;
   UINTN                     CertCount;
-  UINTN                     DbxDataSize;
-  UINT8                     *DbxData;
+  SIGNATURE_DATABASE        *Dbx;
   EFI_TIME                  RevocationTime;
 
-  Data              = NULL;
   CertList          = NULL;
   CertData          = NULL;
   RootCert          = NULL;
-  DbxData           = NULL;
+  Dbx               = NULL;
   RootCertSize      = 0;
   VerifyStatus      = FALSE;
 
@@ -1452,21 +1389,9 @@ IsAllowedByDb (
   // Fetch 'db' content. If 'db' doesn't exist or encounters problem to get the
   // data, return not-allowed-by-db (FALSE).
   //
-  DataSize = 0;
-  Status   = gRT->GetVariable (EFI_IMAGE_SECURITY_DATABASE, &gEfiImageSecurityDatabaseGuid, NULL, &DataSize, NULL);
-  ASSERT (EFI_ERROR (Status));
-  if (Status != EFI_BUFFER_TOO_SMALL) {
-    return VerifyStatus;
-  }
-
-  Data = (UINT8 *) AllocateZeroPool (DataSize);
-  if (Data == NULL) {
-    return VerifyStatus;
-  }
-
-  Status = gRT->GetVariable (EFI_IMAGE_SECURITY_DATABASE, &gEfiImageSecurityDatabaseGuid, NULL, &DataSize, (VOID *) Data);
+  Status = GetSignatureDatabase (EFI_IMAGE_SECURITY_DATABASE, &Db);
   if (EFI_ERROR (Status)) {
-    goto Done;
+    return VerifyStatus;
   }
 
   //
@@ -1474,35 +1399,22 @@ IsAllowedByDb (
   // If any other errors occurred, no need to check 'db' but just return
   // not-allowed-by-db (FALSE) to avoid bypass.
   //
-  DbxDataSize = 0;
-  Status      = gRT->GetVariable (EFI_IMAGE_SECURITY_DATABASE1, &gEfiImageSecurityDatabaseGuid, NULL, &DbxDataSize, NULL);
-  ASSERT (EFI_ERROR (Status));
-  if (Status != EFI_BUFFER_TOO_SMALL) {
+  Status = GetSignatureDatabase (EFI_IMAGE_SECURITY_DATABASE1, &Dbx);
+  if (EFI_ERROR (Status)) {
     if (Status != EFI_NOT_FOUND) {
       goto Done;
     }
     //
     // 'dbx' does not exist. Continue to check 'db'.
     //
-  } else {
-    //
-    // 'dbx' exists. Get its content.
-    //
-    DbxData = (UINT8 *) AllocateZeroPool (DbxDataSize);
-    if (DbxData == NULL) {
-      goto Done;
-    }
-
-    Status = gRT->GetVariable (EFI_IMAGE_SECURITY_DATABASE1, &gEfiImageSecurityDatabaseGuid, NULL, &DbxDataSize, (VOID *) DbxData);
-    if (EFI_ERROR (Status)) {
-      goto Done;
-    }
+    Dbx = NULL;
   }
 
   //
   // Find X509 certificate in Signature List to verify the signature in pkcs7 signed data.
   //
-  CertList = (EFI_SIGNATURE_LIST *) Data;
+  DataSize = Db->DataSize;
+  CertList = (EFI_SIGNATURE_LIST *) Db->Data;
   while ((DataSize > 0) && (DataSize >= CertList->SignatureListSize)) {
     if (CompareGuid (&CertList->SignatureType, &gEfiCertX509Guid)) {
       CertData  = (EFI_SIGNATURE_DATA *) ((UINT8 *) CertList + sizeof (EFI_SIGNATURE_LIST) + CertList->SignatureHeaderSize);
@@ -1530,11 +1442,11 @@ IsAllowedByDb (
           //
           // The image is signed and its signature is found in 'db'.
           //
-          if (DbxData != NULL) {
+          if (Dbx != NULL) {
             //
             // Here We still need to check if this RootCert's Hash is revoked
             //
-            Status = IsCertHashFoundInDbx (RootCert, RootCertSize, (EFI_SIGNATURE_LIST *)DbxData, DbxDataSize, &RevocationTime, &IsFound);
+            Status = IsCertHashFoundInDbx (RootCert, RootCertSize, Dbx, &RevocationTime, &IsFound);
             if (EFI_ERROR (Status)) {
               //
               // Error in searching dbx. Consider it as 'found'. RevocationTime might
@@ -1575,13 +1487,6 @@ Done:
     SecureBootHook (EFI_IMAGE_SECURITY_DATABASE, &gEfiImageSecurityDatabaseGuid, CertList->SignatureSize, CertData);
   }
 
-  if (Data != NULL) {
-    FreePool (Data);
-  }
-  if (DbxData != NULL) {
-    FreePool (DbxData);
-  }
-
   return VerifyStatus;
 }
 
@@ -1914,7 +1819,7 @@ DxeImageVerificationHandler (
     //
     // Check the digital signature against the revoked certificate in forbidden database (dbx).
     //
-    if (IsForbiddenByDbx (AuthData, AuthDataSize)) {
+    if (IsForbiddenByDbxCached (AuthData, AuthDataSize)) {
       Action = EFI_IMAGE_EXECUTION_AUTH_SIG_FAILED;
       IsVerified = FALSE;
       break;
@@ -1924,7 +1829,7 @@ DxeImageVerificationHandler (
     // Check the digital signature against the valid certificate in allowed database (db).
     //
     if (!IsVerified) {
-      if (IsAllowedByDb (AuthData, AuthDataSize)) {
+      if (IsAllowedByDbCached (AuthData, AuthDataSize)) {
         IsVerified = TRUE;
       }
     }
@@ -2030,6 +1935,17 @@ OnReadyToBoot (
 {
   EFI_IMAGE_EXECUTION_INFO_TABLE  *ImageExeInfoTable;
   UINTN                           ImageExeInfoTableSize;
+  VERIFICATION_CACHE_STATS        Stats;
+
+  GetVerificationCacheStats (&Stats);
+  DEBUG ((
+    DEBUG_INFO,
+    "DxeImageVerificationLib: Verification cache hits %ld, misses %ld, evictions %ld, invalidations %ld.\n",
+    Stats.Hits,
+    Stats.Misses,
+    Stats.Evictions,
+    Stats.Invalidations
+    ));
 
   EfiGetSystemConfigurationTable (&gEfiImageSecurityDatabaseGuid, (VOID **) &ImageExeInfoTable);
   if (ImageExeInfoTable != NULL) {
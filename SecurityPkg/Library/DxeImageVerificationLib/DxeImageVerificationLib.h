@@ -198,4 +198,219 @@ typedef struct {
   HASH_FINAL               HashFinal;
 } HASH_TABLE;
 
+//
+// One signature data entry of an image security database
+//
+typedef struct {
+  EFI_SIGNATURE_LIST       *CertList;
+  EFI_SIGNATURE_DATA       *Cert;
+} SIGNATURE_INDEX_ENTRY;
+
+//
+// Cached content and sorted index of an image security database
+//
+typedef struct {
+  //
+  // Name of the database variable
+  //
+  CHAR16                   *VariableName;
+  //
+  // Scratch buffer the variable is read into
+  //
+  UINT8                    *Buffer;
+  UINTN                    BufferSize;
+  //
+  // Content the index was built from
+  //
+  UINT8                    *Data;
+  UINTN                    DataSize;
+  BOOLEAN                  Valid;
+  //
+  // Signature data entries sorted by signature type and data
+  //
+  SIGNATURE_INDEX_ENTRY    *Index;
+  UINTN                    IndexCount;
+} SIGNATURE_DATABASE;
+
+//
+// Number of Authenticode signatures whose verification results are cached
+//
+#define VERIFICATION_CACHE_ENTRY_COUNT    32
+
+//
+// Statistics of the verification result cache
+//
+typedef struct {
+  //
+  // dbx or db checks answered from the cache
+  //
+  UINT64                   Hits;
+  //
+  // dbx or db checks that went through PKCS#7 verification
+  //
+  UINT64                   Misses;
+  //
+  // Entries dropped to make room for another signature
+  //
+  UINT64                   Evictions;
+  //
+  // Times the cache was emptied because db, dbx or dbt changed
+  //
+  UINT64                   Invalidations;
+} VERIFICATION_CACHE_STATS;
+
+extern EFI_GUID            mCertType;
+extern UINT8               mImageDigest[MAX_DIGEST_SIZE];
+extern UINTN               mImageDigestSize;
+extern UINT64              mSignatureDatabaseGeneration;
+
+/**
+  Get the current content and index of an image security database.
+
+  The variable is read on every call. The index is rebuilt only if the
+  content differs from the one it was built from.
+
+  @param[in]   VariableName      Name of the database variable, db, dbx or dbt.
+  @param[out]  Database          Returns the signature database. The content
+                                 stays valid until the next call for the same
+                                 variable.
+
+  @retval EFI_SUCCESS            The database was returned.
+  @retval EFI_NOT_FOUND          The database variable does not exist.
+  @retval EFI_UNSUPPORTED        VariableName is not db, dbx or dbt.
+  @retval EFI_OUT_OF_RESOURCES   Not enough memory to read or index the database.
+  @retval Others                 The variable could not be read.
+
+**/
+EFI_STATUS
+GetSignatureDatabase (
+  IN  CHAR16              *VariableName,
+  OUT SIGNATURE_DATABASE  **Database
+  );
+
+/**
+  Get the generation of the image security databases.
+
+  All of db, dbx and dbt are read, and the generation changes whenever the
+  content of any of them changed since the previous call.
+
+  @return The generation of the signature databases, or 0 if any of them
+          could not be read.
+
+**/
+UINT64
+GetSignatureDatabaseGeneration (
+  VOID
+  );
+
+/**
+  Search a signature database for signature data of the given type.
+
+  @param[in]   Database          Pointer to the signature database.
+  @param[in]   SignatureType     Signature type to search for.
+  @param[in]   Key               Signature data to search for. Only the
+                                 leading KeySize bytes of the signature data
+                                 are compared.
+  @param[in]   KeySize           Size of Key in bytes. Zero matches any
+                                 signature data of SignatureType.
+  @param[in]   SignatureSize     Required SignatureSize of the signature list
+                                 holding the entry, or zero for any size.
+  @param[out]  CertList          Returns the signature list of the entry found.
+                                 Optional.
+  @param[out]  Cert              Returns the signature data of the entry found.
+                                 Optional.
+
+  @retval TRUE                   A matching entry was found.
+  @retval FALSE                  No matching entry is in the database.
+
+**/
+BOOLEAN
+FindSignatureInDatabase (
+  IN  SIGNATURE_DATABASE  *Database,
+  IN  EFI_GUID            *SignatureType,
+  IN  UINT8               *Key,
+  IN  UINTN               KeySize,
+  IN  UINTN               SignatureSize,
+  OUT EFI_SIGNATURE_LIST  **CertList  OPTIONAL,
+  OUT EFI_SIGNATURE_DATA  **Cert      OPTIONAL
+  );
+
+/**
+  Check whether the image signature is forbidden by the forbidden database (dbx).
+  The image is forbidden to load if any certificates for signing are revoked before signing time.
+
+  @param[in]  AuthData      Pointer to the Authenticode signature retrieved from the signed image.
+  @param[in]  AuthDataSize  Size of the Authenticode signature in bytes.
+
+  @retval TRUE              Image is forbidden by dbx.
+  @retval FALSE             Image is not forbidden by dbx.
+
+**/
+BOOLEAN
+IsForbiddenByDbx (
+  IN UINT8                  *AuthData,
+  IN UINTN                  AuthDataSize
+  );
+
+/**
+  Check whether the image signature can be verified by the trusted certificates in DB database.
+
+  @param[in]  AuthData      Pointer to the Authenticode signature retrieved from signed image.
+  @param[in]  AuthDataSize  Size of the Authenticode signature in bytes.
+
+  @retval TRUE         Image passed verification using certificate in db.
+  @retval FALSE        Image didn't pass verification using certificate in db.
+
+**/
+BOOLEAN
+IsAllowedByDb (
+  IN UINT8                  *AuthData,
+  IN UINTN                  AuthDataSize
+  );
+
+/**
+  Check whether the image signature is forbidden by the forbidden database (dbx),
+  reusing a previous result for the same image and signature if possible.
+
+  @param[in]  AuthData      Pointer to the Authenticode signature retrieved from the signed image.
+  @param[in]  AuthDataSize  Size of the Authenticode signature in bytes.
+
+  @retval TRUE              Image is forbidden by dbx.
+  @retval FALSE             Image is not forbidden by dbx.
+
+**/
+BOOLEAN
+IsForbiddenByDbxCached (
+  IN UINT8                  *AuthData,
+  IN UINTN                  AuthDataSize
+  );
+
+/**
+  Check whether the image signature can be verified by the trusted certificates in DB database,
+  reusing a previous result for the same image and signature if possible.
+
+  @param[in]  AuthData      Pointer to the Authenticode signature retrieved from signed image.
+  @param[in]  AuthDataSize  Size of the Authenticode signature in bytes.
+
+  @retval TRUE         Image passed verification using certificate in db.
+  @retval FALSE        Image didn't pass verification using certificate in db.
+
+**/
+BOOLEAN
+IsAllowedByDbCached (
+  IN UINT8                  *AuthData,
+  IN UINTN                  AuthDataSize
+  );
+
+/**
+  Get the statistics of the verification result cache.
+
+  @param[out]  Stats        Returns the statistics.
+
+**/
+VOID
+GetVerificationCacheStats (
+  OUT VERIFICATION_CACHE_STATS  *Stats
+  );
+
 #endif
@@ -0,0 +1,469 @@
+/** @file
+  In-memory index of the image security databases (db and dbx).
+
+  The signature lists of a database are flattened into an array of signature
+  data entries sorted by signature type and signature data, so that hash and
+  certificate hash lookups are binary searches instead of linear walks of
+  every EFI_SIGNATURE_LIST. The variable content is still read on every
+  lookup; the index is rebuilt only when that content differs from the copy
+  it was built from, so any update of the variable invalidates it.
+
+Copyright (c) 2026, agent. All rights reserved.<BR>
+SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "DxeImageVerificationLib.h"
+
+SIGNATURE_DATABASE  mSignatureDatabase[] = {
+  { EFI_IMAGE_SECURITY_DATABASE,  NULL, 0, NULL, 0, FALSE, NULL, 0 },
+  { EFI_IMAGE_SECURITY_DATABASE1, NULL, 0, NULL, 0, FALSE, NULL, 0 },
+  { EFI_IMAGE_SECURITY_DATABASE2, NULL, 0, NULL, 0, FALSE, NULL, 0 },
+};
+
+//
+// Bumped whenever the content of any signature database changes
+//
+UINT64  mSignatureDatabaseGeneration = 1;
+
+/**
+  Compare a signature index entry with a search key.
+
+  Entries are ordered by signature type, then by signature data. When the key
+  is shorter than the signature data, only the leading KeySize bytes of the
+  signature data are compared, so all entries beginning with the key compare
+  equal to it.
+
+  @param[in]  Entry          Pointer to the signature index entry.
+  @param[in]  SignatureType  Signature type of the key.
+  @param[in]  Key            Pointer to the key data.
+  @param[in]  KeySize        Size of the key data in bytes.
+
+  @retval <0                 Entry sorts before the key.
+  @retval 0                  Entry matches the key.
+  @retval >0                 Entry sorts after the key.
+
+**/
+INTN
+CompareSignatureEntry (
+  IN CONST SIGNATURE_INDEX_ENTRY  *Entry,
+  IN CONST EFI_GUID               *SignatureType,
+  IN CONST UINT8                  *Key,
+  IN UINTN                        KeySize
+  )
+{
+  INTN   Result;
+  UINTN  DataSize;
+
+  Result = CompareMem (&Entry->CertList->SignatureType, SignatureType, sizeof (EFI_GUID));
+  if (Result != 0) {
+    return Result;
+  }
+
+  DataSize = Entry->CertList->SignatureSize - sizeof (EFI_GUID);
+  Result   = CompareMem (Entry->Cert->SignatureData, Key, MIN (DataSize, KeySize));
+  if ((Result == 0) && (DataSize < KeySize)) {
+    Result = -1;
+  }
+
+  return Result;
+}
+
+/**
+  Compare two signature index entries by signature type and signature data.
+
+  @param[in]  Left           Pointer to the first entry.
+  @param[in]  Right          Pointer to the second entry.
+
+  @retval <0                 Left sorts before Right.
+  @retval 0                  Left and Right are identical.
+  @retval >0                 Left sorts after Right.
+
+**/
+INTN
+CompareSignatureEntries (
+  IN CONST SIGNATURE_INDEX_ENTRY  *Left,
+  IN CONST SIGNATURE_INDEX_ENTRY  *Right
+  )
+{
+  INTN   Result;
+  UINTN  LeftSize;
+  UINTN  RightSize;
+
+  LeftSize  = Left->CertList->SignatureSize - sizeof (EFI_GUID);
+  RightSize = Right->CertList->SignatureSize - sizeof (EFI_GUID);
+  Result    = CompareSignatureEntry (Left, &Right->CertList->SignatureType, Right->Cert->SignatureData, RightSize);
+  if ((Result == 0) && (LeftSize > RightSize)) {
+    Result = 1;
+  }
+
+  return Result;
+}
+
+/**
+  Sift an entry down the heap rooted at Start.
+
+  @param[in, out]  Entries   Signature index entries.
+  @param[in]       Start     Index of the heap root.
+  @param[in]       Count     Number of entries in the heap.
+
+**/
+VOID
+SiftDownSignatureEntry (
+  IN OUT SIGNATURE_INDEX_ENTRY  *Entries,
+  IN     UINTN                  Start,
+  IN     UINTN                  Count
+  )
+{
+  UINTN                  Root;
+  UINTN                  Child;
+  SIGNATURE_INDEX_ENTRY  Swap;
+
+  Root = Start;
+  while (2 * Root + 1 < Count) {
+    Child = 2 * Root + 1;
+    if ((Child + 1 < Count) && (CompareSignatureEntries (&Entries[Child], &Entries[Child + 1]) < 0)) {
+      Child++;
+    }
+
+    if (CompareSignatureEntries (&Entries[Root], &Entries[Child]) >= 0) {
+      return;
+    }
+
+    Swap           = Entries[Root];
+    Entries[Root]  = Entries[Child];
+    Entries[Child] = Swap;
+    Root           = Child;
+  }
+}
+
+/**
+  Sort the signature index entries in place.
+
+  Heap sort is used since it needs no extra memory and has no quadratic worst
+  case on the mostly ordered lists found in dbx.
+
+  @param[in, out]  Entries   Signature index entries.
+  @param[in]       Count     Number of entries.
+
+**/
+VOID
+SortSignatureEntries (
+  IN OUT SIGNATURE_INDEX_ENTRY  *Entries,
+  IN     UINTN                  Count
+  )
+{
+  UINTN                  Index;
+  SIGNATURE_INDEX_ENTRY  Swap;
+
+  if (Count < 2) {
+    return;
+  }
+
+  for (Index = Count / 2; Index > 0; Index--) {
+    SiftDownSignatureEntry (Entries, Index - 1, Count);
+  }
+
+  for (Index = Count - 1; Index > 0; Index--) {
+    Swap           = Entries[0];
+    Entries[0]     = Entries[Index];
+    Entries[Index] = Swap;
+    SiftDownSignatureEntry (Entries, 0, Index);
+  }
+}
+
+/**
+  Walk the signature lists of a database, optionally recording each signature
+  data entry.
+
+  The walk stops at the first malformed signature list.
+
+  @param[in]   Data          Pointer to the database content.
+  @param[in]   DataSize      Size of the database content in bytes.
+  @param[out]  Entries       Array receiving the entries. May be NULL to only
+                             count them.
+
+  @return The number of signature data entries in the database.
+
+**/
+UINTN
+EnumerateSignatureEntries (
+  IN  UINT8                  *Data,
+  IN  UINTN                  DataSize,
+  OUT SIGNATURE_INDEX_ENTRY  *Entries  OPTIONAL
+  )
+{
+  EFI_SIGNATURE_LIST  *CertList;
+  EFI_SIGNATURE_DATA  *Cert;
+  UINTN               HeaderSize;
+  UINTN               CertCount;
+  UINTN               Index;
+  UINTN               Count;
+
+  Count    = 0;
+  CertList = (EFI_SIGNATURE_LIST *) Data;
+  while ((DataSize >= sizeof (EFI_SIGNATURE_LIST)) && (DataSize >= CertList->SignatureListSize)) {
+    HeaderSize = sizeof (EFI_SIGNATURE_LIST) + CertList->SignatureHeaderSize;
+    if ((CertList->SignatureListSize < HeaderSize) || (CertList->SignatureSize <= sizeof (EFI_GUID))) {
+      break;
+    }
+
+    CertCount = (CertList->SignatureListSize - HeaderSize) / CertList->SignatureSize;
+    Cert      = (EFI_SIGNATURE_DATA *) ((UINT8 *) CertList + HeaderSize);
+    for (Index = 0; Index < CertCount; Index++) {
+      if (Entries != NULL) {
+        Entries[Count].CertList = CertList;
+        Entries[Count].Cert     = Cert;
+      }
+      Count++;
+      Cert = (EFI_SIGNATURE_DATA *) ((UINT8 *) Cert + CertList->SignatureSize);
+    }
+
+    DataSize -= CertList->SignatureListSize;
+    CertList  = (EFI_SIGNATURE_LIST *) ((UINT8 *) CertList + CertList->SignatureListSize);
+  }
+
+  return Count;
+}
+
+/**
+  Drop the index and the cached content of a signature database.
+
+  @param[in, out]  Database  Pointer to the signature database.
+
+**/
+VOID
+InvalidateSignatureDatabase (
+  IN OUT SIGNATURE_DATABASE  *Database
+  )
+{
+  if (Database->Valid) {
+    mSignatureDatabaseGeneration++;
+  }
+  if (Database->Index != NULL) {
+    FreePool (Database->Index);
+    Database->Index = NULL;
+  }
+  if (Database->Data != NULL) {
+    FreePool (Database->Data);
+    Database->Data = NULL;
+  }
+  Database->IndexCount = 0;
+  Database->DataSize   = 0;
+  Database->Valid      = FALSE;
+}
+
+/**
+  Rebuild the index of a signature database from the content just read into
+  its scratch buffer.
+
+  @param[in, out]  Database      Pointer to the signature database.
+  @param[in]       DataSize      Size of the content in the scratch buffer.
+
+  @retval EFI_SUCCESS            The index was rebuilt.
+  @retval EFI_OUT_OF_RESOURCES   Not enough memory to build the index.
+
+**/
+EFI_STATUS
+RebuildSignatureDatabase (
+  IN OUT SIGNATURE_DATABASE  *Database,
+  IN     UINTN               DataSize
+  )
+{
+  UINTN  Count;
+
+  InvalidateSignatureDatabase (Database);
+
+  Database->Data = AllocateCopyPool (DataSize, Database->Buffer);
+  if (Database->Data == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+  Database->DataSize = DataSize;
+
+  Count = EnumerateSignatureEntries (Database->Data, DataSize, NULL);
+  if (Count > 0) {
+    Database->Index = AllocatePool (Count * sizeof (SIGNATURE_INDEX_ENTRY));
+    if (Database->Index == NULL) {
+      InvalidateSignatureDatabase (Database);
+      return EFI_OUT_OF_RESOURCES;
+    }
+    EnumerateSignatureEntries (Database->Data, DataSize, Database->Index);
+    SortSignatureEntries (Database->Index, Count);
+  }
+
+  Database->IndexCount = Count;
+  Database->Valid      = TRUE;
+  mSignatureDatabaseGeneration++;
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Get the current content and index of an image security database.
+
+  The variable is read on every call. The index is rebuilt only if the
+  content differs from the one it was built from.
+
+  @param[in]   VariableName      Name of the database variable, db, dbx or dbt.
+  @param[out]  Database          Returns the signature database. The content
+                                 stays valid until the next call for the same
+                                 variable.
+
+  @retval EFI_SUCCESS            The database was returned.
+  @retval EFI_NOT_FOUND          The database variable does not exist.
+  @retval EFI_UNSUPPORTED        VariableName is not db, dbx or dbt.
+  @retval EFI_OUT_OF_RESOURCES   Not enough memory to read or index the database.
+  @retval Others                 The variable could not be read.
+
+**/
+EFI_STATUS
+GetSignatureDatabase (
+  IN  CHAR16              *VariableName,
+  OUT SIGNATURE_DATABASE  **Database
+  )
+{
+  EFI_STATUS          Status;
+  SIGNATURE_DATABASE  *Db;
+  UINTN               Index;
+  UINTN               DataSize;
+
+  Db = NULL;
+  for (Index = 0; Index < ARRAY_SIZE (mSignatureDatabase); Index++) {
+    if (StrCmp (VariableName, mSignatureDatabase[Index].VariableName) == 0) {
+      Db = &mSignatureDatabase[Index];
+      break;
+    }
+  }
+  if (Db == NULL) {
+    return EFI_UNSUPPORTED;
+  }
+
+  DataSize = Db->BufferSize;
+  Status   = gRT->GetVariable (VariableName, &gEfiImageSecurityDatabaseGuid, NULL, &DataSize, Db->Buffer);
+  if (Status == EFI_BUFFER_TOO_SMALL) {
+    if (Db->Buffer != NULL) {
+      FreePool (Db->Buffer);
+    }
+    Db->BufferSize = 0;
+    Db->Buffer     = AllocatePool (DataSize);
+    if (Db->Buffer == NULL) {
+      InvalidateSignatureDatabase (Db);
+      return EFI_OUT_OF_RESOURCES;
+    }
+    Db->BufferSize = DataSize;
+
+    Status = gRT->GetVariable (VariableName, &gEfiImageSecurityDatabaseGuid, NULL, &DataSize, Db->Buffer);
+  }
+  if (EFI_ERROR (Status)) {
+    InvalidateSignatureDatabase (Db);
+    return Status;
+  }
+
+  if (!Db->Valid || (Db->DataSize != DataSize) || (CompareMem (Db->Data, Db->Buffer, DataSize) != 0)) {
+    DEBUG ((DEBUG_INFO, "DxeImageVerificationLib: Indexing %s.\n", VariableName));
+    Status = RebuildSignatureDatabase (Db, DataSize);
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+  }
+
+  *Database = Db;
+  return EFI_SUCCESS;
+}
+
+/**
+  Get the generation of the image security databases.
+
+  All of db, dbx and dbt are read, and the generation changes whenever the
+  content of any of them changed since the previous call.
+
+  @return The generation of the signature databases, or 0 if any of them
+          could not be read.
+
+**/
+UINT64
+GetSignatureDatabaseGeneration (
+  VOID
+  )
+{
+  EFI_STATUS          Status;
+  SIGNATURE_DATABASE  *Database;
+  UINTN               Index;
+
+  for (Index = 0; Index < ARRAY_SIZE (mSignatureDatabase); Index++) {
+    Status = GetSignatureDatabase (mSignatureDatabase[Index].VariableName, &Database);
+    if (EFI_ERROR (Status) && (Status != EFI_NOT_FOUND)) {
+      return 0;
+    }
+  }
+
+  return mSignatureDatabaseGeneration;
+}
+
+/**
+  Search a signature database for signature data of the given type.
+
+  @param[in]   Database          Pointer to the signature database.
+  @param[in]   SignatureType     Signature type to search for.
+  @param[in]   Key               Signature data to search for. Only the
+                                 leading KeySize bytes of the signature data
+                                 are compared.
+  @param[in]   KeySize           Size of Key in bytes. Zero matches any
+                                 signature data of SignatureType.
+  @param[in]   SignatureSize     Required SignatureSize of the signature list
+                                 holding the entry, or zero for any size.
+  @param[out]  CertList          Returns the signature list of the entry found.
+                                 Optional.
+  @param[out]  Cert              Returns the signature data of the entry found.
+                                 Optional.
+
+  @retval TRUE                   A matching entry was found.
+  @retval FALSE                  No matching entry is in the database.
+
+**/
+BOOLEAN
+FindSignatureInDatabase (
+  IN  SIGNATURE_DATABASE  *Database,
+  IN  EFI_GUID            *SignatureType,
+  IN  UINT8               *Key,
+  IN  UINTN               KeySize,
+  IN  UINTN               SignatureSize,
+  OUT EFI_SIGNATURE_LIST  **CertList  OPTIONAL,
+  OUT EFI_SIGNATURE_DATA  **Cert      OPTIONAL
+  )
+{
+  UINTN  Low;
+  UINTN  High;
+  UINTN  Middle;
+
+  //
+  // Find the first entry not sorting before the key.
+  //
+  Low  = 0;
+  High = Database->IndexCount;
+  while (Low < High) {
+    Middle = Low + (High - Low) / 2;
+    if (CompareSignatureEntry (&Database->Index[Middle], SignatureType, Key, KeySize) < 0) {
+      Low = Middle + 1;
+    } else {
+      High = Middle;
+    }
+  }
+
+  for (; Low < Database->IndexCount; Low++) {
+    if (CompareSignatureEntry (&Database->Index[Low], SignatureType, Key, KeySize) != 0) {
+      break;
+    }
+    if ((SignatureSize == 0) || (Database->Index[Low].CertList->SignatureSize == SignatureSize)) {
+      if (CertList != NULL) {
+        *CertList = Database->Index[Low].CertList;
+      }
+      if (Cert != NULL) {
+        *Cert = Database->Index[Low].Cert;
+      }
+      return TRUE;
+    }
+  }
+
+  return FALSE;
+}
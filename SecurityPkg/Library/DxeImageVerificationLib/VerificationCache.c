@@ -0,0 +1,221 @@
+/** @file
+  Cache of Authenticode signature verification results.
+
+  Verifying an Authenticode signature against db and dbx parses the X.509
+  certificates and performs the RSA operations of the PKCS#7 chain every time
+  an image is loaded, even when the same image was verified moments earlier
+  (driver reconnects, shell re-execution, retried boot options).
+
+  A successful dbx or db check is remembered for the pair (image digest,
+  SHA-256 of the signature), together with the generation of the signature
+  databases it was made against. Any change of db, dbx or dbt bumps that
+  generation and empties the cache. Failed checks are never cached, so
+  rejecting an image always goes through the full verification.
+
+Copyright (c) 2026, agent. All rights reserved.<BR>
+SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "DxeImageVerificationLib.h"
+
+typedef struct {
+  //
+  // Generation of the signature databases the results belong to, 0 if unused
+  //
+  UINT64                   Generation;
+  //
+  // Value of mVerificationCacheTick when the entry was last used
+  //
+  UINT64                   LastUsed;
+  EFI_GUID                 CertType;
+  UINTN                    ImageDigestSize;
+  UINT8                    ImageDigest[MAX_DIGEST_SIZE];
+  UINT8                    AuthDataDigest[SHA256_DIGEST_SIZE];
+  //
+  // The signature is known not to be forbidden by dbx
+  //
+  BOOLEAN                  NotForbiddenByDbx;
+  //
+  // The signature is known to be allowed by db
+  //
+  BOOLEAN                  AllowedByDb;
+} VERIFICATION_CACHE_ENTRY;
+
+VERIFICATION_CACHE_ENTRY  mVerificationCache[VERIFICATION_CACHE_ENTRY_COUNT];
+UINT64                    mVerificationCacheGeneration = 0;
+UINT64                    mVerificationCacheTick       = 0;
+VERIFICATION_CACHE_STATS  mVerificationCacheStats;
+
+/**
+  Find the cache entry of an Authenticode signature of the current image,
+  creating one if none exists.
+
+  The image is identified by mCertType and mImageDigest, which must have been
+  computed for this signature by HashPeImageByType().
+
+  @param[in]  AuthData      Pointer to the Authenticode signature retrieved from the signed image.
+  @param[in]  AuthDataSize  Size of the Authenticode signature in bytes.
+
+  @return The cache entry, or NULL if the signature databases can't be read
+          and the result must not be cached.
+
+**/
+VERIFICATION_CACHE_ENTRY *
+GetVerificationCacheEntry (
+  IN UINT8                  *AuthData,
+  IN UINTN                  AuthDataSize
+  )
+{
+  UINT64                    Generation;
+  UINT8                     AuthDataDigest[SHA256_DIGEST_SIZE];
+  VERIFICATION_CACHE_ENTRY  *Entry;
+  VERIFICATION_CACHE_ENTRY  *Victim;
+  UINTN                     Index;
+
+  Generation = GetSignatureDatabaseGeneration ();
+  if (Generation == 0) {
+    return NULL;
+  }
+
+  if (Generation != mVerificationCacheGeneration) {
+    //
+    // db, dbx or dbt changed, none of the cached results can be trusted.
+    //
+    if (mVerificationCacheGeneration != 0) {
+      mVerificationCacheStats.Invalidations++;
+    }
+    ZeroMem (mVerificationCache, sizeof (mVerificationCache));
+    mVerificationCacheGeneration = Generation;
+  }
+
+  if ((mImageDigestSize > MAX_DIGEST_SIZE) || !Sha256HashAll (AuthData, AuthDataSize, AuthDataDigest)) {
+    return NULL;
+  }
+
+  mVerificationCacheTick++;
+  Victim = &mVerificationCache[0];
+  for (Index = 0; Index < VERIFICATION_CACHE_ENTRY_COUNT; Index++) {
+    Entry = &mVerificationCache[Index];
+    if ((Entry->Generation == Generation) &&
+        (Entry->ImageDigestSize == mImageDigestSize) &&
+        CompareGuid (&Entry->CertType, &mCertType) &&
+        (CompareMem (Entry->ImageDigest, mImageDigest, mImageDigestSize) == 0) &&
+        (CompareMem (Entry->AuthDataDigest, AuthDataDigest, SHA256_DIGEST_SIZE) == 0)) {
+      Entry->LastUsed = mVerificationCacheTick;
+      return Entry;
+    }
+
+    if (Entry->LastUsed < Victim->LastUsed) {
+      Victim = Entry;
+    }
+  }
+
+  //
+  // Take over a free entry, or the least recently used one.
+  //
+  if (Victim->Generation != 0) {
+    mVerificationCacheStats.Evictions++;
+  }
+  ZeroMem (Victim, sizeof (*Victim));
+  Victim->Generation      = Generation;
+  Victim->LastUsed        = mVerificationCacheTick;
+  Victim->ImageDigestSize = mImageDigestSize;
+  CopyGuid (&Victim->CertType, &mCertType);
+  CopyMem (Victim->ImageDigest, mImageDigest, mImageDigestSize);
+  CopyMem (Victim->AuthDataDigest, AuthDataDigest, SHA256_DIGEST_SIZE);
+
+  return Victim;
+}
+
+/**
+  Check whether the image signature is forbidden by the forbidden database (dbx),
+  reusing a previous result for the same image and signature if possible.
+
+  @param[in]  AuthData      Pointer to the Authenticode signature retrieved from the signed image.
+  @param[in]  AuthDataSize  Size of the Authenticode signature in bytes.
+
+  @retval TRUE              Image is forbidden by dbx.
+  @retval FALSE             Image is not forbidden by dbx.
+
+**/
+BOOLEAN
+IsForbiddenByDbxCached (
+  IN UINT8                  *AuthData,
+  IN UINTN                  AuthDataSize
+  )
+{
+  VERIFICATION_CACHE_ENTRY  *Entry;
+  BOOLEAN                   IsForbidden;
+
+  Entry = GetVerificationCacheEntry (AuthData, AuthDataSize);
+  if ((Entry != NULL) && Entry->NotForbiddenByDbx) {
+    mVerificationCacheStats.Hits++;
+    return FALSE;
+  }
+
+  mVerificationCacheStats.Misses++;
+  IsForbidden = IsForbiddenByDbx (AuthData, AuthDataSize);
+
+  //
+  // Only remember the result if the databases did not change while checking.
+  //
+  if (!IsForbidden && (Entry != NULL) && (Entry->Generation == mSignatureDatabaseGeneration)) {
+    Entry->NotForbiddenByDbx = TRUE;
+  }
+
+  return IsForbidden;
+}
+
+/**
+  Check whether the image signature can be verified by the trusted certificates in DB database,
+  reusing a previous result for the same image and signature if possible.
+
+  @param[in]  AuthData      Pointer to the Authenticode signature retrieved from signed image.
+  @param[in]  AuthDataSize  Size of the Authenticode signature in bytes.
+
+  @retval TRUE         Image passed verification using certificate in db.
+  @retval FALSE        Image didn't pass verification using certificate in db.
+
+**/
+BOOLEAN
+IsAllowedByDbCached (
+  IN UINT8                  *AuthData,
+  IN UINTN                  AuthDataSize
+  )
+{
+  VERIFICATION_CACHE_ENTRY  *Entry;
+  BOOLEAN                   IsAllowed;
+
+  Entry = GetVerificationCacheEntry (AuthData, AuthDataSize);
+  if ((Entry != NULL) && Entry->AllowedByDb) {
+    mVerificationCacheStats.Hits++;
+    return TRUE;
+  }
+
+  mVerificationCacheStats.Misses++;
+  IsAllowed = IsAllowedByDb (AuthData, AuthDataSize);
+
+  //
+  // Only remember the result if the databases did not change while checking.
+  //
+  if (IsAllowed && (Entry != NULL) && (Entry->Generation == mSignatureDatabaseGeneration)) {
+    Entry->AllowedByDb = TRUE;
+  }
+
+  return IsAllowed;
+}
+
+/**
+  Get the statistics of the verification result cache.
+
+  @param[out]  Stats        Returns the statistics.
+
+**/
+VOID
+GetVerificationCacheStats (
+  OUT VERIFICATION_CACHE_STATS  *Stats
+  )
+{
+  CopyMem (Stats, &mVerificationCacheStats, sizeof (VERIFICATION_CACHE_STATS));
+}
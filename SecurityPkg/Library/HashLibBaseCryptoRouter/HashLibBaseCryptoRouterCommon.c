@@ -12,9 +12,12 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Library/Tpm2CommandLib.h>
 #include <Library/DebugLib.h>
 #include <Library/MemoryAllocationLib.h>
+#include <Library/PcdLib.h>
 #include <Library/HashLib.h>
 #include <Protocol/Tcg2Protocol.h>
 
+#include "HashLibBaseCryptoRouterCommon.h"
+
 typedef struct {
   EFI_GUID  Guid;
   UINT32    Mask;
@@ -70,3 +73,65 @@ Tpm2SetHashToDigestList (
     );
   DigestList->count ++;
 }
+
+/**
+  Update the hash sequences of all the active hash algorithms with the data.
+
+  The data is processed block by block, each block going through all the
+  active algorithms before the next one, so it is read from memory once
+  however many PCR banks are active.
+
+  @param HashInterface      Registered hash interfaces.
+  @param HashInterfaceCount Number of registered hash interfaces.
+  @param HashCtx            Hash contexts, one per registered hash interface.
+  @param DataToHash         Data to be hashed.
+  @param DataToHashLen      Data size.
+**/
+VOID
+EFIAPI
+HashUpdateActiveAlgorithms (
+  IN HASH_INTERFACE  *HashInterface,
+  IN UINTN           HashInterfaceCount,
+  IN HASH_HANDLE     *HashCtx,
+  IN VOID            *DataToHash,
+  IN UINTN           DataToHashLen
+  )
+{
+  UINTN   Active[HASH_COUNT];
+  UINTN   ActiveCount;
+  UINTN   Index;
+  UINT8   *Block;
+  UINTN   BlockSize;
+  UINT32  HashMask;
+
+  ActiveCount = 0;
+  for (Index = 0; Index < HashInterfaceCount && ActiveCount < HASH_COUNT; Index++) {
+    HashMask = Tpm2GetHashMaskFromAlgo (&HashInterface[Index].HashGuid);
+    if ((HashMask & PcdGet32 (PcdTpm2HashMask)) != 0) {
+      Active[ActiveCount++] = Index;
+    }
+  }
+
+  if (ActiveCount == 0) {
+    return;
+  }
+
+  //
+  // With a single active algorithm, there is nothing to interleave.
+  //
+  if (ActiveCount == 1) {
+    HashInterface[Active[0]].HashUpdate (HashCtx[Active[0]], DataToHash, DataToHashLen);
+    return;
+  }
+
+  Block = (UINT8 *)DataToHash;
+  while (DataToHashLen > 0) {
+    BlockSize = MIN (DataToHashLen, HASH_UPDATE_BLOCK_SIZE);
+    for (Index = 0; Index < ActiveCount; Index++) {
+      HashInterface[Active[Index]].HashUpdate (HashCtx[Active[Index]], Block, BlockSize);
+    }
+
+    Block         += BlockSize;
+    DataToHashLen -= BlockSize;
+  }
+}
@@ -9,6 +9,12 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #ifndef _HASH_LIB_BASE_CRYPTO_ROUTER_COMMON_H_
 #define _HASH_LIB_BASE_CRYPTO_ROUTER_COMMON_H_
 
+//
+// Size of the blocks that are fed through every active hash algorithm in turn,
+// small enough for the block to stay in the data cache between algorithms.
+//
+#define HASH_UPDATE_BLOCK_SIZE  SIZE_8KB
+
 /**
   The function get hash mask info from algorithm.
 
@@ -35,4 +41,27 @@ Tpm2SetHashToDigestList (
   IN TPML_DIGEST_VALUES     *Digest
   );
 
+/**
+  Update the hash sequences of all the active hash algorithms with the data.
+
+  The data is processed block by block, each block going through all the
+  active algorithms before the next one, so it is read from memory once
+  however many PCR banks are active.
+
+  @param HashInterface      Registered hash interfaces.
+  @param HashInterfaceCount Number of registered hash interfaces.
+  @param HashCtx            Hash contexts, one per registered hash interface.
+  @param DataToHash         Data to be hashed.
+  @param DataToHashLen      Data size.
+**/
+VOID
+EFIAPI
+HashUpdateActiveAlgorithms (
+  IN HASH_INTERFACE  *HashInterface,
+  IN UINTN           HashInterfaceCount,
+  IN HASH_HANDLE     *HashCtx,
+  IN VOID            *DataToHash,
+  IN UINTN           DataToHashLen
+  );
+
 #endif
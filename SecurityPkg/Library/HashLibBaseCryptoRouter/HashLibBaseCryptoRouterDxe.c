@@ -3,12 +3,20 @@
   hash handler registered, such as SHA1, SHA256.
   Platform can use PcdTpm2HashMask to mask some hash engines.
 
+  When several hash algorithms are active, large buffers are hashed by each
+  algorithm on a different processor through the MP Services protocol.
+
+  In boot service drivers built with PcdTcg2PcrExtendAsync set and linked with
+  Tpm2CommandAsyncLib, PCR extends are sent to the TPM without waiting for them
+  to complete, so that the TPM executes an extend while the driver hashes the
+  next event. The driver collects each of them with Tpm2PcrExtendComplete().
+
 Copyright (c) 2013 - 2018, Intel Corporation. All rights reserved. <BR>
 SPDX-License-Identifier: BSD-2-Clause-Patent
 
 **/
 
-#include <PiPei.h>
+#include <PiDxe.h>
 #include <Library/BaseLib.h>
 #include <Library/BaseMemoryLib.h>
 #include <Library/Tpm2CommandLib.h>
@@ -16,12 +24,50 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Library/MemoryAllocationLib.h>
 #include <Library/PcdLib.h>
 #include <Library/HashLib.h>
+#include <Library/UefiBootServicesTableLib.h>
+#include <Protocol/MpService.h>
+#include <Protocol/LoadedImage.h>
+#include <Protocol/SmmBase2.h>
 
 #include "HashLibBaseCryptoRouterCommon.h"
 
+//
+// Buffers smaller than this are not worth dispatching to the APs.
+//
+#define HASH_PARALLEL_MIN_SIZE  SIZE_1MB
+
+//
+// Time given to an AP to hash its job, in microseconds: a fixed part plus a
+// part for each started MB, which assumes the AP hashes at least 10 MB/s.
+//
+#define HASH_AP_TIMEOUT_BASE    1000000
+#define HASH_AP_TIMEOUT_PER_MB  100000
+
+typedef struct {
+  HASH_INTERFACE    *HashInterface;
+  HASH_HANDLE       HashCtx;
+  VOID              *DataToHash;
+  UINTN             DataToHashLen;
+  EFI_EVENT         WaitEvent;
+  EFI_STATUS        Status;
+  volatile BOOLEAN  Done;
+} HASH_AP_JOB;
+
 HASH_INTERFACE   mHashInterface[HASH_COUNT] = {{{0}, NULL, NULL, NULL}};
 UINTN            mHashInterfaceCount = 0;
 
+//
+// The APs are only used by boot service drivers and applications. SMM and
+// runtime drivers may hash when the boot services are no longer available.
+//
+BOOLEAN          mHashParallelAllowed = FALSE;
+
+//
+// PCR extends are only left running in the TPM by boot service drivers that
+// collect them, as requested by PcdTcg2PcrExtendAsync.
+//
+BOOLEAN          mPcrExtendAsyncAllowed = FALSE;
+
 UINT32           mSupportedHashMaskLast = 0;
 UINT32           mSupportedHashMaskCurrent = 0;
 
@@ -46,6 +92,261 @@ CheckSupportedHashMaskMismatch (
   }
 }
 
+/**
+  Run one hash update job on an AP.
+
+  Only the hash engine is called, it doesn't use any UEFI service. Nothing is
+  reported from the AP: the status is left in the job for the BSP.
+
+  @param Buffer  Pointer to the HASH_AP_JOB.
+**/
+STATIC
+VOID
+EFIAPI
+HashUpdateOnAp (
+  IN OUT VOID  *Buffer
+  )
+{
+  HASH_AP_JOB  *Job;
+
+  Job = (HASH_AP_JOB *)Buffer;
+  Job->Status = Job->HashInterface->HashUpdate (Job->HashCtx, Job->DataToHash, Job->DataToHashLen);
+  Job->Done   = TRUE;
+}
+
+/**
+  Update the hash sequences of the active hash algorithms in parallel, with
+  the first algorithm running on the BSP and each other one on its own AP.
+
+  Nothing is done unless the MP Services protocol is present, enough APs are
+  enabled and the TPL is below TPL_NOTIFY, at which the MP Services protocol
+  checks for the completion of the APs.
+
+  Each AP is given a timeout, after which the MP Services protocol stops it and
+  signals its event, so the BSP never waits for an AP indefinitely.
+
+  @param HashCtx       Hash contexts, one per registered hash interface.
+  @param DataToHash    Data to be hashed.
+  @param DataToHashLen Data size.
+
+  @retval EFI_SUCCESS      The data has been hashed by all the active algorithms.
+  @retval EFI_UNSUPPORTED  The data has not been hashed by any algorithm.
+  @retval EFI_TIMEOUT      An AP did not complete its job in time, the hash
+                           sequences are no longer usable.
+  @retval Others           An algorithm failed to hash the data.
+**/
+STATIC
+EFI_STATUS
+HashUpdateInParallel (
+  IN HASH_HANDLE  *HashCtx,
+  IN VOID         *DataToHash,
+  IN UINTN        DataToHashLen
+  )
+{
+  EFI_MP_SERVICES_PROTOCOL   *MpService;
+  EFI_PROCESSOR_INFORMATION  ProcessorInfo;
+  HASH_AP_JOB                Job[HASH_COUNT];
+  UINTN                      JobCount;
+  UINTN                      ApNumber[HASH_COUNT];
+  UINTN                      ApCount;
+  UINTN                      NumberOfProcessors;
+  UINTN                      NumberOfEnabledProcessors;
+  UINTN                      ProcessorNumber;
+  UINTN                      Index;
+  UINT32                     HashMask;
+  UINTN                      TimeoutInMicroseconds;
+  EFI_TPL                    OldTpl;
+  EFI_STATUS                 Status;
+  EFI_STATUS                 ReturnStatus;
+
+  OldTpl = gBS->RaiseTPL (TPL_HIGH_LEVEL);
+  gBS->RestoreTPL (OldTpl);
+  if (OldTpl >= TPL_NOTIFY) {
+    return EFI_UNSUPPORTED;
+  }
+
+  JobCount = 0;
+  for (Index = 0; Index < mHashInterfaceCount; Index++) {
+    HashMask = Tpm2GetHashMaskFromAlgo (&mHashInterface[Index].HashGuid);
+    if ((HashMask & PcdGet32 (PcdTpm2HashMask)) != 0) {
+      Job[JobCount].HashInterface = &mHashInterface[Index];
+      Job[JobCount].HashCtx       = HashCtx[Index];
+      Job[JobCount].DataToHash    = DataToHash;
+      Job[JobCount].DataToHashLen = DataToHashLen;
+      Job[JobCount].WaitEvent     = NULL;
+      Job[JobCount].Status        = EFI_SUCCESS;
+      Job[JobCount].Done          = FALSE;
+      JobCount++;
+    }
+  }
+
+  if (JobCount < 2) {
+    return EFI_UNSUPPORTED;
+  }
+
+  Status = gBS->LocateProtocol (&gEfiMpServiceProtocolGuid, NULL, (VOID **)&MpService);
+  if (EFI_ERROR (Status)) {
+    return EFI_UNSUPPORTED;
+  }
+
+  Status = MpService->GetNumberOfProcessors (MpService, &NumberOfProcessors, &NumberOfEnabledProcessors);
+  if (EFI_ERROR (Status) || (NumberOfEnabledProcessors < JobCount)) {
+    return EFI_UNSUPPORTED;
+  }
+
+  //
+  // Pick one enabled and healthy AP for every job but the first one.
+  //
+  ApCount = 0;
+  for (ProcessorNumber = 0; ProcessorNumber < NumberOfProcessors && ApCount < JobCount - 1; ProcessorNumber++) {
+    Status = MpService->GetProcessorInfo (MpService, ProcessorNumber, &ProcessorInfo);
+    if (EFI_ERROR (Status)) {
+      continue;
+    }
+
+    if ((ProcessorInfo.StatusFlag & (PROCESSOR_AS_BSP_BIT | PROCESSOR_ENABLED_BIT | PROCESSOR_HEALTH_STATUS_BIT)) ==
+        (PROCESSOR_ENABLED_BIT | PROCESSOR_HEALTH_STATUS_BIT)) {
+      ApNumber[ApCount++] = ProcessorNumber;
+    }
+  }
+
+  if (ApCount < JobCount - 1) {
+    return EFI_UNSUPPORTED;
+  }
+
+  //
+  // Dispatch the jobs to the APs. A job that cannot be dispatched, for
+  // example because the AP is busy, is run on the BSP.
+  //
+  // Each algorithm is first given an empty update on the BSP, so that a hash
+  // engine reporting an error or asserting does it here rather than on an AP.
+  // An algorithm failing it is left to the BSP as well.
+  //
+  TimeoutInMicroseconds = HASH_AP_TIMEOUT_BASE + (DataToHashLen / SIZE_1MB + 1) * HASH_AP_TIMEOUT_PER_MB;
+  for (Index = 1; Index < JobCount; Index++) {
+    Status = Job[Index].HashInterface->HashUpdate (Job[Index].HashCtx, DataToHash, 0);
+    if (EFI_ERROR (Status)) {
+      continue;
+    }
+
+    Status = gBS->CreateEvent (0, TPL_NOTIFY, NULL, NULL, &Job[Index].WaitEvent);
+    if (EFI_ERROR (Status)) {
+      Job[Index].WaitEvent = NULL;
+      continue;
+    }
+
+    Status = MpService->StartupThisAP (
+                          MpService,
+                          HashUpdateOnAp,
+                          ApNumber[Index - 1],
+                          Job[Index].WaitEvent,
+                          TimeoutInMicroseconds,
+                          &Job[Index],
+                          NULL
+                          );
+    if (EFI_ERROR (Status)) {
+      gBS->CloseEvent (Job[Index].WaitEvent);
+      Job[Index].WaitEvent = NULL;
+    }
+  }
+
+  for (Index = 0; Index < JobCount; Index++) {
+    if (Job[Index].WaitEvent == NULL) {
+      HashUpdateOnAp (&Job[Index]);
+    }
+  }
+
+  //
+  // The event of an AP is signaled when its job returns or when its timeout
+  // expires, whichever comes first.
+  //
+  ReturnStatus = EFI_SUCCESS;
+  for (Index = 0; Index < JobCount; Index++) {
+    if (Job[Index].WaitEvent != NULL) {
+      while (gBS->CheckEvent (Job[Index].WaitEvent) == EFI_NOT_READY) {
+        CpuPause ();
+      }
+
+      gBS->CloseEvent (Job[Index].WaitEvent);
+
+      if (!Job[Index].Done) {
+        DEBUG ((DEBUG_ERROR, "HashUpdateInParallel - AP %Lu timed out hashing %g\n", (UINT64)ApNumber[Index - 1], &Job[Index].HashInterface->HashGuid));
+        Job[Index].Status = EFI_TIMEOUT;
+      }
+    }
+
+    if (EFI_ERROR (Job[Index].Status)) {
+      DEBUG ((DEBUG_ERROR, "HashUpdateInParallel - %g - %r\n", &Job[Index].HashInterface->HashGuid, Job[Index].Status));
+      if (!EFI_ERROR (ReturnStatus) || (Job[Index].Status == EFI_TIMEOUT)) {
+        ReturnStatus = Job[Index].Status;
+      }
+    }
+  }
+
+  return ReturnStatus;
+}
+
+/**
+  Update the hash sequences of all the active hash algorithms with the data.
+
+  @param HashCtx       Hash contexts, one per registered hash interface.
+  @param DataToHash    Data to be hashed.
+  @param DataToHashLen Data size.
+
+  @retval EFI_SUCCESS  The data has been hashed by all the active algorithms.
+  @retval Others       The hash sequences are no longer usable.
+**/
+STATIC
+EFI_STATUS
+HashUpdateAll (
+  IN HASH_HANDLE  *HashCtx,
+  IN VOID         *DataToHash,
+  IN UINTN        DataToHashLen
+  )
+{
+  EFI_STATUS  Status;
+
+  if (mHashParallelAllowed && (DataToHashLen >= HASH_PARALLEL_MIN_SIZE)) {
+    Status = HashUpdateInParallel (HashCtx, DataToHash, DataToHashLen);
+    if (Status != EFI_UNSUPPORTED) {
+      return Status;
+    }
+  }
+
+  HashUpdateActiveAlgorithms (mHashInterface, mHashInterfaceCount, HashCtx, DataToHash, DataToHashLen);
+  return EFI_SUCCESS;
+}
+
+/**
+  Complete the hash sequences of all the active hash algorithms and free them.
+
+  @param HashCtx    Hash contexts, one per registered hash interface.
+  @param DigestList Digest list.
+**/
+STATIC
+VOID
+HashCompleteAll (
+  IN  HASH_HANDLE         *HashCtx,
+  OUT TPML_DIGEST_VALUES  *DigestList
+  )
+{
+  TPML_DIGEST_VALUES  Digest;
+  UINTN               Index;
+  UINT32              HashMask;
+
+  ZeroMem (DigestList, sizeof(*DigestList));
+
+  for (Index = 0; Index < mHashInterfaceCount; Index++) {
+    HashMask = Tpm2GetHashMaskFromAlgo (&mHashInterface[Index].HashGuid);
+    if ((HashMask & PcdGet32 (PcdTpm2HashMask)) != 0) {
+      mHashInterface[Index].HashFinal (HashCtx[Index], &Digest);
+      Tpm2SetHashToDigestList (DigestList, &Digest);
+    }
+  }
+
+  FreePool (HashCtx);
+}
+
 /**
   Start hash sequence.
 
@@ -93,6 +394,9 @@ HashStart (
   @param DataToHashLen Data size.
 
   @retval EFI_SUCCESS     Hash sequence updated.
+  @retval EFI_TIMEOUT     A processor hashing the data did not complete in time.
+                          The hash sequence has been freed, HashHandle must not
+                          be used anymore.
 **/
 EFI_STATUS
 EFIAPI
@@ -102,9 +406,9 @@ HashUpdate (
   IN UINTN          DataToHashLen
   )
 {
-  HASH_HANDLE  *HashCtx;
-  UINTN        Index;
-  UINT32       HashMask;
+  HASH_HANDLE         *HashCtx;
+  TPML_DIGEST_VALUES  DigestList;
+  EFI_STATUS          Status;
 
   if (mHashInterfaceCount == 0) {
     return EFI_UNSUPPORTED;
@@ -114,14 +418,15 @@ HashUpdate (
 
   HashCtx = (HASH_HANDLE *)HashHandle;
 
-  for (Index = 0; Index < mHashInterfaceCount; Index++) {
-    HashMask = Tpm2GetHashMaskFromAlgo (&mHashInterface[Index].HashGuid);
-    if ((HashMask & PcdGet32 (PcdTpm2HashMask)) != 0) {
-      mHashInterface[Index].HashUpdate (HashCtx[Index], DataToHash, DataToHashLen);
-    }
+  Status = HashUpdateAll (HashCtx, DataToHash, DataToHashLen);
+  if (EFI_ERROR (Status)) {
+    //
+    // The callers give up on the hash sequence on error, free it here.
+    //
+    HashCompleteAll (HashCtx, &DigestList);
   }
 
-  return EFI_SUCCESS;
+  return Status;
 }
 
 /**
@@ -133,6 +438,10 @@ HashUpdate (
   @param DataToHashLen Data size.
   @param DigestList    Digest list.
 
+  When PcdTcg2PcrExtendAsync is set, the PCR extend may still be running in the
+  TPM when EFI_SUCCESS is returned. The caller must then collect it with
+  Tpm2PcrExtendComplete().
+
   @retval EFI_SUCCESS     Hash sequence complete and DigestList is returned.
 **/
 EFI_STATUS
@@ -145,11 +454,8 @@ HashCompleteAndExtend (
   OUT TPML_DIGEST_VALUES *DigestList
   )
 {
-  TPML_DIGEST_VALUES Digest;
   HASH_HANDLE        *HashCtx;
-  UINTN              Index;
   EFI_STATUS         Status;
-  UINT32             HashMask;
 
   if (mHashInterfaceCount == 0) {
     return EFI_UNSUPPORTED;
@@ -158,18 +464,28 @@ HashCompleteAndExtend (
   CheckSupportedHashMaskMismatch ();
 
   HashCtx = (HASH_HANDLE *)HashHandle;
-  ZeroMem (DigestList, sizeof(*DigestList));
 
-  for (Index = 0; Index < mHashInterfaceCount; Index++) {
-    HashMask = Tpm2GetHashMaskFromAlgo (&mHashInterface[Index].HashGuid);
-    if ((HashMask & PcdGet32 (PcdTpm2HashMask)) != 0) {
-      mHashInterface[Index].HashUpdate (HashCtx[Index], DataToHash, DataToHashLen);
-      mHashInterface[Index].HashFinal (HashCtx[Index], &Digest);
-      Tpm2SetHashToDigestList (DigestList, &Digest);
-    }
+  Status = HashUpdateAll (HashCtx, DataToHash, DataToHashLen);
+  HashCompleteAll (HashCtx, DigestList);
+  if (EFI_ERROR (Status)) {
+    ZeroMem (DigestList, sizeof(*DigestList));
+    return Status;
   }
 
-  FreePool (HashCtx);
+  //
+  // The caller collects the PCR extend with Tpm2PcrExtendComplete(). A PCR
+  // extend it has not collected yet is kept by the TPM2 device library.
+  //
+  if (mPcrExtendAsyncAllowed) {
+    Status = Tpm2PcrExtendAsync (PcrIndex, DigestList);
+    if (Status != EFI_UNSUPPORTED) {
+      return Status;
+    }
+    //
+    // The TPM2 device only supports synchronous commands.
+    //
+    mPcrExtendAsyncAllowed = FALSE;
+  }
 
   Status = Tpm2PcrExtend (
              PcrIndex,
@@ -207,7 +523,12 @@ HashAndExtend (
   CheckSupportedHashMaskMismatch ();
 
   HashStart (&HashHandle);
-  HashUpdate (HashHandle, DataToHash, DataToHashLen);
+  Status = HashUpdate (HashHandle, DataToHash, DataToHashLen);
+  if (EFI_ERROR (Status)) {
+    ZeroMem (DigestList, sizeof(*DigestList));
+    return Status;
+  }
+
   Status = HashCompleteAndExtend (HashHandle, PcrIndex, NULL, 0, DigestList);
 
   return Status;
@@ -283,7 +604,10 @@ HashLibBaseCryptoRouterDxeConstructor (
   IN EFI_SYSTEM_TABLE  *SystemTable
   )
 {
-  EFI_STATUS    Status;
+  EFI_STATUS                 Status;
+  EFI_LOADED_IMAGE_PROTOCOL  *LoadedImage;
+  EFI_SMM_BASE2_PROTOCOL     *SmmBase2;
+  BOOLEAN                    InSmm;
 
   //
   // Record hash algorithm bitmap of LAST module which also consumes HashLib.
@@ -296,5 +620,19 @@ HashLibBaseCryptoRouterDxeConstructor (
   Status = PcdSet32S (PcdTcg2HashAlgorithmBitmap, 0);
   ASSERT_EFI_ERROR (Status);
 
+  InSmm  = FALSE;
+  Status = gBS->LocateProtocol (&gEfiSmmBase2ProtocolGuid, NULL, (VOID **)&SmmBase2);
+  if (!EFI_ERROR (Status)) {
+    SmmBase2->InSmm (SmmBase2, &InSmm);
+  }
+
+  Status = gBS->HandleProtocol (ImageHandle, &gEfiLoadedImageProtocolGuid, (VOID **)&LoadedImage);
+  if (!EFI_ERROR (Status) && !InSmm && (LoadedImage->ImageCodeType != EfiRuntimeServicesCode)) {
+    mHashParallelAllowed = TRUE;
+
+    mPcrExtendAsyncAllowed = PcdGetBool (PcdTcg2PcrExtendAsync) &&
+                             (LoadedImage->ImageCodeType == EfiBootServicesCode);
+  }
+
   return EFI_SUCCESS;
 }
@@ -0,0 +1,29 @@
+/** @file
+  Enables the asynchronous PCR extend of Tpm2CommandLib.
+
+Copyright (c) 2026, agent. All rights reserved.<BR>
+SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <Uefi.h>
+#include <Library/Tpm2CommandLib.h>
+#include <Library/Tpm2DeviceAsyncLib.h>
+
+/**
+  Register the Tpm2DeviceAsyncLib services with Tpm2CommandLib.
+
+  @param  ImageHandle   The firmware allocated handle for the EFI image.
+  @param  SystemTable   A pointer to the EFI System Table.
+
+  @retval EFI_SUCCESS   The services are registered.
+**/
+EFI_STATUS
+EFIAPI
+Tpm2CommandAsyncLibConstructor (
+  IN EFI_HANDLE        ImageHandle,
+  IN EFI_SYSTEM_TABLE  *SystemTable
+  )
+{
+  return Tpm2RegisterAsyncCommandServices (Tpm2SubmitCommandAsync, Tpm2CompleteCommand);
+}
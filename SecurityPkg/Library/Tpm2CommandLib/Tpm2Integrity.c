@@ -76,49 +76,50 @@ typedef struct {
 
 #pragma pack()
 
+//
+// Asynchronous TPM2 device services, registered by Tpm2CommandAsyncLib.
+//
+TPM2_SUBMIT_COMMAND_ASYNC  mTpm2SubmitCommandAsync = NULL;
+TPM2_COMPLETE_COMMAND      mTpm2CompleteCommand    = NULL;
+
 /**
-  This command is used to cause an update to the indicated PCR.
-  The digests parameter contains one or more tagged digest value identified by an algorithm ID.
-  For each digest, the PCR associated with pcrHandle is Extended into the bank identified by the tag (hashAlg).
+  Marshal the TPM2_PCR_Extend command.
 
-  @param[in] PcrHandle   Handle of the PCR
-  @param[in] Digests     List of tagged digest values to be extended
+  @param[in]  PcrHandle   Handle of the PCR
+  @param[in]  Digests     List of tagged digest values to be extended
+  @param[out] Cmd         The command to fill in
+  @param[out] CmdSize     Size of the command
 
-  @retval EFI_SUCCESS      Operation completed successfully.
-  @retval EFI_DEVICE_ERROR Unexpected device behavior.
+  @retval EFI_SUCCESS      The command was built.
+  @retval EFI_DEVICE_ERROR A digest uses an unknown hash algorithm.
 **/
 EFI_STATUS
-EFIAPI
-Tpm2PcrExtend (
+Tpm2BuildPcrExtendCommand (
   IN      TPMI_DH_PCR               PcrHandle,
-  IN      TPML_DIGEST_VALUES        *Digests
+  IN      TPML_DIGEST_VALUES        *Digests,
+  OUT     TPM2_PCR_EXTEND_COMMAND   *Cmd,
+  OUT     UINT32                    *CmdSize
   )
 {
-  EFI_STATUS                        Status;
-  TPM2_PCR_EXTEND_COMMAND           Cmd;
-  TPM2_PCR_EXTEND_RESPONSE          Res;
-  UINT32                            CmdSize;
-  UINT32                            RespSize;
-  UINT32                            ResultBufSize;
   UINT8                             *Buffer;
   UINTN                             Index;
   UINT32                            SessionInfoSize;
   UINT16                            DigestSize;
 
-  Cmd.Header.tag         = SwapBytes16(TPM_ST_SESSIONS);
-  Cmd.Header.commandCode = SwapBytes32(TPM_CC_PCR_Extend);
-  Cmd.PcrHandle          = SwapBytes32(PcrHandle);
+  Cmd->Header.tag         = SwapBytes16(TPM_ST_SESSIONS);
+  Cmd->Header.commandCode = SwapBytes32(TPM_CC_PCR_Extend);
+  Cmd->PcrHandle          = SwapBytes32(PcrHandle);
 
 
   //
   // Add in Auth session
   //
-  Buffer = (UINT8 *)&Cmd.AuthSessionPcr;
+  Buffer = (UINT8 *)&Cmd->AuthSessionPcr;
 
   // sessionInfoSize
   SessionInfoSize = CopyAuthSessionCommand (NULL, Buffer);
   Buffer += SessionInfoSize;
-  Cmd.AuthorizationSize = SwapBytes32(SessionInfoSize);
+  Cmd->AuthorizationSize = SwapBytes32(SessionInfoSize);
 
   //Digest Count
   WriteUnaligned32 ((UINT32 *)Buffer, SwapBytes32(Digests->count));
@@ -141,16 +142,31 @@ Tpm2PcrExtend (
     Buffer += DigestSize;
   }
 
-  CmdSize              = (UINT32)((UINTN)Buffer - (UINTN)&Cmd);
-  Cmd.Header.paramSize = SwapBytes32(CmdSize);
+  *CmdSize              = (UINT32)((UINTN)Buffer - (UINTN)Cmd);
+  Cmd->Header.paramSize = SwapBytes32(*CmdSize);
 
-  ResultBufSize = sizeof(Res);
-  Status = Tpm2SubmitCommand (CmdSize, (UINT8 *)&Cmd, &ResultBufSize, (UINT8 *)&Res);
-  if (EFI_ERROR(Status)) {
-    return Status;
-  }
+  return EFI_SUCCESS;
+}
 
-  if (ResultBufSize > sizeof(Res)) {
+/**
+  Validate the response of the TPM2_PCR_Extend command.
+
+  @param[in] Res             The response
+  @param[in] ResultBufSize   Size of the response
+
+  @retval EFI_SUCCESS          The PCR was extended.
+  @retval EFI_BUFFER_TOO_SMALL The response is too large.
+  @retval EFI_DEVICE_ERROR     The TPM returned an error.
+**/
+EFI_STATUS
+Tpm2CheckPcrExtendResponse (
+  IN      TPM2_PCR_EXTEND_RESPONSE  *Res,
+  IN      UINT32                    ResultBufSize
+  )
+{
+  UINT32                            RespSize;
+
+  if (ResultBufSize > sizeof(*Res)) {
     DEBUG ((EFI_D_ERROR, "Tpm2PcrExtend: Failed ExecuteCommand: Buffer Too Small\r\n"));
     return EFI_BUFFER_TOO_SMALL;
   }
@@ -158,8 +174,8 @@ Tpm2PcrExtend (
   //
   // Validate response headers
   //
-  RespSize = SwapBytes32(Res.Header.paramSize);
-  if (RespSize > sizeof(Res)) {
+  RespSize = SwapBytes32(Res->Header.paramSize);
+  if (RespSize > sizeof(*Res)) {
     DEBUG ((EFI_D_ERROR, "Tpm2PcrExtend: Response size too large! %d\r\n", RespSize));
     return EFI_BUFFER_TOO_SMALL;
   }
@@ -167,8 +183,8 @@ Tpm2PcrExtend (
   //
   // Fail if command failed
   //
-  if (SwapBytes32(Res.Header.responseCode) != TPM_RC_SUCCESS) {
-    DEBUG ((EFI_D_ERROR, "Tpm2PcrExtend: Response Code error! 0x%08x\r\n", SwapBytes32(Res.Header.responseCode)));
+  if (SwapBytes32(Res->Header.responseCode) != TPM_RC_SUCCESS) {
+    DEBUG ((EFI_D_ERROR, "Tpm2PcrExtend: Response Code error! 0x%08x\r\n", SwapBytes32(Res->Header.responseCode)));
     return EFI_DEVICE_ERROR;
   }
 
@@ -181,6 +197,147 @@ Tpm2PcrExtend (
   return EFI_SUCCESS;
 }
 
+/**
+  This command is used to cause an update to the indicated PCR.
+  The digests parameter contains one or more tagged digest value identified by an algorithm ID.
+  For each digest, the PCR associated with pcrHandle is Extended into the bank identified by the tag (hashAlg).
+
+  @param[in] PcrHandle   Handle of the PCR
+  @param[in] Digests     List of tagged digest values to be extended
+
+  @retval EFI_SUCCESS      Operation completed successfully.
+  @retval EFI_DEVICE_ERROR Unexpected device behavior.
+**/
+EFI_STATUS
+EFIAPI
+Tpm2PcrExtend (
+  IN      TPMI_DH_PCR               PcrHandle,
+  IN      TPML_DIGEST_VALUES        *Digests
+  )
+{
+  EFI_STATUS                        Status;
+  TPM2_PCR_EXTEND_COMMAND           Cmd;
+  TPM2_PCR_EXTEND_RESPONSE          Res;
+  UINT32                            CmdSize;
+  UINT32                            ResultBufSize;
+
+  Status = Tpm2BuildPcrExtendCommand (PcrHandle, Digests, &Cmd, &CmdSize);
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
+
+  ResultBufSize = sizeof(Res);
+  Status = Tpm2SubmitCommand (CmdSize, (UINT8 *)&Cmd, &ResultBufSize, (UINT8 *)&Res);
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
+
+  return Tpm2CheckPcrExtendResponse (&Res, ResultBufSize);
+}
+
+/**
+  This command is used to cause an update to the indicated PCR, without waiting
+  for the TPM to complete it.
+
+  The TPM extends the PCR while the caller goes on with other work. The result
+  must be collected with Tpm2PcrExtendComplete(). If another TPM command is
+  sent in between, it waits for the PCR extend first and the result is kept
+  for Tpm2PcrExtendComplete().
+
+  This is only supported once the asynchronous TPM2 device services have been
+  registered with Tpm2RegisterAsyncCommandServices().
+
+  @param[in] PcrHandle   Handle of the PCR
+  @param[in] Digests     List of tagged digest values to be extended
+
+  @retval EFI_SUCCESS      The command was sent to the TPM.
+  @retval EFI_UNSUPPORTED  The TPM2 device only supports synchronous commands.
+                           Tpm2PcrExtend() must be used instead.
+  @retval EFI_ALREADY_STARTED The result of an earlier PCR extend has not been
+                           collected yet.
+  @retval EFI_DEVICE_ERROR Unexpected device behavior.
+**/
+EFI_STATUS
+EFIAPI
+Tpm2PcrExtendAsync (
+  IN      TPMI_DH_PCR               PcrHandle,
+  IN      TPML_DIGEST_VALUES        *Digests
+  )
+{
+  EFI_STATUS                        Status;
+  TPM2_PCR_EXTEND_COMMAND           Cmd;
+  UINT32                            CmdSize;
+
+  if (mTpm2SubmitCommandAsync == NULL) {
+    return EFI_UNSUPPORTED;
+  }
+
+  Status = Tpm2BuildPcrExtendCommand (PcrHandle, Digests, &Cmd, &CmdSize);
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
+
+  return mTpm2SubmitCommandAsync (CmdSize, (UINT8 *)&Cmd);
+}
+
+/**
+  Wait for the PCR extend sent by Tpm2PcrExtendAsync() to complete.
+
+  @retval EFI_SUCCESS      The PCR was extended.
+  @retval EFI_NOT_FOUND    No PCR extend is pending.
+  @retval EFI_DEVICE_ERROR Unexpected device behavior.
+**/
+EFI_STATUS
+EFIAPI
+Tpm2PcrExtendComplete (
+  VOID
+  )
+{
+  EFI_STATUS                        Status;
+  TPM2_PCR_EXTEND_RESPONSE          Res;
+  UINT32                            ResultBufSize;
+
+  if (mTpm2CompleteCommand == NULL) {
+    return EFI_NOT_FOUND;
+  }
+
+  ResultBufSize = sizeof(Res);
+  Status = mTpm2CompleteCommand (&ResultBufSize, (UINT8 *)&Res);
+  if (EFI_ERROR(Status)) {
+    return Status;
+  }
+
+  return Tpm2CheckPcrExtendResponse (&Res, ResultBufSize);
+}
+
+/**
+  Register the TPM2 device services used by Tpm2PcrExtendAsync() and
+  Tpm2PcrExtendComplete().
+
+  Tpm2CommandAsyncLib registers them when it is linked into a DXE driver.
+
+  @param[in] SubmitCommandAsync  Service sending a command without waiting for it.
+  @param[in] CompleteCommand     Service waiting for the command and returning its response.
+
+  @retval EFI_SUCCESS            The services are registered.
+  @retval EFI_INVALID_PARAMETER  SubmitCommandAsync or CompleteCommand is NULL.
+**/
+EFI_STATUS
+EFIAPI
+Tpm2RegisterAsyncCommandServices (
+  IN TPM2_SUBMIT_COMMAND_ASYNC  SubmitCommandAsync,
+  IN TPM2_COMPLETE_COMMAND      CompleteCommand
+  )
+{
+  if ((SubmitCommandAsync == NULL) || (CompleteCommand == NULL)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  mTpm2SubmitCommandAsync = SubmitCommandAsync;
+  mTpm2CompleteCommand    = CompleteCommand;
+  return EFI_SUCCESS;
+}
+
 /**
   This command is used to cause an update to the indicated PCR.
   The data in eventData is hashed using the hash algorithm associated with each bank in which the
@@ -11,6 +11,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Library/BaseMemoryLib.h>
 #include <Library/DebugLib.h>
 #include <Library/Tpm2DeviceLib.h>
+#include <Library/Tpm2DeviceAsyncLib.h>
 #include <Library/PcdLib.h>
 
 #include "Tpm2DeviceLibDTpm.h"
@@ -49,6 +50,43 @@ DTpm2RequestUseTpm (
   VOID
   );
 
+/**
+  This service sends a command to the TPM2 without waiting for its response.
+
+  A command still pending is completed first and its response is kept for
+  DTpm2CompleteCommand().
+
+  @param[in]      InputParameterBlockSize  Size of the TPM2 input parameter block.
+  @param[in]      InputParameterBlock      Pointer to the TPM2 input parameter block.
+
+  @retval EFI_SUCCESS            The command byte stream was successfully sent to the device.
+  @retval EFI_DEVICE_ERROR       The command was not successfully sent to the device.
+**/
+EFI_STATUS
+EFIAPI
+DTpm2SubmitCommandAsync (
+  IN UINT32            InputParameterBlockSize,
+  IN UINT8             *InputParameterBlock
+  );
+
+/**
+  This service waits for the pending TPM2 command to complete and returns its response.
+
+  @param[in,out]  OutputParameterBlockSize Size of the TPM2 output parameter block.
+  @param[in]      OutputParameterBlock     Pointer to the TPM2 output parameter block.
+
+  @retval EFI_SUCCESS            A response was successfully received.
+  @retval EFI_NOT_FOUND          No command is pending.
+  @retval EFI_DEVICE_ERROR       A response was not successfully received from the device.
+  @retval EFI_BUFFER_TOO_SMALL   The output parameter block is too small.
+**/
+EFI_STATUS
+EFIAPI
+DTpm2CompleteCommand (
+  IN OUT UINT32        *OutputParameterBlockSize,
+  IN UINT8             *OutputParameterBlock
+  );
+
 /**
   This service enables the sending of commands to the TPM2.
 
@@ -94,6 +132,65 @@ Tpm2RequestUseTpm (
   return DTpm2RequestUseTpm ();
 }
 
+/**
+  This service sends a command to the TPM2 without waiting for its response.
+
+  The TPM2 executes the command while the caller goes on with other work. The
+  response must be collected with Tpm2CompleteCommand(). If another command is
+  submitted first, the pending response is read and kept for
+  Tpm2CompleteCommand().
+
+  This service is not available in PEI, where the library has no writable data.
+
+  @param[in]      InputParameterBlockSize  Size of the TPM2 input parameter block.
+  @param[in]      InputParameterBlock      Pointer to the TPM2 input parameter block.
+
+  @retval EFI_SUCCESS            The command byte stream was successfully sent to the device.
+  @retval EFI_DEVICE_ERROR       The command was not successfully sent to the device.
+  @retval EFI_UNSUPPORTED        The TPM2 device does not support asynchronous commands.
+                                 The caller should use Tpm2SubmitCommand() instead.
+**/
+EFI_STATUS
+EFIAPI
+Tpm2SubmitCommandAsync (
+  IN UINT32            InputParameterBlockSize,
+  IN UINT8             *InputParameterBlock
+  )
+{
+  return DTpm2SubmitCommandAsync (
+           InputParameterBlockSize,
+           InputParameterBlock
+           );
+}
+
+/**
+  This service waits for the command sent by Tpm2SubmitCommandAsync() to
+  complete and returns its response.
+
+  If another command was submitted in between, the response it collected is
+  returned.
+
+  @param[in,out]  OutputParameterBlockSize Size of the TPM2 output parameter block.
+  @param[in]      OutputParameterBlock     Pointer to the TPM2 output parameter block.
+
+  @retval EFI_SUCCESS            A response was successfully received.
+  @retval EFI_NOT_FOUND          No command is pending.
+  @retval EFI_DEVICE_ERROR       A response was not successfully received from the device.
+  @retval EFI_BUFFER_TOO_SMALL   The output parameter block is too small.
+**/
+EFI_STATUS
+EFIAPI
+Tpm2CompleteCommand (
+  IN OUT UINT32        *OutputParameterBlockSize,
+  IN UINT8             *OutputParameterBlock
+  )
+{
+  return DTpm2CompleteCommand (
+           OutputParameterBlockSize,
+           OutputParameterBlock
+           );
+}
+
 /**
   This service register TPM2 device.
 
@@ -62,10 +62,52 @@ DTpm2RequestUseTpm (
   VOID
   );
 
+/**
+  This service sends a command to the TPM2 without waiting for its response.
+
+  A command still pending is completed first and its response is kept for
+  DTpm2CompleteCommand().
+
+  @param[in]      InputParameterBlockSize  Size of the TPM2 input parameter block.
+  @param[in]      InputParameterBlock      Pointer to the TPM2 input parameter block.
+
+  @retval EFI_SUCCESS            The command byte stream was successfully sent to the device.
+  @retval EFI_DEVICE_ERROR       The command was not successfully sent to the device.
+**/
+EFI_STATUS
+EFIAPI
+DTpm2SubmitCommandAsync (
+  IN UINT32            InputParameterBlockSize,
+  IN UINT8             *InputParameterBlock
+  );
+
+/**
+  This service waits for the pending TPM2 command to complete and returns its response.
+
+  If another command was submitted in between, the response it collected is
+  returned.
+
+  @param[in,out]  OutputParameterBlockSize Size of the TPM2 output parameter block.
+  @param[in]      OutputParameterBlock     Pointer to the TPM2 output parameter block.
+
+  @retval EFI_SUCCESS            A response was successfully received.
+  @retval EFI_NOT_FOUND          No command is pending.
+  @retval EFI_DEVICE_ERROR       A response was not successfully received from the device.
+  @retval EFI_BUFFER_TOO_SMALL   The output parameter block is too small.
+**/
+EFI_STATUS
+EFIAPI
+DTpm2CompleteCommand (
+  IN OUT UINT32        *OutputParameterBlockSize,
+  IN UINT8             *OutputParameterBlock
+  );
+
 TPM2_DEVICE_INTERFACE  mDTpm2InternalTpm2Device = {
   TPM_DEVICE_INTERFACE_TPM20_DTPM,
   DTpm2SubmitCommand,
   DTpm2RequestUseTpm,
+  DTpm2SubmitCommandAsync,
+  DTpm2CompleteCommand,
 };
 
 /**
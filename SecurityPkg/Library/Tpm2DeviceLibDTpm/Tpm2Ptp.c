@@ -33,6 +33,21 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 //
 #define TPMCMDBUFLENGTH             0x500
 
+//
+// Whether a command sent by DTpm2SubmitCommandAsync() awaits completion.
+// Only set by the asynchronous services, which are not used in PEI.
+//
+BOOLEAN  mDTpm2CommandPending = FALSE;
+
+//
+// Response of the asynchronous command, when another command had to collect it
+// before it was sent. It is kept until DTpm2CompleteCommand() returns it.
+//
+BOOLEAN     mDTpm2ResponseSaved = FALSE;
+EFI_STATUS  mDTpm2SavedStatus;
+UINT32      mDTpm2SavedResponseSize;
+UINT8       mDTpm2SavedResponse[TPMCMDBUFLENGTH];
+
 /**
   Check whether TPM PTP register exist.
 
@@ -122,34 +137,61 @@ PtpCrbRequestUseTpm (
 }
 
 /**
-  Send a command to TPM for execution and return response data.
+  Return the TPM to Idle state after a command failed or completed.
+
+  @param[in]      CrbReg        TPM register space base address.
+  @param[in]      Status        Status of the command.
+
+  @return The status of the command, or of the Idle state transition.
+
+**/
+EFI_STATUS
+PtpCrbTpmCommandGoIdle (
+  IN     PTP_CRB_REGISTERS_PTR      CrbReg,
+  IN     EFI_STATUS                 Status
+  )
+{
+  //
+  //  Return to Idle state by setting TPM_CRB_CTRL_STS_x.Status.goIdle to 1.
+  //
+  MmioWrite32((UINTN)&CrbReg->CrbControlRequest, PTP_CRB_CONTROL_AREA_REQUEST_GO_IDLE);
+
+  //
+  // Only enforce Idle state transition if execution fails when CRBIdleBypass==1
+  // Leave regular Idle delay at the beginning of next command execution
+  //
+  if (GetCachedIdleByPass () == 1){
+    Status = PtpCrbWaitRegisterBits (
+               &CrbReg->CrbControlStatus,
+               PTP_CRB_CONTROL_AREA_STATUS_TPM_IDLE,
+               0,
+               PTP_TIMEOUT_C
+               );
+  }
+
+  return Status;
+}
+
+/**
+  Send a command to TPM for execution, without waiting for it to complete.
 
   @param[in]      CrbReg        TPM register space base address.
   @param[in]      BufferIn      Buffer for command data.
   @param[in]      SizeIn        Size of command data.
-  @param[in, out] BufferOut     Buffer for response data.
-  @param[in, out] SizeOut       Size of response data.
 
-  @retval EFI_SUCCESS           Operation completed successfully.
-  @retval EFI_BUFFER_TOO_SMALL  Response data buffer is too small.
+  @retval EFI_SUCCESS           The TPM started executing the command.
   @retval EFI_DEVICE_ERROR      Unexpected device behavior.
-  @retval EFI_UNSUPPORTED       Unsupported TPM version
 
 **/
 EFI_STATUS
-PtpCrbTpmCommand (
+PtpCrbTpmCommandSend (
   IN     PTP_CRB_REGISTERS_PTR      CrbReg,
   IN     UINT8                      *BufferIn,
-  IN     UINT32                     SizeIn,
-  IN OUT UINT8                      *BufferOut,
-  IN OUT UINT32                     *SizeOut
+  IN     UINT32                     SizeIn
   )
 {
   EFI_STATUS                        Status;
   UINT32                            Index;
-  UINT32                            TpmOutSize;
-  UINT16                            Data16;
-  UINT32                            Data32;
 
   DEBUG_CODE (
     UINTN  DebugSize;
@@ -171,7 +213,6 @@ PtpCrbTpmCommand (
     }
     DEBUG ((EFI_D_VERBOSE, "\n"));
   );
-  TpmOutSize         = 0;
 
   //
   // STEP 0:
@@ -189,7 +230,7 @@ PtpCrbTpmCommand (
       // Try to goIdle to recover TPM
       //
       Status = EFI_DEVICE_ERROR;
-      goto GoIdle_Exit;
+      return PtpCrbTpmCommandGoIdle (CrbReg, Status);
     }
   }
 
@@ -208,7 +249,7 @@ PtpCrbTpmCommand (
              );
   if (EFI_ERROR (Status)) {
     Status = EFI_DEVICE_ERROR;
-    goto GoIdle_Exit;
+    return PtpCrbTpmCommandGoIdle (CrbReg, Status);
   }
   Status = PtpCrbWaitRegisterBits (
              &CrbReg->CrbControlStatus,
@@ -218,7 +259,7 @@ PtpCrbTpmCommand (
              );
   if (EFI_ERROR (Status)) {
     Status = EFI_DEVICE_ERROR;
-    goto GoIdle_Exit;
+    return PtpCrbTpmCommandGoIdle (CrbReg, Status);
   }
 
   //
@@ -243,6 +284,39 @@ PtpCrbTpmCommand (
   // clearing Start to 0.
   //
   MmioWrite32((UINTN)&CrbReg->CrbControlStart, PTP_CRB_CONTROL_START);
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Wait for the command sent by PtpCrbTpmCommandSend() to complete and return
+  its response data.
+
+  @param[in]      CrbReg        TPM register space base address.
+  @param[in, out] BufferOut     Buffer for response data.
+  @param[in, out] SizeOut       Size of response data.
+
+  @retval EFI_SUCCESS           Operation completed successfully.
+  @retval EFI_BUFFER_TOO_SMALL  Response data buffer is too small.
+  @retval EFI_DEVICE_ERROR      Unexpected device behavior.
+  @retval EFI_UNSUPPORTED       Unsupported TPM version
+
+**/
+EFI_STATUS
+PtpCrbTpmCommandReceive (
+  IN     PTP_CRB_REGISTERS_PTR      CrbReg,
+  IN OUT UINT8                      *BufferOut,
+  IN OUT UINT32                     *SizeOut
+  )
+{
+  EFI_STATUS                        Status;
+  UINT32                            Index;
+  UINT32                            TpmOutSize;
+  UINT16                            Data16;
+  UINT32                            Data32;
+
+  TpmOutSize = 0;
+
   Status = PtpCrbWaitRegisterBits (
              &CrbReg->CrbControlStart,
              0,
@@ -343,26 +417,41 @@ GoReady_Exit:
   // This function will try to wait 2 TIMEOUT_C at the beginning in next call.
   //
 GoIdle_Exit:
+  return PtpCrbTpmCommandGoIdle (CrbReg, Status);
+}
 
-  //
-  //  Return to Idle state by setting TPM_CRB_CTRL_STS_x.Status.goIdle to 1.
-  //
-  MmioWrite32((UINTN)&CrbReg->CrbControlRequest, PTP_CRB_CONTROL_AREA_REQUEST_GO_IDLE);
+/**
+  Send a command to TPM for execution and return response data.
 
-  //
-  // Only enforce Idle state transition if execution fails when CRBIdleBypass==1
-  // Leave regular Idle delay at the beginning of next command execution
-  //
-  if (GetCachedIdleByPass () == 1){
-    Status = PtpCrbWaitRegisterBits (
-               &CrbReg->CrbControlStatus,
-               PTP_CRB_CONTROL_AREA_STATUS_TPM_IDLE,
-               0,
-               PTP_TIMEOUT_C
-               );
+  @param[in]      CrbReg        TPM register space base address.
+  @param[in]      BufferIn      Buffer for command data.
+  @param[in]      SizeIn        Size of command data.
+  @param[in, out] BufferOut     Buffer for response data.
+  @param[in, out] SizeOut       Size of response data.
+
+  @retval EFI_SUCCESS           Operation completed successfully.
+  @retval EFI_BUFFER_TOO_SMALL  Response data buffer is too small.
+  @retval EFI_DEVICE_ERROR      Unexpected device behavior.
+  @retval EFI_UNSUPPORTED       Unsupported TPM version
+
+**/
+EFI_STATUS
+PtpCrbTpmCommand (
+  IN     PTP_CRB_REGISTERS_PTR      CrbReg,
+  IN     UINT8                      *BufferIn,
+  IN     UINT32                     SizeIn,
+  IN OUT UINT8                      *BufferOut,
+  IN OUT UINT32                     *SizeOut
+  )
+{
+  EFI_STATUS                        Status;
+
+  Status = PtpCrbTpmCommandSend (CrbReg, BufferIn, SizeIn);
+  if (EFI_ERROR (Status)) {
+    return Status;
   }
 
-  return Status;
+  return PtpCrbTpmCommandReceive (CrbReg, BufferOut, SizeOut);
 }
 
 /**
@@ -389,6 +478,46 @@ Tpm2TisTpmCommand (
   IN OUT UINT32                     *SizeOut
   );
 
+/**
+  Send a command to TPM for execution, without waiting for it to complete.
+
+  @param[in]      TisReg        TPM register space base address.
+  @param[in]      BufferIn      Buffer for command data.
+  @param[in]      SizeIn        Size of command data.
+
+  @retval EFI_SUCCESS           The TPM started executing the command.
+  @retval EFI_BUFFER_TOO_SMALL  The TPM expects more command data.
+  @retval EFI_DEVICE_ERROR      Unexpected device behavior.
+
+**/
+EFI_STATUS
+Tpm2TisTpmCommandSend (
+  IN     TIS_PC_REGISTERS_PTR       TisReg,
+  IN     UINT8                      *BufferIn,
+  IN     UINT32                     SizeIn
+  );
+
+/**
+  Wait for the command sent by Tpm2TisTpmCommandSend() to complete and return
+  its response data.
+
+  @param[in]      TisReg        TPM register space base address.
+  @param[in, out] BufferOut     Buffer for response data.
+  @param[in, out] SizeOut       Size of response data.
+
+  @retval EFI_SUCCESS           Operation completed successfully.
+  @retval EFI_BUFFER_TOO_SMALL  Response data buffer is too small.
+  @retval EFI_DEVICE_ERROR      Unexpected device behavior.
+  @retval EFI_UNSUPPORTED       Unsupported TPM version
+
+**/
+EFI_STATUS
+Tpm2TisTpmCommandReceive (
+  IN     TIS_PC_REGISTERS_PTR       TisReg,
+  IN OUT UINT8                      *BufferOut,
+  IN OUT UINT32                     *SizeOut
+  );
+
 /**
   Get the control of TPM chip by sending requestUse command TIS_PC_ACC_RQUUSE
   to ACCESS Register in the time of default TIS_TIMEOUT_A.
@@ -544,6 +673,150 @@ DumpPtpInfo (
   DEBUG ((EFI_D_INFO, "RID - 0x%02x\n", Rid));
 }
 
+/**
+  This service waits for the pending TPM2 command to complete and returns its response.
+
+  @param[in,out]  OutputParameterBlockSize Size of the TPM2 output parameter block.
+  @param[in]      OutputParameterBlock     Pointer to the TPM2 output parameter block.
+
+  If another command was submitted in between, the response it collected is
+  returned.
+
+  @retval EFI_SUCCESS            A response was successfully received.
+  @retval EFI_NOT_FOUND          No command is pending.
+  @retval EFI_DEVICE_ERROR       A response was not successfully received from the device.
+  @retval EFI_BUFFER_TOO_SMALL   The output parameter block is too small.
+**/
+EFI_STATUS
+EFIAPI
+DTpm2CompleteCommand (
+  IN OUT UINT32        *OutputParameterBlockSize,
+  IN UINT8             *OutputParameterBlock
+  )
+{
+  if (mDTpm2ResponseSaved) {
+    mDTpm2ResponseSaved = FALSE;
+    if (EFI_ERROR (mDTpm2SavedStatus)) {
+      return mDTpm2SavedStatus;
+    }
+    if (*OutputParameterBlockSize < mDTpm2SavedResponseSize) {
+      return EFI_BUFFER_TOO_SMALL;
+    }
+    CopyMem (OutputParameterBlock, mDTpm2SavedResponse, mDTpm2SavedResponseSize);
+    *OutputParameterBlockSize = mDTpm2SavedResponseSize;
+    return EFI_SUCCESS;
+  }
+
+  if (!mDTpm2CommandPending) {
+    return EFI_NOT_FOUND;
+  }
+  mDTpm2CommandPending = FALSE;
+
+  switch (GetCachedPtpInterface ()) {
+  case Tpm2PtpInterfaceCrb:
+    return PtpCrbTpmCommandReceive (
+             (PTP_CRB_REGISTERS_PTR) (UINTN) PcdGet64 (PcdTpmBaseAddress),
+             OutputParameterBlock,
+             OutputParameterBlockSize
+             );
+  case Tpm2PtpInterfaceFifo:
+  case Tpm2PtpInterfaceTis:
+    return Tpm2TisTpmCommandReceive (
+             (TIS_PC_REGISTERS_PTR) (UINTN) PcdGet64 (PcdTpmBaseAddress),
+             OutputParameterBlock,
+             OutputParameterBlockSize
+             );
+  default:
+    return EFI_NOT_FOUND;
+  }
+}
+
+/**
+  Wait for the pending TPM2 command to complete and keep its response for
+  DTpm2CompleteCommand(), so that the TPM2 is ready for another command.
+
+  @retval EFI_SUCCESS          The response is kept for DTpm2CompleteCommand().
+  @retval EFI_ALREADY_STARTED  The response of an earlier command is still kept.
+                               The pending command is left pending.
+**/
+EFI_STATUS
+DTpm2CollectPendingCommand (
+  VOID
+  )
+{
+  //
+  // Only one response is kept. The TPM2 cannot accept another command before
+  // the caller collects it.
+  //
+  if (mDTpm2ResponseSaved) {
+    DEBUG ((DEBUG_ERROR, "DTpm2CollectPendingCommand - Earlier response not collected\n"));
+    return EFI_ALREADY_STARTED;
+  }
+
+  mDTpm2SavedResponseSize = sizeof (mDTpm2SavedResponse);
+  mDTpm2SavedStatus       = DTpm2CompleteCommand (&mDTpm2SavedResponseSize, mDTpm2SavedResponse);
+  mDTpm2ResponseSaved     = TRUE;
+  return EFI_SUCCESS;
+}
+
+/**
+  This service sends a command to the TPM2 without waiting for its response.
+
+  A command still pending is completed first and its response is kept for
+  DTpm2CompleteCommand().
+
+  @param[in]      InputParameterBlockSize  Size of the TPM2 input parameter block.
+  @param[in]      InputParameterBlock      Pointer to the TPM2 input parameter block.
+
+  @retval EFI_SUCCESS            The command byte stream was successfully sent to the device.
+  @retval EFI_DEVICE_ERROR       The command was not successfully sent to the device.
+  @retval EFI_ALREADY_STARTED    A command is pending and the response of an
+                                 earlier one has not been collected yet.
+**/
+EFI_STATUS
+EFIAPI
+DTpm2SubmitCommandAsync (
+  IN UINT32            InputParameterBlockSize,
+  IN UINT8             *InputParameterBlock
+  )
+{
+  EFI_STATUS  Status;
+
+  if (mDTpm2CommandPending) {
+    Status = DTpm2CollectPendingCommand ();
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+  }
+
+  switch (GetCachedPtpInterface ()) {
+  case Tpm2PtpInterfaceCrb:
+    Status = PtpCrbTpmCommandSend (
+               (PTP_CRB_REGISTERS_PTR) (UINTN) PcdGet64 (PcdTpmBaseAddress),
+               InputParameterBlock,
+               InputParameterBlockSize
+               );
+    break;
+  case Tpm2PtpInterfaceFifo:
+  case Tpm2PtpInterfaceTis:
+    Status = Tpm2TisTpmCommandSend (
+               (TIS_PC_REGISTERS_PTR) (UINTN) PcdGet64 (PcdTpmBaseAddress),
+               InputParameterBlock,
+               InputParameterBlockSize
+               );
+    break;
+  default:
+    return EFI_NOT_FOUND;
+  }
+
+  if (EFI_ERROR (Status)) {
+    return EFI_DEVICE_ERROR;
+  }
+
+  mDTpm2CommandPending = TRUE;
+  return EFI_SUCCESS;
+}
+
 /**
   This service enables the sending of commands to the TPM2.
 
@@ -555,6 +828,9 @@ DumpPtpInfo (
   @retval EFI_SUCCESS            The command byte stream was successfully sent to the device and a response was successfully received.
   @retval EFI_DEVICE_ERROR       The command was not successfully sent to the device or a response was not successfully received from the device.
   @retval EFI_BUFFER_TOO_SMALL   The output parameter block is too small.
+  @retval EFI_ALREADY_STARTED    An asynchronous command is pending and the
+                                 response of an earlier one has not been
+                                 collected yet.
 **/
 EFI_STATUS
 EFIAPI
@@ -566,6 +842,14 @@ DTpm2SubmitCommand (
   )
 {
   TPM2_PTP_INTERFACE_TYPE  PtpInterface;
+  EFI_STATUS               Status;
+
+  if (mDTpm2CommandPending) {
+    Status = DTpm2CollectPendingCommand ();
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+  }
 
   PtpInterface = GetCachedPtpInterface ();
   switch (PtpInterface) {
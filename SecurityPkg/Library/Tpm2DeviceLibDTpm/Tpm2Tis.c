@@ -188,35 +188,27 @@ TisPcRequestUseTpm (
 }
 
 /**
-  Send a command to TPM for execution and return response data.
+  Send a command to TPM for execution, without waiting for it to complete.
 
   @param[in]      TisReg        TPM register space base address.
   @param[in]      BufferIn      Buffer for command data.
   @param[in]      SizeIn        Size of command data.
-  @param[in, out] BufferOut     Buffer for response data.
-  @param[in, out] SizeOut       Size of response data.
 
-  @retval EFI_SUCCESS           Operation completed successfully.
-  @retval EFI_BUFFER_TOO_SMALL  Response data buffer is too small.
+  @retval EFI_SUCCESS           The TPM started executing the command.
+  @retval EFI_BUFFER_TOO_SMALL  The TPM expects more command data.
   @retval EFI_DEVICE_ERROR      Unexpected device behavior.
-  @retval EFI_UNSUPPORTED       Unsupported TPM version
 
 **/
 EFI_STATUS
-Tpm2TisTpmCommand (
+Tpm2TisTpmCommandSend (
   IN     TIS_PC_REGISTERS_PTR       TisReg,
   IN     UINT8                      *BufferIn,
-  IN     UINT32                     SizeIn,
-  IN OUT UINT8                      *BufferOut,
-  IN OUT UINT32                     *SizeOut
+  IN     UINT32                     SizeIn
   )
 {
   EFI_STATUS                        Status;
   UINT16                            BurstCount;
   UINT32                            Index;
-  UINT32                            TpmOutSize;
-  UINT16                            Data16;
-  UINT32                            Data32;
 
   DEBUG_CODE (
     UINTN  DebugSize;
@@ -238,7 +230,6 @@ Tpm2TisTpmCommand (
     }
     DEBUG ((EFI_D_VERBOSE, "\n"));
   );
-  TpmOutSize = 0;
 
   Status = TisPcPrepareCommand (TisReg);
   if (EFI_ERROR (Status)){
@@ -278,6 +269,42 @@ Tpm2TisTpmCommand (
   // Executed the TPM command and waiting for the response data ready
   //
   MmioWrite8((UINTN)&TisReg->Status, TIS_PC_STS_GO);
+  return EFI_SUCCESS;
+
+Exit:
+  MmioWrite8((UINTN)&TisReg->Status, TIS_PC_STS_READY);
+  return Status;
+}
+
+/**
+  Wait for the command sent by Tpm2TisTpmCommandSend() to complete and return
+  its response data.
+
+  @param[in]      TisReg        TPM register space base address.
+  @param[in, out] BufferOut     Buffer for response data.
+  @param[in, out] SizeOut       Size of response data.
+
+  @retval EFI_SUCCESS           Operation completed successfully.
+  @retval EFI_BUFFER_TOO_SMALL  Response data buffer is too small.
+  @retval EFI_DEVICE_ERROR      Unexpected device behavior.
+  @retval EFI_UNSUPPORTED       Unsupported TPM version
+
+**/
+EFI_STATUS
+Tpm2TisTpmCommandReceive (
+  IN     TIS_PC_REGISTERS_PTR       TisReg,
+  IN OUT UINT8                      *BufferOut,
+  IN OUT UINT32                     *SizeOut
+  )
+{
+  EFI_STATUS                        Status;
+  UINT16                            BurstCount;
+  UINT32                            Index;
+  UINT32                            TpmOutSize;
+  UINT16                            Data16;
+  UINT32                            Data32;
+
+  TpmOutSize = 0;
 
   //
   // NOTE: That may take many seconds to minutes for certain commands, such as key generation.
@@ -387,6 +414,40 @@ Exit:
   return Status;
 }
 
+/**
+  Send a command to TPM for execution and return response data.
+
+  @param[in]      TisReg        TPM register space base address.
+  @param[in]      BufferIn      Buffer for command data.
+  @param[in]      SizeIn        Size of command data.
+  @param[in, out] BufferOut     Buffer for response data.
+  @param[in, out] SizeOut       Size of response data.
+
+  @retval EFI_SUCCESS           Operation completed successfully.
+  @retval EFI_BUFFER_TOO_SMALL  Response data buffer is too small.
+  @retval EFI_DEVICE_ERROR      Unexpected device behavior.
+  @retval EFI_UNSUPPORTED       Unsupported TPM version
+
+**/
+EFI_STATUS
+Tpm2TisTpmCommand (
+  IN     TIS_PC_REGISTERS_PTR       TisReg,
+  IN     UINT8                      *BufferIn,
+  IN     UINT32                     SizeIn,
+  IN OUT UINT8                      *BufferOut,
+  IN OUT UINT32                     *SizeOut
+  )
+{
+  EFI_STATUS                        Status;
+
+  Status = Tpm2TisTpmCommandSend (TisReg, BufferIn, SizeIn);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  return Tpm2TisTpmCommandReceive (TisReg, BufferOut, SizeOut);
+}
+
 /**
   This service enables the sending of commands to the TPM2.
 
@@ -13,6 +13,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Library/DebugLib.h>
 #include <Library/PcdLib.h>
 #include <Library/Tpm2DeviceLib.h>
+#include <Library/Tpm2DeviceAsyncLib.h>
 
 TPM2_DEVICE_INTERFACE  mInternalTpm2DeviceInterface;
 
@@ -67,6 +68,69 @@ Tpm2RequestUseTpm (
   return mInternalTpm2DeviceInterface.Tpm2RequestUseTpm ();
 }
 
+/**
+  This service sends a command to the TPM2 without waiting for its response.
+
+  The TPM2 executes the command while the caller goes on with other work. The
+  response must be collected with Tpm2CompleteCommand(). If another command is
+  submitted first, the pending response is read and kept for
+  Tpm2CompleteCommand().
+
+  @param[in]      InputParameterBlockSize  Size of the TPM2 input parameter block.
+  @param[in]      InputParameterBlock      Pointer to the TPM2 input parameter block.
+
+  @retval EFI_SUCCESS            The command byte stream was successfully sent to the device.
+  @retval EFI_DEVICE_ERROR       The command was not successfully sent to the device.
+  @retval EFI_UNSUPPORTED        The TPM2 device does not support asynchronous commands.
+                                 The caller should use Tpm2SubmitCommand() instead.
+**/
+EFI_STATUS
+EFIAPI
+Tpm2SubmitCommandAsync (
+  IN UINT32            InputParameterBlockSize,
+  IN UINT8             *InputParameterBlock
+  )
+{
+  if (mInternalTpm2DeviceInterface.Tpm2SubmitCommandAsync == NULL) {
+    return EFI_UNSUPPORTED;
+  }
+  return mInternalTpm2DeviceInterface.Tpm2SubmitCommandAsync (
+                                        InputParameterBlockSize,
+                                        InputParameterBlock
+                                        );
+}
+
+/**
+  This service waits for the command sent by Tpm2SubmitCommandAsync() to
+  complete and returns its response.
+
+  If another command was submitted in between, the response it collected is
+  returned.
+
+  @param[in,out]  OutputParameterBlockSize Size of the TPM2 output parameter block.
+  @param[in]      OutputParameterBlock     Pointer to the TPM2 output parameter block.
+
+  @retval EFI_SUCCESS            A response was successfully received.
+  @retval EFI_NOT_FOUND          No command is pending.
+  @retval EFI_DEVICE_ERROR       A response was not successfully received from the device.
+  @retval EFI_BUFFER_TOO_SMALL   The output parameter block is too small.
+**/
+EFI_STATUS
+EFIAPI
+Tpm2CompleteCommand (
+  IN OUT UINT32        *OutputParameterBlockSize,
+  IN UINT8             *OutputParameterBlock
+  )
+{
+  if (mInternalTpm2DeviceInterface.Tpm2CompleteCommand == NULL) {
+    return EFI_NOT_FOUND;
+  }
+  return mInternalTpm2DeviceInterface.Tpm2CompleteCommand (
+                                        OutputParameterBlockSize,
+                                        OutputParameterBlock
+                                        );
+}
+
 /**
   This service register TPM2 device.
 
@@ -115,6 +115,38 @@ VARIABLE_TYPE  mVariableType[] = {
 
 EFI_HANDLE mImageHandle;
 
+//
+// Event whose PCR extend HashLib left running in the TPM. It is logged once
+// Tpm2PcrExtendComplete() reports that the extend succeeded.
+//
+typedef struct {
+  BOOLEAN             Pending;
+  UINT64              Flags;
+  TPML_DIGEST_VALUES  DigestList;
+  TCG_PCR_EVENT_HDR   EventHdr;
+  UINT8               *EventData;
+} TCG_PENDING_EVENT;
+
+TCG_PENDING_EVENT  mPendingEvent;
+
+//
+// PCR extends are only left running while the driver measures several of its
+// own events in a row, between TcgDxeStartEventBatch() and TcgDxeEndEventBatch().
+//
+BOOLEAN            mDeferPcrExtendComplete = FALSE;
+
+/**
+  Wait for the PCR extend of the pending event and log the event if it succeeded.
+
+  @retval EFI_SUCCESS      No event is pending, or its PCR extend succeeded.
+  @retval EFI_DEVICE_ERROR The PCR extend failed. The TPM is disabled.
+  @retval other error value
+**/
+EFI_STATUS
+TcgDxeLogPendingEvent (
+  VOID
+  );
+
 /**
   Measure PE image into TPM log based on the authenticode image hashing in
   PE/COFF Specification 8.0 Appendix A.
@@ -724,6 +756,11 @@ Tcg2GetEventLog (
     return EFI_INVALID_PARAMETER;
   }
 
+  //
+  // The caller expects all the events measured so far in the log.
+  //
+  TcgDxeLogPendingEvent ();
+
   if (!mTcgDxeData.BsCap.TPMPresentFlag) {
     if (EventLogLocation != NULL) {
       *EventLogLocation = 0;
@@ -1164,6 +1201,174 @@ TcgDxeLogHashEvent (
   return RetStatus;
 }
 
+/**
+  Wait for the PCR extend of the pending event and log the event if it succeeded.
+
+  A failed PCR extend is handled like a failed synchronous one: the TPM is
+  disabled.
+
+  @retval EFI_SUCCESS      No event is pending, or its PCR extend succeeded.
+  @retval EFI_DEVICE_ERROR The PCR extend failed. The TPM is disabled.
+  @retval other error value
+**/
+EFI_STATUS
+TcgDxeLogPendingEvent (
+  VOID
+  )
+{
+  EFI_STATUS  Status;
+  EFI_STATUS  LogStatus;
+
+  if (!mPendingEvent.Pending) {
+    return EFI_SUCCESS;
+  }
+  mPendingEvent.Pending = FALSE;
+
+  LogStatus = EFI_SUCCESS;
+
+  Status = Tpm2PcrExtendComplete ();
+  if (Status == EFI_NOT_FOUND) {
+    //
+    // HashLib extended the PCR synchronously because the TPM2 device library
+    // does not support asynchronous commands. The extend has succeeded.
+    //
+    Status = EFI_SUCCESS;
+  }
+
+  if (!EFI_ERROR (Status) && ((mPendingEvent.Flags & EFI_TCG2_EXTEND_ONLY) == 0)) {
+    LogStatus = TcgDxeLogHashEvent (&mPendingEvent.DigestList, &mPendingEvent.EventHdr, mPendingEvent.EventData);
+    if (EFI_ERROR (LogStatus)) {
+      DEBUG ((EFI_D_ERROR, "TcgDxeLogPendingEvent - Event not logged - %r\n", LogStatus));
+    }
+  }
+
+  FreePool (mPendingEvent.EventData);
+  mPendingEvent.EventData = NULL;
+
+  if (Status == EFI_DEVICE_ERROR) {
+    DEBUG ((EFI_D_ERROR, "TcgDxeLogPendingEvent - %r. Disable TPM.\n", Status));
+    mTcgDxeData.BsCap.TPMPresentFlag = FALSE;
+    REPORT_STATUS_CODE (
+      EFI_ERROR_CODE | EFI_ERROR_MINOR,
+      (PcdGet32 (PcdStatusCodeSubClassTpmDevice) | EFI_P_EC_INTERFACE_ERROR)
+      );
+  }
+
+  if (!EFI_ERROR (Status)) {
+    Status = LogStatus;
+  }
+
+  return Status;
+}
+
+/**
+  Start measuring several events of the driver in a row.
+
+  When PcdTcg2PcrExtendAsync is set, the PCR extend of each event is then left
+  running in the TPM while the next event is hashed. Only the notification
+  functions of the driver do this. The measurement services they call must not
+  be visible to another module before TcgDxeEndEventBatch() is called.
+**/
+VOID
+TcgDxeStartEventBatch (
+  VOID
+  )
+{
+  mDeferPcrExtendComplete = PcdGetBool (PcdTcg2PcrExtendAsync);
+}
+
+/**
+  Wait for the PCR extend of the last event measured since TcgDxeStartEventBatch()
+  and log it.
+
+  @retval EFI_SUCCESS      No event is pending, or it has been extended and logged.
+  @retval EFI_DEVICE_ERROR The PCR extend failed. The TPM is disabled.
+  @retval other error value
+**/
+EFI_STATUS
+TcgDxeEndEventBatch (
+  VOID
+  )
+{
+  mDeferPcrExtendComplete = FALSE;
+  return TcgDxeLogPendingEvent ();
+}
+
+/**
+  Log an event after HashLib extended a PCR with its digests.
+
+  Between TcgDxeStartEventBatch() and TcgDxeEndEventBatch(), the PCR extend may
+  still be running in the TPM. The event is then kept pending and logged by the
+  next call, or by TcgDxeLogPendingEvent(), once the extend succeeded. The event
+  of the previous call is logged first, so that the events are logged in order.
+  Otherwise the extend is completed and the event is logged before returning.
+
+  @param[in]  Flags         Bitmap providing additional information.
+  @param[in]  ExtendStatus  Status returned by HashLib.
+  @param[in]  DigestList    Digests extended into the PCR.
+  @param[in]  NewEventHdr   Pointer to a TCG_PCR_EVENT_HDR data structure.
+  @param[in]  NewEventData  Pointer to the new event data.
+
+  @retval EFI_SUCCESS           Operation completed successfully.
+  @retval EFI_OUT_OF_RESOURCES  No enough memory to log the new event.
+  @retval EFI_DEVICE_ERROR      The command was unsuccessful.
+**/
+EFI_STATUS
+TcgDxeLogExtendedEvent (
+  IN      UINT64                    Flags,
+  IN      EFI_STATUS                ExtendStatus,
+  IN      TPML_DIGEST_VALUES        *DigestList,
+  IN      TCG_PCR_EVENT_HDR         *NewEventHdr,
+  IN      UINT8                     *NewEventData
+  )
+{
+  EFI_STATUS  Status;
+
+  TcgDxeLogPendingEvent ();
+  if (!mTcgDxeData.BsCap.TPMPresentFlag) {
+    //
+    // The previous PCR extend failed and the TPM was disabled. Leave the TPM
+    // idle, this event is not logged either.
+    //
+    if (!EFI_ERROR (ExtendStatus)) {
+      Tpm2PcrExtendComplete ();
+    }
+    return EFI_DEVICE_ERROR;
+  }
+
+  if (EFI_ERROR (ExtendStatus)) {
+    return ExtendStatus;
+  }
+
+  if (mDeferPcrExtendComplete) {
+    mPendingEvent.EventData = AllocateCopyPool (NewEventHdr->EventSize, NewEventData);
+    if (mPendingEvent.EventData != NULL) {
+      mPendingEvent.Flags = Flags;
+      CopyMem (&mPendingEvent.DigestList, DigestList, sizeof (mPendingEvent.DigestList));
+      CopyMem (&mPendingEvent.EventHdr, NewEventHdr, sizeof (mPendingEvent.EventHdr));
+      mPendingEvent.Pending = TRUE;
+      return EFI_SUCCESS;
+    }
+  }
+
+  Status = Tpm2PcrExtendComplete ();
+  if (Status == EFI_NOT_FOUND) {
+    //
+    // HashLib extended the PCR synchronously.
+    //
+    Status = EFI_SUCCESS;
+  }
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  if ((Flags & EFI_TCG2_EXTEND_ONLY) == 0) {
+    Status = TcgDxeLogHashEvent (DigestList, NewEventHdr, NewEventData);
+  }
+
+  return Status;
+}
+
 /**
   Do a hash operation on a data buffer, extend a specific TPM PCR with the hash result,
   and add an entry to the Event Log.
@@ -1199,9 +1404,14 @@ TcgDxeHashLogExtendEvent (
 
   if (NewEventHdr->EventType == EV_NO_ACTION) {
     //
-    // Do not do TPM extend for EV_NO_ACTION
+    // Do not do TPM extend for EV_NO_ACTION, but log the pending event first so
+    // that the events are logged in order.
     //
-    Status = EFI_SUCCESS;
+    Status = TcgDxeLogPendingEvent ();
+    if (EFI_ERROR (Status)) {
+      return Status;
+    }
+
     InitNoActionEvent (&NoActionEvent, NewEventHdr->EventSize);
     if ((Flags & EFI_TCG2_EXTEND_ONLY) == 0) {
       Status = TcgDxeLogHashEvent (&(NoActionEvent.Digests), NewEventHdr, NewEventData);
@@ -1216,13 +1426,9 @@ TcgDxeHashLogExtendEvent (
              (UINTN)HashDataLen,
              &DigestList
              );
-  if (!EFI_ERROR (Status)) {
-    if ((Flags & EFI_TCG2_EXTEND_ONLY) == 0) {
-      Status = TcgDxeLogHashEvent (&DigestList, NewEventHdr, NewEventData);
-    }
-  }
+  Status = TcgDxeLogExtendedEvent (Flags, Status, &DigestList, NewEventHdr, NewEventData);
 
-  if (Status == EFI_DEVICE_ERROR) {
+  if ((Status == EFI_DEVICE_ERROR) && mTcgDxeData.BsCap.TPMPresentFlag) {
     DEBUG ((EFI_D_ERROR, "TcgDxeHashLogExtendEvent - %r. Disable TPM.\n", Status));
     mTcgDxeData.BsCap.TPMPresentFlag = FALSE;
     REPORT_STATUS_CODE (
@@ -1301,12 +1507,8 @@ Tcg2HashLogExtendEvent (
                (UINTN)DataToHashLen,
                &DigestList
                );
-    if (!EFI_ERROR (Status)) {
-      if ((Flags & EFI_TCG2_EXTEND_ONLY) == 0) {
-        Status = TcgDxeLogHashEvent (&DigestList, &NewEventHdr, Event->Event);
-      }
-    }
-    if (Status == EFI_DEVICE_ERROR) {
+    Status = TcgDxeLogExtendedEvent (Flags, Status, &DigestList, &NewEventHdr, Event->Event);
+    if ((Status == EFI_DEVICE_ERROR) && mTcgDxeData.BsCap.TPMPresentFlag) {
       DEBUG ((EFI_D_ERROR, "MeasurePeImageAndExtend - %r. Disable TPM.\n", Status));
       mTcgDxeData.BsCap.TPMPresentFlag = FALSE;
       REPORT_STATUS_CODE (
@@ -1323,6 +1525,15 @@ Tcg2HashLogExtendEvent (
                Event->Event
                );
   }
+
+  //
+  // The caller relies on the event being extended and logged on return, even
+  // when it interrupted a batch of events of this driver.
+  //
+  if (!EFI_ERROR (Status)) {
+    Status = TcgDxeLogPendingEvent ();
+  }
+
   DEBUG ((DEBUG_VERBOSE, "Tcg2HashLogExtendEvent - %r\n", Status));
   return Status;
 }
@@ -2338,6 +2549,8 @@ MeasureSecureBootPolicy (
     DEBUG ((EFI_D_INFO, "MeasureLaunchOfFirmwareDebugger - %r\n", Status));
   }
 
+  TcgDxeStartEventBatch ();
+
   Status = MeasureAllSecureVariables ();
   DEBUG ((EFI_D_INFO, "MeasureAllSecureVariables - %r\n", Status));
 
@@ -2349,6 +2562,11 @@ MeasureSecureBootPolicy (
   //
   Status = MeasureSeparatorEvent (7);
   DEBUG ((EFI_D_INFO, "MeasureSeparatorEvent - %r\n", Status));
+
+  Status = TcgDxeEndEventBatch ();
+  if (EFI_ERROR (Status)) {
+    DEBUG ((EFI_D_ERROR, "Last event not measured - %r\n", Status));
+  }
   return ;
 }
 
@@ -2374,6 +2592,8 @@ OnReadyToBoot (
   PERF_START_EX (mImageHandle, "EventRec", "Tcg2Dxe", 0, PERF_ID_TCG2_DXE);
   if (mBootAttempts == 0) {
 
+    TcgDxeStartEventBatch ();
+
     //
     // Measure handoff tables.
     //
@@ -2412,6 +2632,11 @@ OnReadyToBoot (
       }
     }
 
+    Status = TcgDxeEndEventBatch ();
+    if (EFI_ERROR (Status)) {
+      DEBUG ((DEBUG_ERROR, "Last event not measured - %r\n", Status));
+    }
+
     //
     // 3. Measure GPT. It would be done in SAP driver.
     //
@@ -0,0 +1,254 @@
+/** @file
+  EDKII_PEI_MEMORY_FILL_PPI Implementation code.
+
+  Each range is split in page aligned slices, one per processor filling it. The
+  processors fill their slices with SetMem() or ZeroMem(), the BaseMemoryLib
+  instance of the platform decides the instructions used, e.g. the string
+  instructions of BaseMemoryLibRepStr or the non-temporal stores of
+  BaseMemoryLibSse2.
+
+  Copyright (c) 2026, agent. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include "CpuMpPei.h"
+
+typedef struct {
+  //
+  // Package of the processor, from its location.
+  //
+  UINT32                                Package;
+  //
+  // Index of the processor among the enabled processors of its package.
+  //
+  UINT32                                PackageIndex;
+  //
+  // Number of enabled processors in the package of the processor.
+  //
+  UINT32                                PackageCount;
+  //
+  // Index of the processor among all the enabled processors.
+  //
+  UINT32                                Index;
+} CPU_MEMORY_FILL_PROCESSOR;
+
+typedef struct {
+  EDKII_PEI_MEMORY_FILL_RANGE           *Ranges;
+  UINTN                                 RangeCount;
+  UINT8                                 Value;
+  //
+  // Number of enabled processors.
+  //
+  UINT32                                EnabledCount;
+  //
+  // Pointer to the buffer with one entry per processor.
+  //
+  CPU_MEMORY_FILL_PROCESSOR             *Processors;
+} CPU_MEMORY_FILL_CONTEXT;
+
+/**
+  Fill the slices of the ranges assigned to the calling processor.
+
+  @param[in] Buffer               Pointer to CPU_MEMORY_FILL_CONTEXT.
+
+**/
+VOID
+EFIAPI
+FillMemorySlices (
+  IN VOID                         *Buffer
+  )
+{
+  CPU_MEMORY_FILL_CONTEXT         *Context;
+  CPU_MEMORY_FILL_PROCESSOR       *Processor;
+  EDKII_PEI_MEMORY_FILL_RANGE     *Range;
+  UINTN                           ProcessorNumber;
+  UINTN                           Index;
+  UINT32                          SliceIndex;
+  UINT32                          SliceCount;
+  UINT64                          SliceSize;
+  UINT64                          Start;
+  UINT64                          Length;
+  VOID                            *Address;
+
+  Context = (CPU_MEMORY_FILL_CONTEXT *) Buffer;
+  MpInitLibWhoAmI (&ProcessorNumber);
+  Processor = &Context->Processors[ProcessorNumber];
+
+  for (Index = 0; Index < Context->RangeCount; Index++) {
+    Range = &Context->Ranges[Index];
+    if (Range->Package == EDKII_PEI_MEMORY_FILL_ANY_PACKAGE) {
+      SliceIndex = Processor->Index;
+      SliceCount = Context->EnabledCount;
+    } else if (Range->Package == Processor->Package) {
+      SliceIndex = Processor->PackageIndex;
+      SliceCount = Processor->PackageCount;
+    } else {
+      continue;
+    }
+
+    SliceSize = DivU64x32 (Range->Length + SliceCount - 1, SliceCount);
+    SliceSize = ALIGN_VALUE (SliceSize, SIZE_4KB);
+    Start     = MultU64x32 (SliceSize, SliceIndex);
+    if (Start >= Range->Length) {
+      continue;
+    }
+    Length  = MIN (SliceSize, Range->Length - Start);
+    Address = (VOID *) (UINTN) (Range->BaseAddress + Start);
+
+    if (Context->Value == 0) {
+      ZeroMem (Address, (UINTN) Length);
+    } else {
+      SetMem (Address, (UINTN) Length, Context->Value);
+    }
+  }
+}
+
+/**
+  Fill memory ranges with a value, with all the enabled processors.
+
+  The ranges must be in permanent memory, accessible by the processors in the
+  current processor mode. This service may only be called from the BSP, when
+  the APs are not busy.
+
+  @param[in] This                 Pointer to this instance of the PPI.
+  @param[in] Ranges               Pointer to the array of ranges to fill.
+  @param[in] RangeCount           The number of ranges in the array.
+  @param[in] Value                The value to fill the ranges with.
+
+  @retval EFI_SUCCESS             The ranges are filled.
+  @retval EFI_INVALID_PARAMETER   Ranges is NULL and RangeCount is not 0.
+  @retval EFI_INVALID_PARAMETER   A range exceeds the end of the physical address space.
+  @retval EFI_UNSUPPORTED         A range is not addressable in the current processor mode.
+  @retval EFI_OUT_OF_RESOURCES    There is not enough memory to split the ranges.
+  @retval EFI_DEVICE_ERROR        The calling processor is an AP.
+  @retval EFI_NOT_READY           Any enabled APs are busy.
+**/
+EFI_STATUS
+EFIAPI
+PeiFillMemory (
+  IN  EDKII_PEI_MEMORY_FILL_PPI           *This,
+  IN  CONST EDKII_PEI_MEMORY_FILL_RANGE   *Ranges,
+  IN  UINTN                               RangeCount,
+  IN  UINT8                               Value
+  )
+{
+  EFI_STATUS                      Status;
+  CPU_MEMORY_FILL_CONTEXT         Context;
+  EFI_PROCESSOR_INFORMATION       ProcessorInfo;
+  UINTN                           NumberOfProcessors;
+  UINTN                           NumberOfEnabledProcessors;
+  UINTN                           ProcessorNumber;
+  UINTN                           Index;
+  UINTN                           ContextPages;
+  UINTN                           ProcessorsSize;
+
+  if ((Ranges == NULL) && (RangeCount != 0)) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  for (Index = 0; Index < RangeCount; Index++) {
+    if ((Ranges[Index].Length != 0) &&
+        (Ranges[Index].Length - 1 > MAX_UINT64 - Ranges[Index].BaseAddress)) {
+      return EFI_INVALID_PARAMETER;
+    }
+    if ((Ranges[Index].Length != 0) &&
+        (Ranges[Index].BaseAddress + Ranges[Index].Length - 1 > MAX_ADDRESS)) {
+      return EFI_UNSUPPORTED;
+    }
+  }
+
+  if (RangeCount == 0) {
+    return EFI_SUCCESS;
+  }
+
+  Status = MpInitLibGetNumberOfProcessors (&NumberOfProcessors, &NumberOfEnabledProcessors);
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  //
+  // Allocate the processor entries and a copy of the ranges, whose packages are
+  // adjusted, in one buffer. The buffer can be too large for a pool allocation
+  // on platforms with many processors.
+  //
+  ProcessorsSize = sizeof (CPU_MEMORY_FILL_PROCESSOR) * NumberOfProcessors;
+  ContextPages   = EFI_SIZE_TO_PAGES (ProcessorsSize + sizeof (EDKII_PEI_MEMORY_FILL_RANGE) * RangeCount);
+  Context.Processors = AllocatePages (ContextPages);
+  if (Context.Processors == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+  Context.Ranges     = (EDKII_PEI_MEMORY_FILL_RANGE *) ((UINT8 *) Context.Processors + ProcessorsSize);
+  Context.RangeCount = RangeCount;
+  Context.Value      = Value;
+  CopyMem (Context.Ranges, Ranges, sizeof (EDKII_PEI_MEMORY_FILL_RANGE) * RangeCount);
+
+  //
+  // Number the enabled processors, globally and in their package.
+  //
+  Context.EnabledCount = 0;
+  for (ProcessorNumber = 0; ProcessorNumber < NumberOfProcessors; ProcessorNumber++) {
+    Status = MpInitLibGetProcessorInfo (ProcessorNumber, &ProcessorInfo, NULL);
+    ASSERT_EFI_ERROR (Status);
+    Context.Processors[ProcessorNumber].Package      = ProcessorInfo.Location.Package;
+    Context.Processors[ProcessorNumber].PackageCount = 0;
+    if ((ProcessorInfo.StatusFlag & PROCESSOR_ENABLED_BIT) == 0) {
+      Context.Processors[ProcessorNumber].Package = EDKII_PEI_MEMORY_FILL_ANY_PACKAGE;
+      continue;
+    }
+
+    Context.Processors[ProcessorNumber].Index        = Context.EnabledCount++;
+    Context.Processors[ProcessorNumber].PackageIndex = 0;
+    for (Index = 0; Index < ProcessorNumber; Index++) {
+      if (Context.Processors[Index].Package == ProcessorInfo.Location.Package) {
+        Context.Processors[ProcessorNumber].PackageIndex++;
+      }
+    }
+  }
+
+  for (ProcessorNumber = 0; ProcessorNumber < NumberOfProcessors; ProcessorNumber++) {
+    for (Index = 0; Index < NumberOfProcessors; Index++) {
+      if ((Context.Processors[ProcessorNumber].Package != EDKII_PEI_MEMORY_FILL_ANY_PACKAGE) &&
+          (Context.Processors[Index].Package == Context.Processors[ProcessorNumber].Package)) {
+        Context.Processors[ProcessorNumber].PackageCount++;
+      }
+    }
+  }
+
+  //
+  // The ranges of a package without enabled processor are filled by all the processors.
+  //
+  for (Index = 0; Index < RangeCount; Index++) {
+    if (Context.Ranges[Index].Package == EDKII_PEI_MEMORY_FILL_ANY_PACKAGE) {
+      continue;
+    }
+    for (ProcessorNumber = 0; ProcessorNumber < NumberOfProcessors; ProcessorNumber++) {
+      if (Context.Processors[ProcessorNumber].Package == Context.Ranges[Index].Package) {
+        break;
+      }
+    }
+    if (ProcessorNumber == NumberOfProcessors) {
+      Context.Ranges[Index].Package = EDKII_PEI_MEMORY_FILL_ANY_PACKAGE;
+    }
+  }
+
+  DEBUG ((
+    DEBUG_INFO,
+    "PeiFillMemory: Fill 0x%x ranges with 0x%02x by 0x%x processors\n",
+    RangeCount,
+    Value,
+    Context.EnabledCount
+    ));
+
+  Status = MpInitLibStartupAllCPUs (FillMemorySlices, 0, &Context);
+
+  FreePages (Context.Processors, ContextPages);
+  return Status;
+}
+
+//
+// CPU Memory Fill PPI to be installed
+//
+EDKII_PEI_MEMORY_FILL_PPI             mMemoryFillPpi = {
+  PeiFillMemory
+};
@@ -16,6 +16,7 @@
 #include <Ppi/SecPlatformInformation2.h>
 #include <Ppi/EndOfPeiPhase.h>
 #include <Ppi/MpServices2.h>
+#include <Ppi/MemoryFill.h>
 
 #include <Library/BaseLib.h>
 #include <Library/DebugLib.h>
@@ -0,0 +1,84 @@
+/** @file
+  This file declares EDKII PEI Memory Fill PPI.
+
+  The PPI fills memory ranges with all the enabled processors. Each range is
+  split between the processors, and a range local to a package can be filled
+  by the processors of the package only.
+
+  Copyright (c) 2026, agent. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef __EDKII_PEI_MEMORY_FILL_PPI_H__
+#define __EDKII_PEI_MEMORY_FILL_PPI_H__
+
+#define EDKII_PEI_MEMORY_FILL_PPI_GUID \
+  { \
+    0x1d4c7ae9, 0x6c2f, 0x4b1e, { 0xa3, 0x5e, 0x84, 0x0b, 0x9f, 0x27, 0xd6, 0x53 } \
+  }
+
+typedef struct _EDKII_PEI_MEMORY_FILL_PPI  EDKII_PEI_MEMORY_FILL_PPI;
+
+///
+/// The range can be filled by the processors of all the packages.
+///
+#define EDKII_PEI_MEMORY_FILL_ANY_PACKAGE  MAX_UINT32
+
+typedef struct {
+  ///
+  /// The base address of the range.
+  ///
+  EFI_PHYSICAL_ADDRESS          BaseAddress;
+  ///
+  /// The length in bytes of the range.
+  ///
+  UINT64                        Length;
+  ///
+  /// The package the range is local to, as Location.Package returned by
+  /// EDKII_PEI_MP_SERVICES2_PPI.GetProcessorInfo(), or EDKII_PEI_MEMORY_FILL_ANY_PACKAGE.
+  /// If no enabled processor is in the package, the range is filled by the
+  /// processors of all the packages.
+  ///
+  UINT32                        Package;
+} EDKII_PEI_MEMORY_FILL_RANGE;
+
+/**
+  Fill memory ranges with a value, with all the enabled processors.
+
+  The ranges must be in permanent memory, accessible by the processors in the
+  current processor mode. This service may only be called from the BSP, when
+  the APs are not busy.
+
+  @param[in] This                 Pointer to this instance of the PPI.
+  @param[in] Ranges               Pointer to the array of ranges to fill.
+  @param[in] RangeCount           The number of ranges in the array.
+  @param[in] Value                The value to fill the ranges with.
+
+  @retval EFI_SUCCESS             The ranges are filled.
+  @retval EFI_INVALID_PARAMETER   Ranges is NULL and RangeCount is not 0.
+  @retval EFI_INVALID_PARAMETER   A range exceeds the end of the physical address space.
+  @retval EFI_UNSUPPORTED         A range is not addressable in the current processor mode.
+  @retval EFI_OUT_OF_RESOURCES    There is not enough memory to split the ranges.
+  @retval EFI_DEVICE_ERROR        The calling processor is an AP.
+  @retval EFI_NOT_READY           Any enabled APs are busy.
+**/
+typedef
+EFI_STATUS
+(EFIAPI *EDKII_PEI_MEMORY_FILL) (
+  IN  EDKII_PEI_MEMORY_FILL_PPI           *This,
+  IN  CONST EDKII_PEI_MEMORY_FILL_RANGE   *Ranges,
+  IN  UINTN                               RangeCount,
+  IN  UINT8                               Value
+  );
+
+//
+// This PPI fills memory ranges with all the enabled processors.
+//
+struct _EDKII_PEI_MEMORY_FILL_PPI {
+  EDKII_PEI_MEMORY_FILL                   FillMemory;
+};
+
+extern EFI_GUID gEdkiiPeiMemoryFillPpiGuid;
+
+#endif